@@ -10,7 +10,7 @@
 //====================================================================
 //public data
 rclc_action_server_t g_actionServerFollowJointTrajectory;
-control_msgs__action__FollowJointTrajectory_SendGoal_Request g_actionServer_FJT_SendGoal_Request;
+control_msgs__action__FollowJointTrajectory_SendGoal_Request* g_actionServer_FJT_SendGoal_Request;
 UINT32 g_actionServer_FJT_SendGoal_Request__sizeof;
 
 //====================================================================
@@ -22,10 +22,13 @@ control_msgs__action__FollowJointTrajectory_FeedbackMessage feedback_FollowJoint
 //====================================================================
 //Static Memory (used for FJT goal storage)
 
-//TODO: shrink this once I have found a good buffer size
+//Holds FJT_NUMBER_OF_GOAL_HANDLES goal requests
 #define SIZEOF_BUFFER_FJT_GOAL (2000000)
 UINT8 Ros_StaticAllocationBuffer_FJTgoal[SIZEOF_BUFFER_FJT_GOAL];
 
+//Keep the structs at the start of each slot properly aligned
+#define FJT_GOAL_SLOT_ALIGNMENT (8)
+
 
 typedef enum
 {
@@ -37,12 +40,41 @@ typedef enum
 INT64 fjt_trajectory_start_time_ns;
 
 rclc_action_goal_handle_t* fjt_active_goal_handle;
-rclc_action_goal_handle_t* fjt_rejected_goal_handle;
+rclc_action_goal_handle_t* fjt_staged_goal_handle;
 control_msgs__action__FollowJointTrajectory_GetResult_Response fjt_result_response;
 rcl_action_goal_state_t fjt_goal_state;
 
 BOOL fjt_result_message_ready;
 
+//goals which end without being executed (rejected, or cancelled while staged)
+rclc_action_goal_handle_t* fjt_rejected_goal_handle;
+control_msgs__action__FollowJointTrajectory_GetResult_Response fjt_rejected_result_response;
+rcl_action_goal_state_t fjt_rejected_goal_state;
+
+BOOL fjt_rejected_result_message_ready;
+
+//====================================================================
+//Per-goal execution statistics. These are reset when a goal is accepted and
+//updated while it executes (by the feedback timer and the increment-move loop).
+//Everything is statically allocated, nothing is allocated during execution.
+typedef struct
+{
+    double maxPositionError[MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM];         // largest absolute position error (rad or m)
+    double sumSquaredPositionError[MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM];  // for calculating the RMS error
+    UINT32 numErrorSamples;             // number of times the position error was sampled
+    UINT32 numIncMoveTicks;             // number of interpolation cycles in which increments were sent
+    UINT32 numIncQueueUnderruns;        // number of cycles in which an increment queue ran dry during the trajectory
+    UINT32 numFsuLimitedTicks;          // number of cycles in which the controller did not process all pulses
+    LONG peakBacklogPulses;             // largest number of pulses still waiting to be processed (any axis)
+    BOOL bScheduledStart;               // execution was held until the time in 'trajectory.header.stamp'
+    INT64 startError_ns;                // actual - requested start time (only if bScheduledStart)
+} FJT_ExecutionStats;
+
+FJT_ExecutionStats fjt_execution_stats;
+
+#define SIZEOF_FJT_RESULT_STRING_BUFFER (2048)
+char fjt_result_string_buffer[SIZEOF_FJT_RESULT_STRING_BUFFER];
+
 #define RESULT_REPONSE_ERROR_CODE(rosCode, motomanCode) ((rosCode * 100000) - motomanCode)
 
 //====================================================================
@@ -59,8 +91,10 @@ void Ros_ActionServer_FJT_Initialize()
     Ros_Debug_BroadcastMsg("Initializing ActionServer FollowJointTrajectory");
 
     fjt_active_goal_handle = NULL;
+    fjt_staged_goal_handle = NULL;
     fjt_rejected_goal_handle = NULL;
     fjt_result_message_ready = FALSE;
+    fjt_rejected_result_message_ready = FALSE;
 
     //===============================================
     //allocation config for feedback messages
@@ -78,7 +112,15 @@ void Ros_ActionServer_FJT_Initialize()
     //===============================================
     //configure how much memory to allocate for the FJT request message
     static micro_ros_utilities_memory_conf_t goal_svc_req_msg_alloc_cfg = { 0 };
+    //Sized for the maximum number of axes (not only the configured ones), so goals with
+    //too many joints are still deserialized and can be rejected with a proper error.
     int maxAxes = MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM;
+    int maxRobots = 0;
+    for (int i = 0; i < g_Ros_Controller.numGroup; i += 1)
+    {
+        if (Ros_CtrlGroup_IsRobot(g_Ros_Controller.ctrlGroups[i]))
+            maxRobots += 1;
+    }
     goal_svc_req_msg_alloc_cfg.max_string_capacity = MAX_JOINT_NAME_LENGTH;
     goal_svc_req_msg_alloc_cfg.max_ros2_type_sequence_capacity = maxAxes;
     goal_svc_req_msg_alloc_cfg.max_basic_type_sequence_capacity = maxAxes;
@@ -92,13 +134,14 @@ void Ros_ActionServer_FJT_Initialize()
         {"goal.trajectory.points.accelerations", maxAxes}, //number of accelerations in a point (max axes)
         {"goal.trajectory.points.effort", maxAxes}, //number of effort in a point (max axes)
 
-        //NOTE: Setting these to zero to 'disable' multi-dof trajectory
-        {"goal.multi_dof_trajectory.joint_names", 0}, //each point will have cartesian position for each group
-        {"goal.multi_dof_trajectory.joint_names.data", 0}, //string length for group name
-        {"goal.multi_dof_trajectory.points", 0}, //number of points in trajectory
-        {"goal.multi_dof_trajectory.points.transforms", 0}, //each point will have cartesian position for each group
-        {"goal.multi_dof_trajectory.points.velocities", 0}, //each point will have cartesian position for each group
-        {"goal.multi_dof_trajectory.points.accelerations", 0}, //each point will have cartesian position for each group
+        //multi-dof trajectory is used for cartesian (TCP) trajectories: one 'joint' per robot
+        {"goal.multi_dof_trajectory.header.frame_id", MAX_TF_FRAME_NAME_LENGTH}, //string length for frame name
+        {"goal.multi_dof_trajectory.joint_names", maxRobots}, //each point will have cartesian position for each robot
+        {"goal.multi_dof_trajectory.joint_names.data", MAX_TF_FRAME_NAME_LENGTH}, //string length for TCP frame name
+        {"goal.multi_dof_trajectory.points", MAX_NUMBER_OF_POINTS_PER_TRAJECTORY}, //number of points in trajectory
+        {"goal.multi_dof_trajectory.points.transforms", maxRobots}, //each point will have cartesian position for each robot
+        {"goal.multi_dof_trajectory.points.velocities", maxRobots}, //each point will have cartesian velocity for each robot
+        {"goal.multi_dof_trajectory.points.accelerations", maxRobots}, //each point will have cartesian acceleration for each robot
 
         {"goal.path_tolerance", MAX_NUMBER_OF_POINTS_PER_TRAJECTORY}, //number of points in trajectory
         {"goal.goal_tolerance", maxAxes}, //number of joints
@@ -113,17 +156,33 @@ void Ros_ActionServer_FJT_Initialize()
     Ros_Debug_BroadcastMsg("Allocating FollowJointTrajectory goal request");
     Ros_Debug_BroadcastMsg("Maximum length of trajectories: %d points", MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
 
-    g_actionServer_FJT_SendGoal_Request__sizeof = sizeof(g_actionServer_FJT_SendGoal_Request) +
-        micro_ros_utilities_get_static_size(ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_SendGoal_Request), goal_svc_req_msg_alloc_cfg);
-    Ros_Debug_BroadcastMsg("g_actionServer_FJT_SendGoal_Request__sizeof = %d", g_actionServer_FJT_SendGoal_Request__sizeof);
+    //rclc stores the request for goal handle 'i' at (g_actionServer_FJT_SendGoal_Request + i * __sizeof),
+    //so each slot holds the request struct followed by the memory for its sequences and strings
+    size_t sizeofStaticMemory = micro_ros_utilities_get_static_size(ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_SendGoal_Request), goal_svc_req_msg_alloc_cfg);
+    size_t sizeofRequestStruct = sizeof(control_msgs__action__FollowJointTrajectory_SendGoal_Request);
+    g_actionServer_FJT_SendGoal_Request__sizeof = sizeofRequestStruct + sizeofStaticMemory;
+    g_actionServer_FJT_SendGoal_Request__sizeof += (FJT_GOAL_SLOT_ALIGNMENT - (g_actionServer_FJT_SendGoal_Request__sizeof % FJT_GOAL_SLOT_ALIGNMENT)) % FJT_GOAL_SLOT_ALIGNMENT;
+    Ros_Debug_BroadcastMsg("g_actionServer_FJT_SendGoal_Request__sizeof = %d (%d axes, %d goal handles)",
+        g_actionServer_FJT_SendGoal_Request__sizeof, maxAxes, FJT_NUMBER_OF_GOAL_HANDLES);
+
+    motoRosAssert_withMsg((g_actionServer_FJT_SendGoal_Request__sizeof * FJT_NUMBER_OF_GOAL_HANDLES) <= sizeof(Ros_StaticAllocationBuffer_FJTgoal),
+        SUBCODE_FAIL_ALLOCATE_FJT_GOAL, "FJT goal needs %d bytes", g_actionServer_FJT_SendGoal_Request__sizeof * FJT_NUMBER_OF_GOAL_HANDLES);
 
     bzero(Ros_StaticAllocationBuffer_FJTgoal, sizeof(Ros_StaticAllocationBuffer_FJTgoal));
-    micro_ros_utilities_create_static_message_memory(
-        ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_SendGoal_Request),
-        &g_actionServer_FJT_SendGoal_Request,
-        goal_svc_req_msg_alloc_cfg,
-        Ros_StaticAllocationBuffer_FJTgoal,
-        sizeof(Ros_StaticAllocationBuffer_FJTgoal));
+    g_actionServer_FJT_SendGoal_Request = (control_msgs__action__FollowJointTrajectory_SendGoal_Request*)Ros_StaticAllocationBuffer_FJTgoal;
+
+    for (int i = 0; i < FJT_NUMBER_OF_GOAL_HANDLES; i += 1)
+    {
+        UINT8* slot = Ros_StaticAllocationBuffer_FJTgoal + (i * g_actionServer_FJT_SendGoal_Request__sizeof);
+
+        bool bOk = micro_ros_utilities_create_static_message_memory(
+            ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_SendGoal_Request),
+            (control_msgs__action__FollowJointTrajectory_SendGoal_Request*)slot,
+            goal_svc_req_msg_alloc_cfg,
+            slot + sizeofRequestStruct,
+            g_actionServer_FJT_SendGoal_Request__sizeof - sizeofRequestStruct);
+        motoRosAssert_withMsg(bOk, SUBCODE_FAIL_ALLOCATE_FJT_GOAL, "Failed creating FJT goal %d", i);
+    }
 
     MOTOROS2_MEM_TRACE_REPORT(fjt_init);
 }
@@ -137,12 +196,19 @@ void Ros_ActionServer_FJT_Cleanup()
 
     //Memory for actionServer_FJT_SendGoal_Request was not allocated off the heap. It was taken from a static buffer.
     //Clear the buffer and any pointers into it.
-    bzero(&g_actionServer_FJT_SendGoal_Request, sizeof(g_actionServer_FJT_SendGoal_Request));
+    g_actionServer_FJT_SendGoal_Request = NULL;
     bzero(Ros_StaticAllocationBuffer_FJTgoal, sizeof(Ros_StaticAllocationBuffer_FJTgoal));
 
     if (fjt_result_response.result.error_string.data != NULL)
         micro_ros_string_utilities_destroy(&fjt_result_response.result.error_string);
 
+    if (fjt_rejected_result_response.result.error_string.data != NULL)
+        micro_ros_string_utilities_destroy(&fjt_rejected_result_response.result.error_string);
+
+    //A staged goal can't be started anymore: its goal handle is gone with the server
+    fjt_staged_goal_handle = NULL;
+    Ros_MotionControl_DiscardStagedTrajectory();
+
     Ros_ActionServer_FJT_DeleteFeedbackMessage();
 
     MOTOROS2_MEM_TRACE_REPORT(fjt_fini);
@@ -163,22 +229,132 @@ void Ros_ActionServer_FJT_DeleteFeedbackMessage()
     }
 }
 
+static char const* Ros_ActionServer_FJT_InitTrajStatus_ToString(Init_Trajectory_Status trajStatus)
+{
+    switch (trajStatus)
+    {
+    case INIT_TRAJ_TOO_SMALL:
+        return "Trajectory must contain at least two points.";
+    case INIT_TRAJ_INVALID_STARTING_POS:
+        return "The first point must match the robot's current position.";
+    case INIT_TRAJ_INVALID_VELOCITY:
+        return "The commanded velocity is too high.";
+    case INIT_TRAJ_ALREADY_IN_MOTION:
+        return "Already running a trajectory.";
+    case INIT_TRAJ_INVALID_JOINTNAME:
+        return "Invalid joint name specified. Check motoros2_config.yaml.";
+    case INIT_TRAJ_INCOMPLETE_JOINTLIST:
+        return "Trajectory must contain data for all joints.";
+    case INIT_TRAJ_INVALID_TIME:
+        return "Invalid time in trajectory.";
+    case INIT_TRAJ_BACKWARD_TIME:
+        return "Trajectory message contains waypoints that are not strictly increasing in time.";
+    case INIT_TRAJ_WRONG_NUMBER_OF_POSITIONS:
+        return "Trajectory did not contain position data for all axes.";
+    case INIT_TRAJ_WRONG_NUMBER_OF_VELOCITIES:
+        return "Trajectory did not contain velocity data for all axes.";
+    case INIT_TRAJ_INVALID_ENDING_VELOCITY:
+        return "The final point in the trajectory must have zero velocity.";
+    case INIT_TRAJ_INVALID_ENDING_ACCELERATION:
+        return "The final point in the trajectory must have zero acceleration.";
+    case INIT_TRAJ_DUPLICATE_JOINT_NAME:
+        return "The trajectory contains duplicate joint names.";
+    case INIT_TRAJ_PRECEDING_GOAL_FAILED:
+        return "The preceding goal did not complete successfully. Queued trajectory was not executed.";
+    case INIT_TRAJ_INVALID_CARTESIAN_FRAME:
+        return "Invalid cartesian trajectory frame. Use the TCP frame of the selected tool, relative to the robot base frame.";
+    case INIT_TRAJ_WRONG_NUMBER_OF_TRANSFORMS:
+        return "Cartesian trajectory did not contain a transform for each TCP.";
+    case INIT_TRAJ_INVALID_ORIENTATION:
+        return "Cartesian trajectory contains an invalid orientation (quaternion).";
+    case INIT_TRAJ_UNSUPPORTED_TOLERANCE:
+        return "Cartesian trajectories do not support goal_tolerance or path_tolerance.";
+    case INIT_TRAJ_START_TIME_TOO_FAR:
+        return "The requested start time is too far in the future. Check scheduled_start_horizon in motoros2_config.yaml.";
+    case INIT_TRAJ_START_TIME_NOT_SYNCED:
+        return "A start time can only be requested if sync_timeclock_with_agent is enabled in motoros2_config.yaml.";
+    default:
+        return "Trajectory initialization failed. Generic failure.";
+    }
+}
+
+//Goals which are not executed still get a result, so the user knows why.
+//This result is kept separate from the one for the active goal, as a goal
+//can be rejected while another one is executing.
+static void Ros_ActionServer_FJT_RejectGoal(rclc_action_goal_handle_t* goal_handle, rcl_action_goal_state_t goal_state,
+    int rosErrorCode, int motomanErrorCode, char const* error_string)
+{
+    if (fjt_rejected_goal_handle) //result string already pending
+        micro_ros_string_utilities_destroy(&fjt_rejected_result_response.result.error_string);
+
+    fjt_rejected_goal_handle = goal_handle;
+
+    rosidl_runtime_c__String__assign(&fjt_rejected_result_response.result.error_string, error_string);
+    fjt_rejected_result_response.result.error_code = RESULT_REPONSE_ERROR_CODE(rosErrorCode, motomanErrorCode);
+    fjt_rejected_result_response.status = goal_state;
+    fjt_rejected_goal_state = goal_state;
+
+    fjt_rejected_result_message_ready = TRUE;
+
+    Ros_Debug_BroadcastMsg("%s", fjt_rejected_result_response.result.error_string.data);
+}
+
+//Start tracking a goal for which the trajectory has been handed over to MotionControl
+static void Ros_ActionServer_FJT_ActivateGoal(rclc_action_goal_handle_t* goal_handle)
+{
+    // ---- Build feedback message
+    micro_ros_utilities_create_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_FeedbackMessage),
+        &feedback_FollowJointTrajectory,
+        feedback_msg_alloc_cfg);
+
+    fjt_active_goal_handle = goal_handle;
+
+    Ros_Debug_BroadcastMsg("feedback_msg_alloc_cfg size = %d bytes", sizeof(feedback_FollowJointTrajectory) + micro_ros_utilities_get_dynamic_size(ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_FeedbackMessage), feedback_msg_alloc_cfg));
+
+    //populate joint names into the feedback message (copy from the /joint_states message)
+    int numJoints = g_messages_PositionMonitor.jointStateAllGroups->name.size;
+    feedback_FollowJointTrajectory.feedback.joint_names.size = numJoints;
+    for (int i = 0; i < numJoints; i += 1)
+    {
+        rosidl_runtime_c__String__assign(&feedback_FollowJointTrajectory.feedback.joint_names.data[i],
+                                         g_messages_PositionMonitor.jointStateAllGroups->name.data[i].data);
+    }
+
+    Ros_ActionServer_FJT_ResetProgressTracker();
+
+    fjt_trajectory_start_time_ns = Ros_ClockSync_Now();
+
+    Ros_Telemetry_Record(TELEMETRY_EVENT_FJT_GOAL_ACTIVATED, 0, Ros_Telemetry_GoalId(goal_handle->goal_id.uuid), 0, 0, 0);
+}
+
 rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_handle, void* context)
 {
     (void)context;
 
+    Ros_Communication_NotifyAgentActivity();
+
     //-----------RECEIVE REQUEST
     control_msgs__action__FollowJointTrajectory_SendGoal_Request* pending_ros_goal_request =
         (control_msgs__action__FollowJointTrajectory_SendGoal_Request*)goal_handle->ros_goal_request;
 
-    Ros_Debug_BroadcastMsg("Trajectory contains %d points", pending_ros_goal_request->goal.trajectory.points.size);
+    BOOL bCartesian = Ros_MotionControl_IsCartesianGoal(pending_ros_goal_request);
+    int numPoints = bCartesian ? pending_ros_goal_request->goal.multi_dof_trajectory.points.size : pending_ros_goal_request->goal.trajectory.points.size;
+
+    Ros_Debug_BroadcastMsg("%s trajectory contains %d points", bCartesian ? "Cartesian" : "Joint", numPoints);
 
+    //A goal received while another one is still active is converted and validated now,
+    //and is started as soon as the active goal has completed successfully.
+    bool bStageGoal = (fjt_active_goal_handle != NULL);
+
+    Ros_Telemetry_Record(TELEMETRY_EVENT_FJT_GOAL_RECEIVED, 0, Ros_Telemetry_GoalId(goal_handle->goal_id.uuid),
+        numPoints, bCartesian, bStageGoal);
 
     bool bMotionModeOk = Ros_MotionControl_IsMotionMode_Trajectory();
-    bool bSizeOk = (pending_ros_goal_request->goal.trajectory.points.size <= MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+    bool bSizeOk = (numPoints <= MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
     bool bMotionReady = Ros_Controller_IsMotionReady();
 
-    if (bMotionModeOk && bSizeOk && !bMotionReady && Ros_Controller_IsEcoMode()) //energy saving function
+    if (bMotionModeOk && bSizeOk && !bMotionReady && !bStageGoal && Ros_Controller_IsEcoMode()) //energy saving function
     {
         Ros_Debug_BroadcastMsg("Energy saving function is active. Re-enabling the robot.");
 
@@ -188,7 +364,7 @@ rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_han
 
         Ros_ServiceStartTrajMode_Trigger(NULL, responseMsg);
 
-        Ros_Debug_BroadcastMsg(responseMsg->message.data);
+        Ros_Debug_BroadcastMsg("%s", responseMsg->message.data);
 
         if (responseMsg->result_code.value == MOTION_READY)
             bMotionReady = Ros_Controller_IsMotionReady();
@@ -202,35 +378,23 @@ rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_han
     bool bInitOk = FALSE;
     if (bSizeOk && bMotionReady && bMotionModeOk)
     {
-        trajStatus = Ros_MotionControl_InitTrajectory(pending_ros_goal_request);
+        if (bStageGoal)
+            trajStatus = (fjt_staged_goal_handle == NULL) ? Ros_MotionControl_StageTrajectory(pending_ros_goal_request) : INIT_TRAJ_ALREADY_IN_MOTION;
+        else
+            trajStatus = Ros_MotionControl_InitTrajectory(pending_ros_goal_request);
         bInitOk = (trajStatus == INIT_TRAJ_OK);
     }
 
     //-----------RESPOND TO REQUEST
     if (bSizeOk && bMotionReady && bMotionModeOk && bInitOk)
     {
-        // ---- Build feedback message
-        micro_ros_utilities_create_message_memory(
-            ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_FeedbackMessage),
-            &feedback_FollowJointTrajectory,
-            feedback_msg_alloc_cfg);
-
-        fjt_active_goal_handle = goal_handle;
-
-        Ros_Debug_BroadcastMsg("feedback_msg_alloc_cfg size = %d bytes", sizeof(feedback_FollowJointTrajectory) + micro_ros_utilities_get_dynamic_size(ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_FeedbackMessage), feedback_msg_alloc_cfg));
-
-        //populate joint names into the feedback message (copy from the /joint_states message)
-        int numJoints = g_messages_PositionMonitor.jointStateAllGroups->name.size;
-        feedback_FollowJointTrajectory.feedback.joint_names.size = numJoints;
-        for (int i = 0; i < numJoints; i += 1)
+        if (bStageGoal)
         {
-            rosidl_runtime_c__String__assign(&feedback_FollowJointTrajectory.feedback.joint_names.data[i],
-                                             g_messages_PositionMonitor.jointStateAllGroups->name.data[i].data);
+            fjt_staged_goal_handle = goal_handle;
+            Ros_Debug_BroadcastMsg("FollowJointTrajectory - Goal staged, will start when the active goal completes");
         }
-
-        Ros_ActionServer_FJT_ResetProgressTracker();
-
-        fjt_trajectory_start_time_ns = rmw_uros_epoch_nanos();
+        else
+            Ros_ActionServer_FJT_ActivateGoal(goal_handle);
     }
     else
     {
@@ -238,101 +402,34 @@ rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_han
         //we must first accept the goal and then abort it w/o executing it.
         //https://github.com/ros2/rclc/issues/271
 
-        if (fjt_rejected_goal_handle) //result string already pending
-            micro_ros_string_utilities_destroy(&fjt_result_response.result.error_string);
-
-        fjt_rejected_goal_handle = goal_handle;
-
         int motomanErrorCode = 0;
+        char const* error_string = "";
         if (!bSizeOk)
         {
             motomanErrorCode = INIT_TRAJ_TOO_BIG;
-            rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                "Trajectory contains too many points (Not enough memory).");
+            error_string = "Trajectory contains too many points (Not enough memory).";
         }
         else if (!bMotionReady)
         {
             motomanErrorCode = Ros_Controller_GetNotReadySubcode();
-            rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                Ros_ErrorHandling_MotionNotReadyCode_ToString((MotionNotReadyCode)motomanErrorCode));
+            error_string = Ros_ErrorHandling_MotionNotReadyCode_ToString((MotionNotReadyCode)motomanErrorCode);
         }
         else if (!bMotionModeOk)
         {
             motomanErrorCode = INIT_TRAJ_WRONG_MODE;
-            rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, 
-                "Must call " SERVICE_NAME_START_TRAJ_MODE " service.");
+            error_string = "Must call " SERVICE_NAME_START_TRAJ_MODE " service.";
         }
         else if (!bInitOk)
         {
             motomanErrorCode = trajStatus;
-            switch (motomanErrorCode)
-            {
-            case INIT_TRAJ_TOO_SMALL:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Trajectory must contain at least two points.");
-                break;
-            case INIT_TRAJ_INVALID_STARTING_POS:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "The first point must match the robot's current position.");
-                break;
-            case INIT_TRAJ_INVALID_VELOCITY:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "The commanded velocity is too high.");
-                break;
-            case INIT_TRAJ_ALREADY_IN_MOTION:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Already running a trajectory.");
-                break;
-            case INIT_TRAJ_INVALID_JOINTNAME:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Invalid joint name specified. Check motoros2_config.yaml.");
-                break;
-            case INIT_TRAJ_INCOMPLETE_JOINTLIST:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Trajectory must contain data for all joints.");
-                break;
-            case INIT_TRAJ_INVALID_TIME:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Invalid time in trajectory.");
-                break;
-            case INIT_TRAJ_BACKWARD_TIME:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Trajectory message contains waypoints that are not strictly increasing in time.");
-                break;
-            case INIT_TRAJ_WRONG_NUMBER_OF_POSITIONS:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Trajectory did not contain position data for all axes.");
-                break;
-            case INIT_TRAJ_WRONG_NUMBER_OF_VELOCITIES:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Trajectory did not contain velocity data for all axes.");
-                break;
-            case INIT_TRAJ_INVALID_ENDING_VELOCITY:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "The final point in the trajectory must have zero velocity.");
-                break;
-            case INIT_TRAJ_INVALID_ENDING_ACCELERATION:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "The final point in the trajectory must have zero acceleration.");
-                break;
-            case INIT_TRAJ_DUPLICATE_JOINT_NAME:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "The trajectory contains duplicate joint names.");
-                break;
-            default:
-                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
-                    "Trajectory initialization failed. Generic failure.");
-            }
+            error_string = Ros_ActionServer_FJT_InitTrajStatus_ToString(trajStatus);
         }
 
-        fjt_result_response.result.error_code = RESULT_REPONSE_ERROR_CODE(control_msgs__action__FollowJointTrajectory_Result__INVALID_GOAL, motomanErrorCode);
-        fjt_result_response.status = GOAL_STATE_ABORTED;
-
-        fjt_result_message_ready = TRUE;
-
         Ros_Debug_BroadcastMsg("FollowJointTrajectory - Goal request rejected");
         Ros_Debug_BroadcastMsg("The trajectory will be accepted and then immediately aborted");
-        Ros_Debug_BroadcastMsg(fjt_result_response.result.error_string.data);
+
+        Ros_ActionServer_FJT_RejectGoal(goal_handle, GOAL_STATE_ABORTED,
+            control_msgs__action__FollowJointTrajectory_Result__INVALID_GOAL, motomanErrorCode, error_string);
     }
 
     return RCL_RET_ACTION_GOAL_ACCEPTED;
@@ -342,6 +439,7 @@ void Ros_ActionServer_FJT_ResetProgressTracker()
 {
     control_msgs__action__FollowJointTrajectory_Feedback* feedback = &feedback_FollowJointTrajectory.feedback;
 
+    bzero(&fjt_execution_stats, sizeof(fjt_execution_stats));
 
     //===========================================
     //Reset the progress tracker to the current position.
@@ -402,22 +500,52 @@ void Ros_ActionServer_FJT_ResetProgressTracker()
     //TODO: do multidof too
 }
 
-//Called from TrajectoryMotionControl::Ros_MotionControl_IncMoveLoopStart
-void Ros_ActionServer_FJT_UpdateProgressTracker(MP_EXPOS_DATA* incrementData)
+//Set the desired positions and velocities of the feedback message to the command position
+//tracked by the IncMoveTask, so the tracking error is relative to what was actually commanded
+static void Ros_ActionServer_FJT_UpdateDesired()
 {
-    if (fjt_active_goal_handle == NULL)
+    MotionControl_CommandState commandState;
+
+    //keep the previous values until the IncMoveTask recorded a command position
+    if (!Ros_MotionControl_GetCommandState(&commandState))
         return;
 
     int iteratorAllAxes = 0;
     for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
     {
-        double radRosOrder[MP_GRP_AXES_NUM];
+        double radPos_ros[MAX_PULSE_AXES];
+        double radSpeed_ros[MAX_PULSE_AXES];
         CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupIndex];
-        Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, incrementData->grp_pos_info[groupIndex].pos, radRosOrder);
 
-        for (int i = 0; i < ctrlGroup->numAxes; i += 1, iteratorAllAxes += 1)
-            feedback_FollowJointTrajectory.feedback.desired.positions.data[iteratorAllAxes] = feedback_FollowJointTrajectory.feedback.actual.positions.data[iteratorAllAxes] + radRosOrder[i];
+        Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, commandState.pulsePos[groupIndex], radPos_ros);
+        Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, commandState.pulseSpeed[groupIndex], radSpeed_ros);
+
+        memcpy(&feedback_FollowJointTrajectory.feedback.desired.positions.data[iteratorAllAxes], radPos_ros, sizeof(double) * ctrlGroup->numAxes);
+        memcpy(&feedback_FollowJointTrajectory.feedback.desired.velocities.data[iteratorAllAxes], radSpeed_ros, sizeof(double) * ctrlGroup->numAxes);
+
+        iteratorAllAxes += ctrlGroup->numAxes;
     }
+
+    feedback_FollowJointTrajectory.feedback.desired.positions.size =
+        feedback_FollowJointTrajectory.feedback.desired.velocities.size = iteratorAllAxes;
+}
+
+//Called from TrajectoryMotionControl::Ros_MotionControl_IncMoveLoopStart
+void Ros_ActionServer_FJT_UpdateExecutionStats(BOOL bQueueUnderrun, BOOL bFsuLimited, LONG peakBacklogPulses)
+{
+    if (fjt_active_goal_handle == NULL || fjt_result_message_ready)
+        return;
+
+    fjt_execution_stats.numIncMoveTicks += 1;
+
+    if (bQueueUnderrun)
+        fjt_execution_stats.numIncQueueUnderruns += 1;
+
+    if (bFsuLimited)
+        fjt_execution_stats.numFsuLimitedTicks += 1;
+
+    if (peakBacklogPulses > fjt_execution_stats.peakBacklogPulses)
+        fjt_execution_stats.peakBacklogPulses = peakBacklogPulses;
 }
 
 //Called from Communication Executor
@@ -432,7 +560,7 @@ void Ros_ActionServer_FJT_ProcessFeedback()
         feedback_FollowJointTrajectory.goal_id = fjt_active_goal_handle->goal_id;
 
         //Use timestamp from when this positional data was captured
-        feedback_FollowJointTrajectory.feedback.header.stamp = g_messages_PositionMonitor.transform->transforms.data[0].header.stamp;
+        feedback_FollowJointTrajectory.feedback.header.stamp = g_messages_PositionMonitor.jointStateAllGroups->header.stamp;
 
         //The PositionMonitor functions are already polling the information we need and
         //storing it in g_messages_PositionMonitor.
@@ -448,14 +576,25 @@ void Ros_ActionServer_FJT_ProcessFeedback()
             g_messages_PositionMonitor.jointStateAllGroups->effort.data,
             sizeof(double) * g_messages_PositionMonitor.jointStateAllGroups->effort.size);
 
-        for (int i = 0; i < (MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM); i += 1)
+        Ros_ActionServer_FJT_UpdateDesired();
+
+        for (int i = 0; i < feedback_FollowJointTrajectory.feedback.joint_names.size; i += 1)
         {
-            //.desired was set in ActionServer_FJT_UpdateProgressTracker (called from increment-move loop)
             feedback_FollowJointTrajectory.feedback.error.positions.data[i] =
                 feedback_FollowJointTrajectory.feedback.desired.positions.data[i] -
                 feedback_FollowJointTrajectory.feedback.actual.positions.data[i];
         }
 
+        //accumulate the tracking error for the execution report
+        for (int i = 0; i < feedback_FollowJointTrajectory.feedback.joint_names.size; i += 1)
+        {
+            double error = fabs(feedback_FollowJointTrajectory.feedback.error.positions.data[i]);
+            if (error > fjt_execution_stats.maxPositionError[i])
+                fjt_execution_stats.maxPositionError[i] = error;
+            fjt_execution_stats.sumSquaredPositionError[i] += error * error;
+        }
+        fjt_execution_stats.numErrorSamples += 1;
+
         //-----------------------------------------------------------------------------
         rclc_action_publish_feedback(fjt_active_goal_handle, &feedback_FollowJointTrajectory);
 
@@ -477,7 +616,7 @@ void Ros_ActionServer_FJT_ProcessFeedback()
         }
         else if ((!Ros_MotionControl_HasDataToProcess()) && Ros_Controller_IsInMotion())
         {
-            Ros_Debug_BroadcastMsg("Robot still in motion");
+            Ros_Debug_BroadcastDebugMsg("Robot still in motion");
         }
     }
 }
@@ -618,14 +757,95 @@ static STATUS Ros_ActionServer_FJT_Reorder_TrajPt_To_Internal_Order(
     return OK;
 }
 
+/**
+ * Returns the time_from_start of the last point of either the joint or the
+ * cartesian trajectory in the goal.
+ */
+static builtin_interfaces__msg__Duration const* Ros_ActionServer_FJT_GetFinalTimeFromStart(
+    control_msgs__action__FollowJointTrajectory_SendGoal_Request const* const ros_goal_request)
+{
+    if (Ros_MotionControl_IsCartesianGoal(ros_goal_request))
+    {
+        trajectory_msgs__msg__MultiDOFJointTrajectoryPoint__Sequence const* points = &ros_goal_request->goal.multi_dof_trajectory.points;
+        return &points->data[points->size - 1].time_from_start;
+    }
+
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points = &ros_goal_request->goal.trajectory.points;
+    return &points->data[points->size - 1].time_from_start;
+}
+
+/**
+ * Appends a summary of the statistics gathered while executing the active goal
+ * to 'report'. Needs the joint names in the feedback message, so must be called
+ * before the feedback message is deleted.
+ */
+static void Ros_ActionServer_FJT_FormatExecutionReport(INT64 plannedTime_ns, INT64 actualTime_ns,
+    char* report /* out */, size_t report_len /* in */)
+{
+    int len = snprintf(report, report_len,
+        " [Execution report: planned %.3f s, actual %.3f s; inc-q underruns: %u; FSU-limited ticks: %u (of %u); peak backlog: %ld pulses;",
+        (double)plannedTime_ns * 1.0e-9, (double)actualTime_ns * 1.0e-9,
+        fjt_execution_stats.numIncQueueUnderruns,
+        fjt_execution_stats.numFsuLimitedTicks, fjt_execution_stats.numIncMoveTicks,
+        fjt_execution_stats.peakBacklogPulses);
+
+    Ros_Debug_BroadcastMsg("FJT execution: planned %.3f s, actual %.3f s, underruns: %u, FSU-limited: %u/%u ticks, peak backlog: %ld pulses",
+        (double)plannedTime_ns * 1.0e-9, (double)actualTime_ns * 1.0e-9,
+        fjt_execution_stats.numIncQueueUnderruns,
+        fjt_execution_stats.numFsuLimitedTicks, fjt_execution_stats.numIncMoveTicks,
+        fjt_execution_stats.peakBacklogPulses);
+
+    if (fjt_execution_stats.bScheduledStart)
+    {
+        Ros_Debug_BroadcastMsg("FJT execution: scheduled start, start error: %lld ns", fjt_execution_stats.startError_ns);
+
+        if (len >= 0 && (size_t)len < report_len)
+        {
+            len += snprintf(report + len, report_len - (size_t)len, " start error: %.3f ms;",
+                (double)fjt_execution_stats.startError_ns * 1.0e-6);
+        }
+    }
+
+    if (len >= 0 && (size_t)len < report_len)
+        len += snprintf(report + len, report_len - (size_t)len, " max/rms error per joint:");
+
+    for (int i = 0; i < feedback_FollowJointTrajectory.feedback.joint_names.size; i += 1)
+    {
+        double rmsError = 0.0;
+        if (fjt_execution_stats.numErrorSamples > 0)
+            rmsError = sqrt(fjt_execution_stats.sumSquaredPositionError[i] / fjt_execution_stats.numErrorSamples);
+
+        Ros_Debug_BroadcastMsg("FJT execution: '%s': max error: %.6f, rms error: %.6f",
+            feedback_FollowJointTrajectory.feedback.joint_names.data[i].data,
+            fjt_execution_stats.maxPositionError[i], rmsError);
+
+        if (len >= 0 && (size_t)len < report_len)
+        {
+            len += snprintf(report + len, report_len - (size_t)len, " %s: %.6f/%.6f",
+                feedback_FollowJointTrajectory.feedback.joint_names.data[i].data,
+                fjt_execution_stats.maxPositionError[i], rmsError);
+        }
+    }
+
+    if (len >= 0 && (size_t)len < report_len)
+        snprintf(report + len, report_len - (size_t)len, "]");
+}
+
 void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
 {
+    INT64 trajectory_end_time_ns = Ros_ClockSync_Now();
+
+    //if execution was held until a requested start time, measure from when motion actually started
+    INT64 actualStartTime_ns;
+    fjt_execution_stats.bScheduledStart = Ros_MotionControl_GetScheduledStartResult(&actualStartTime_ns, &fjt_execution_stats.startError_ns);
+    if (fjt_execution_stats.bScheduledStart)
+        fjt_trajectory_start_time_ns = actualStartTime_ns;
+
     //**********************************************************************
     if (goal_end_type == GOAL_COMPLETE)
     {
         double diff;
         INT64 timeTolerance;
-        INT64 trajectory_end_time_ns = rmw_uros_epoch_nanos();
 
         //-----------------------------------------------------------------------
         //check to see if each axis is in the desired location
@@ -633,6 +853,8 @@ void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
 #define MR2_JTA_MAX_NUM_AXES (MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM)
         int numAxesToCheck = feedback_FollowJointTrajectory.feedback.joint_names.size;
 
+        control_msgs__action__FollowJointTrajectory_SendGoal_Request* ros_goal_request = (control_msgs__action__FollowJointTrajectory_SendGoal_Request*)fjt_active_goal_handle->ros_goal_request;
+
         //NOTE: we allocate for the maximum nr of axes, but only check the nr of configured
         //axes later (which is in almost all cases significantly smaller)
         double violators[MR2_JTA_MAX_NUM_AXES];
@@ -643,11 +865,19 @@ void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
         //'parse' the JointTolerance elements from the goal. Map their 'name:tolerance'
         //to the 'joint_index:tolerance' we need
         STATUS statusParseGoalTolerance = Ros_ActionServer_FJT_Parse_GoalPosTolerances(
-            &g_actionServer_FJT_SendGoal_Request.goal.goal_tolerance,
+            &ros_goal_request->goal.goal_tolerance,
             &feedback_FollowJointTrajectory.feedback.joint_names,
             posTolerance, numAxesToCheck);
 
         BOOL bToleranceParseOk = TRUE;
+
+        //joint tolerances don't apply to cartesian trajectories
+        if (Ros_MotionControl_IsCartesianGoal(ros_goal_request))
+        {
+            Ros_Debug_BroadcastMsg("%s: cartesian trajectory, skipping goal tolerance check", __func__);
+            goto goal_complete_skip_tolerance_comparison;
+        }
+
         if (statusParseGoalTolerance != OK)
         {
             Ros_Debug_BroadcastMsg("%s: parsing 'goal_tolerance' field failed: %d", __func__, statusParseGoalTolerance);
@@ -662,11 +892,11 @@ void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
         //feedback_FollowJointTrajectory.feedback)
         double lastTrajPtPositions[MR2_JTA_MAX_NUM_AXES];
         bzero(lastTrajPtPositions, sizeof(lastTrajPtPositions));
-        size_t finalTrajPtIdx = g_actionServer_FJT_SendGoal_Request.goal.trajectory.points.size - 1;
+        size_t finalTrajPtIdx = ros_goal_request->goal.trajectory.points.size - 1;
 
         STATUS statusGoalToleranceReorder = Ros_ActionServer_FJT_Reorder_TrajPt_To_Internal_Order(
-            &g_actionServer_FJT_SendGoal_Request.goal.trajectory.points.data[finalTrajPtIdx],
-            &g_actionServer_FJT_SendGoal_Request.goal.trajectory.joint_names,
+            &ros_goal_request->goal.trajectory.points.data[finalTrajPtIdx],
+            &ros_goal_request->goal.trajectory.joint_names,
             &feedback_FollowJointTrajectory.feedback.joint_names,
             lastTrajPtPositions,
             numAxesToCheck);
@@ -705,14 +935,13 @@ void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
 goal_complete_skip_tolerance_comparison: ;
         //-----------------------------------------------------------------------
         //check execution time
-        control_msgs__action__FollowJointTrajectory_SendGoal_Request*  ros_goal_request = (control_msgs__action__FollowJointTrajectory_SendGoal_Request*)fjt_active_goal_handle->ros_goal_request;
-        trajectory_msgs__msg__JointTrajectoryPoint__Sequence* points = &ros_goal_request->goal.trajectory.points;
-        INT64 desiredTime = Ros_Duration_Msg_To_Nanos(&points->data[points->size - 1].time_from_start); //the desired time of the last point in the trajectory
+        builtin_interfaces__msg__Duration durationDesired = *Ros_ActionServer_FJT_GetFinalTimeFromStart(ros_goal_request);
+        INT64 desiredTime = Ros_Duration_Msg_To_Nanos(&durationDesired); //the desired time of the last point in the trajectory
 
         INT64 totalTime = (trajectory_end_time_ns - fjt_trajectory_start_time_ns);
 
         diff = abs(desiredTime - totalTime);
-        timeTolerance = Ros_Duration_Msg_To_Nanos(&g_actionServer_FJT_SendGoal_Request.goal.goal_time_tolerance);
+        timeTolerance = Ros_Duration_Msg_To_Nanos(&ros_goal_request->goal.goal_time_tolerance);
         if (timeTolerance == 0) //user did NOT provide a tolerance
         {
             timeTolerance = DEFAULT_FJT_GOAL_TIME_TOLERANCE;
@@ -770,7 +999,6 @@ goal_complete_skip_tolerance_comparison: ;
             }
             else if (!timeOk)
             {
-                builtin_interfaces__msg__Duration durationDesired = points->data[points->size - 1].time_from_start;
                 builtin_interfaces__msg__Duration durationActual;
                 Ros_Nanos_To_Duration_Msg(totalTime, &durationActual);
 
@@ -783,9 +1011,7 @@ goal_complete_skip_tolerance_comparison: ;
             }
         }
 
-        Ros_Debug_BroadcastMsg(fjt_result_response.result.error_string.data);
-
-        Ros_ActionServer_FJT_DeleteFeedbackMessage();
+        Ros_Debug_BroadcastMsg("%s", fjt_result_response.result.error_string.data);
     }
 
     //**********************************************************************
@@ -797,8 +1023,6 @@ goal_complete_skip_tolerance_comparison: ;
         rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, "Goal was cancelled by the user.");
 
         fjt_result_response.result.error_code = RESULT_REPONSE_ERROR_CODE(control_msgs__action__FollowJointTrajectory_Result__GOAL_TOLERANCE_VIOLATED, FAIL_TRAJ_CANCEL);
-
-        Ros_ActionServer_FJT_DeleteFeedbackMessage();
     }
 
     //**********************************************************************
@@ -811,10 +1035,30 @@ goal_complete_skip_tolerance_comparison: ;
           "Goal was aborted due to an alarm or error (check RobotStatus messages).");
 
         fjt_result_response.result.error_code = RESULT_REPONSE_ERROR_CODE(control_msgs__action__FollowJointTrajectory_Result__INVALID_GOAL, FAIL_TRAJ_ALARM);
+    }
 
-        Ros_ActionServer_FJT_DeleteFeedbackMessage();
+    //**********************************************************************
+    //append the execution report to whatever result string was set above, for successful
+    //goals as well: the statistics are meant for tuning throughput
+    if (fjt_active_goal_handle != NULL)
+    {
+        control_msgs__action__FollowJointTrajectory_SendGoal_Request* active_goal_request =
+            (control_msgs__action__FollowJointTrajectory_SendGoal_Request*)fjt_active_goal_handle->ros_goal_request;
+        INT64 plannedTime = Ros_Duration_Msg_To_Nanos(Ros_ActionServer_FJT_GetFinalTimeFromStart(active_goal_request));
+
+        snprintf(fjt_result_string_buffer, SIZEOF_FJT_RESULT_STRING_BUFFER, "%s", fjt_result_response.result.error_string.data);
+        size_t len = Ros_strnlen(fjt_result_string_buffer, SIZEOF_FJT_RESULT_STRING_BUFFER);
+        Ros_ActionServer_FJT_FormatExecutionReport(plannedTime, trajectory_end_time_ns - fjt_trajectory_start_time_ns,
+            fjt_result_string_buffer + len, SIZEOF_FJT_RESULT_STRING_BUFFER - len);
+        rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, fjt_result_string_buffer);
+
+        Ros_Telemetry_Record(TELEMETRY_EVENT_FJT_GOAL_COMPLETE, (UINT16)goal_end_type, Ros_Telemetry_GoalId(fjt_active_goal_handle->goal_id.uuid),
+            (INT32)fjt_result_response.result.error_code, (INT32)(plannedTime / 1000000LL),
+            (INT32)((trajectory_end_time_ns - fjt_trajectory_start_time_ns) / 1000000LL));
     }
 
+    Ros_ActionServer_FJT_DeleteFeedbackMessage();
+
     fjt_result_message_ready = TRUE;
 
     //----------------------------------------------------
@@ -824,7 +1068,21 @@ goal_complete_skip_tolerance_comparison: ;
 bool Ros_ActionServer_FJT_Goal_Cancel(rclc_action_goal_handle_t* goal_handle, void* context)
 {
     (void)context;
-    (void)goal_handle;
+
+    if (goal_handle == fjt_staged_goal_handle)
+    {
+        //not executing yet, so there is no motion to stop
+        Ros_Debug_BroadcastMsg("Staged goal canceled");
+
+        Ros_MotionControl_DiscardStagedTrajectory();
+        fjt_staged_goal_handle = NULL;
+
+        Ros_ActionServer_FJT_RejectGoal(goal_handle, GOAL_STATE_CANCELED,
+            control_msgs__action__FollowJointTrajectory_Result__GOAL_TOLERANCE_VIOLATED, FAIL_TRAJ_CANCEL,
+            "Goal was cancelled by the user.");
+
+        return true;
+    }
 
     Ros_Debug_BroadcastMsg("Goal Canceled");
 
@@ -835,6 +1093,53 @@ bool Ros_ActionServer_FJT_Goal_Cancel(rclc_action_goal_handle_t* goal_handle, vo
     return true;
 }
 
+//Called once the result of the active goal has been sent. Either starts the staged
+//goal (the previous one must have succeeded) or aborts it without executing it.
+static void Ros_ActionServer_FJT_StartStagedGoal(BOOL bPrecedingGoalSucceeded)
+{
+    if (fjt_staged_goal_handle == NULL)
+        return;
+
+    rclc_action_goal_handle_t* goal_handle = fjt_staged_goal_handle;
+    fjt_staged_goal_handle = NULL;
+
+    int motomanErrorCode = INIT_TRAJ_PRECEDING_GOAL_FAILED;
+    char const* error_string = Ros_ActionServer_FJT_InitTrajStatus_ToString(INIT_TRAJ_PRECEDING_GOAL_FAILED);
+    if (bPrecedingGoalSucceeded)
+    {
+        if (!Ros_MotionControl_IsMotionMode_Trajectory())
+        {
+            motomanErrorCode = INIT_TRAJ_WRONG_MODE;
+            error_string = "Must call " SERVICE_NAME_START_TRAJ_MODE " service.";
+        }
+        else if (!Ros_Controller_IsMotionReady())
+        {
+            motomanErrorCode = Ros_Controller_GetNotReadySubcode();
+            error_string = Ros_ErrorHandling_MotionNotReadyCode_ToString((MotionNotReadyCode)motomanErrorCode);
+        }
+        else
+        {
+            Init_Trajectory_Status trajStatus = Ros_MotionControl_ActivateStagedTrajectory();
+            if (trajStatus == INIT_TRAJ_OK)
+            {
+                Ros_Debug_BroadcastMsg("FollowJointTrajectory - Starting staged goal");
+                Ros_ActionServer_FJT_ActivateGoal(goal_handle);
+                return;
+            }
+
+            motomanErrorCode = trajStatus;
+            error_string = Ros_ActionServer_FJT_InitTrajStatus_ToString(trajStatus);
+        }
+    }
+
+    Ros_MotionControl_DiscardStagedTrajectory();
+
+    Ros_Debug_BroadcastMsg("FollowJointTrajectory - Staged goal aborted");
+
+    Ros_ActionServer_FJT_RejectGoal(goal_handle, GOAL_STATE_ABORTED,
+        control_msgs__action__FollowJointTrajectory_Result__INVALID_GOAL, motomanErrorCode, error_string);
+}
+
 void Ros_ActionServer_FJT_ProcessResult()
 {
     rcl_ret_t rc;
@@ -844,20 +1149,28 @@ void Ros_ActionServer_FJT_ProcessResult()
         rc = rclc_action_send_result(fjt_active_goal_handle, fjt_goal_state, &fjt_result_response);
         if (rc == RCL_RET_OK)
         {
+            Ros_Telemetry_Record(TELEMETRY_EVENT_FJT_RESULT_SENT, 0, Ros_Telemetry_GoalId(fjt_active_goal_handle->goal_id.uuid),
+                fjt_goal_state, (INT32)fjt_result_response.result.error_code, 0);
+
             micro_ros_string_utilities_destroy(&fjt_result_response.result.error_string);
             fjt_active_goal_handle = NULL;
             fjt_result_message_ready = FALSE;
-        }
 
+            Ros_ActionServer_FJT_StartStagedGoal(fjt_goal_state == GOAL_STATE_SUCCEEDED);
+        }
     }
-    else if (fjt_rejected_goal_handle && fjt_result_message_ready)
+
+    if (fjt_rejected_goal_handle && fjt_rejected_result_message_ready)
     {
-        rc = rclc_action_send_result(fjt_rejected_goal_handle, GOAL_STATE_ABORTED, &fjt_result_response);
+        rc = rclc_action_send_result(fjt_rejected_goal_handle, fjt_rejected_goal_state, &fjt_rejected_result_response);
         if (rc == RCL_RET_OK)
         {
-            micro_ros_string_utilities_destroy(&fjt_result_response.result.error_string);
+            Ros_Telemetry_Record(TELEMETRY_EVENT_FJT_RESULT_SENT, 0, Ros_Telemetry_GoalId(fjt_rejected_goal_handle->goal_id.uuid),
+                fjt_rejected_goal_state, (INT32)fjt_rejected_result_response.result.error_code, 0);
+
+            micro_ros_string_utilities_destroy(&fjt_rejected_result_response.result.error_string);
             fjt_rejected_goal_handle = NULL;
-            fjt_result_message_ready = FALSE;
+            fjt_rejected_result_message_ready = FALSE;
         }
     }
 }
@@ -14,9 +14,13 @@
 #define DEFAULT_FJT_GOAL_POSITION_TOLERANCE  (0.01) //radians per axis or meters per axis
 #define DEFAULT_FJT_GOAL_TIME_TOLERANCE      (500000000LL) //nanoseconds (0.5 seconds)
 
+//One goal being executed, plus one goal that is converted and staged while the first is still executing
+#define FJT_NUMBER_OF_GOAL_HANDLES          2
+
 extern rclc_action_server_t g_actionServerFollowJointTrajectory;
 
-extern control_msgs__action__FollowJointTrajectory_SendGoal_Request g_actionServer_FJT_SendGoal_Request;
+//Storage for FJT_NUMBER_OF_GOAL_HANDLES goal requests, g_actionServer_FJT_SendGoal_Request__sizeof bytes apart
+extern control_msgs__action__FollowJointTrajectory_SendGoal_Request* g_actionServer_FJT_SendGoal_Request;
 extern UINT32 g_actionServer_FJT_SendGoal_Request__sizeof;
 
 extern void Ros_ActionServer_FJT_Initialize();
@@ -27,7 +31,11 @@ extern void Ros_ActionServer_FJT_ProcessFeedback();
 extern void Ros_ActionServer_FJT_ProcessResult();
 extern bool Ros_ActionServer_FJT_Goal_Cancel(rclc_action_goal_handle_t* goal_handle, void* context);
 
-extern void Ros_ActionServer_FJT_UpdateProgressTracker(MP_EXPOS_DATA* incrementData);
+//Called from the increment-move loop once per interpolation cycle in which increments were sent.
+//  bQueueUnderrun: a group had no increments in its queue while its trajectory was still being processed
+//  bFsuLimited: the controller did not process all pulses sent during the previous cycle (FSU speed limit)
+//  peakBacklogPulses: largest absolute number of pulses (any axis) still waiting to be processed
+extern void Ros_ActionServer_FJT_UpdateExecutionStats(BOOL bQueueUnderrun, BOOL bFsuLimited, LONG peakBacklogPulses);
 
 
 #endif  // MOTOROS2_ACTION_SERVER_FJT_H
@@ -0,0 +1,335 @@
+//ClockSync.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+//The MotoROS2 clock is a linear function of the time elapsed since the start of 'baseTick':
+//
+//  time(elapsed) = baseTime_ns + elapsed * (1 + drift) + slew
+//
+//where 'slew' is the part of 'slew_ns' which has been applied at that point (it's applied at
+//CLOCK_SYNC_MAX_SLEW_PPM, so it doesn't make the clock jump, nor stop). Offsets larger than
+//CLOCK_SYNC_STEP_THRESHOLD_NS replace the model, so the clock can jump (also backwards).
+//
+//'elapsed' is counted in ticks, plus the time since the start of the current tick. The latter
+//is measured with the controller's wall clock, relative to its value at the start of 'baseTick'
+//(and limited to a single tick, so changes to the wall clock can't make it jump).
+typedef struct
+{
+    ULONG baseTick;
+    INT64 baseTickRealtime_ns;  // wall clock of the controller at the start of 'baseTick'
+    INT64 baseTime_ns;
+    double drift;
+    INT64 slew_ns;
+} ClockSync_Model;
+
+//The model is only updated by the Agent monitor task, but read by all tasks (including the
+//IncMoveTask). Readers use the active copy, while the update is prepared in the other one.
+//Readers can't block the update (or the other way around) this way. The Agent monitor
+//task updates the model at most once per PERIOD_COMMUNICATION_PING_AGENT_MS, so a reader
+//would have to be preempted for that long to see a model being modified.
+static ClockSync_Model clockSync_models[2];
+static volatile int clockSync_activeModel = 0;
+
+static INT64 clockSync_nsPerTick = 1000000LL;
+
+static BOOL clockSync_bSynchronized = FALSE;
+static ULONG clockSync_lastSampleBaseTick;     // last sample, as the time elapsed since the start of this tick
+static INT64 clockSync_lastSampleElapsed_ns;
+static INT64 clockSync_prevOffset_ns;
+static INT64 clockSync_rttHistory_ns[CLOCK_SYNC_RTT_HISTORY];
+static int clockSync_rttHistoryCount = 0;
+
+static ClockSync_Stats clockSync_stats;
+
+static INT64 Ros_ClockSync_RealtimeNanos()
+{
+    struct timespec tp;
+
+    clock_gettime(CLOCK_REALTIME, &tp);
+    return ((INT64)tp.tv_sec * 1000000000LL) + (INT64)tp.tv_nsec;
+}
+
+//Time elapsed between the start of 'model->baseTick' and the start of 'tick'
+static INT64 Ros_ClockSync_TickElapsed(ClockSync_Model const* const model, ULONG tick)
+{
+    //unsigned difference, so this is correct across a wrap of the tick counter
+    return (INT64)(ULONG)(tick - model->baseTick) * clockSync_nsPerTick;
+}
+
+//Time elapsed since the start of 'model->baseTick', including the part of the current tick
+static INT64 Ros_ClockSync_Elapsed(ClockSync_Model const* const model)
+{
+    ULONG tick;
+    INT64 realtime_ns;
+
+    //both from the same tick
+    do
+    {
+        tick = tickGet();
+        realtime_ns = Ros_ClockSync_RealtimeNanos();
+    } while (tickGet() != tick);
+
+    INT64 tickElapsed_ns = Ros_ClockSync_TickElapsed(model, tick);
+    INT64 subTick_ns = realtime_ns - (model->baseTickRealtime_ns + tickElapsed_ns);
+
+    if (subTick_ns < 0)
+        subTick_ns = 0;
+    if (subTick_ns >= clockSync_nsPerTick)
+        subTick_ns = clockSync_nsPerTick - 1;
+
+    return tickElapsed_ns + subTick_ns;
+}
+
+//Wait for the start of the next tick, and return it together with the wall clock at that
+//point. Used to (re)calibrate the interpolation within a tick.
+static void Ros_ClockSync_WaitForTickStart(ULONG* tick, INT64* realtime_ns)
+{
+    mpTaskDelay(1);
+    *tick = tickGet();
+    *realtime_ns = Ros_ClockSync_RealtimeNanos();
+}
+
+//Returns the time at 'elapsed_ns' according to 'model', and (optionally) how much of its slew
+//has been applied at that point
+static INT64 Ros_ClockSync_Evaluate(ClockSync_Model const* const model, INT64 elapsed_ns, INT64* slewApplied_ns)
+{
+    INT64 maxSlew_ns = (elapsed_ns * CLOCK_SYNC_MAX_SLEW_PPM) / 1000000LL;
+    INT64 slew_ns;
+
+    if (model->slew_ns >= 0)
+        slew_ns = (model->slew_ns < maxSlew_ns) ? model->slew_ns : maxSlew_ns;
+    else
+        slew_ns = (model->slew_ns > -maxSlew_ns) ? model->slew_ns : -maxSlew_ns;
+
+    if (slewApplied_ns != NULL)
+        *slewApplied_ns = slew_ns;
+
+    return model->baseTime_ns + elapsed_ns + (INT64)((double)elapsed_ns * model->drift) + slew_ns;
+}
+
+//Restart 'model' at the start of 'tick' (when the wall clock was at 'tickRealtime_ns'),
+//without changing the time it produces at that point
+static void Ros_ClockSync_Rebase(ClockSync_Model const* const model, ULONG tick, INT64 tickRealtime_ns, ClockSync_Model* const rebased)
+{
+    INT64 slewApplied_ns;
+
+    rebased->baseTime_ns = Ros_ClockSync_Evaluate(model, Ros_ClockSync_TickElapsed(model, tick), &slewApplied_ns);
+    rebased->baseTick = tick;
+    rebased->baseTickRealtime_ns = tickRealtime_ns;
+    rebased->drift = model->drift;
+    rebased->slew_ns = model->slew_ns - slewApplied_ns;
+}
+
+static void Ros_ClockSync_Publish(ClockSync_Model const* const model)
+{
+    int inactive = 1 - clockSync_activeModel;
+
+    clockSync_models[inactive] = *model;
+    clockSync_activeModel = inactive;
+}
+
+void Ros_ClockSync_Initialize()
+{
+    ClockSync_Model model;
+
+    clockSync_nsPerTick = (INT64)mpGetRtc() * 1000000LL;
+
+    Ros_ClockSync_WaitForTickStart(&model.baseTick, &model.baseTickRealtime_ns);
+    model.baseTime_ns = model.baseTickRealtime_ns;
+    model.drift = 0.0;
+    model.slew_ns = 0;
+    Ros_ClockSync_Publish(&model);
+
+    clockSync_bSynchronized = FALSE;
+    clockSync_rttHistoryCount = 0;
+    bzero(&clockSync_stats, sizeof(clockSync_stats));
+}
+
+INT64 Ros_ClockSync_Now()
+{
+    ClockSync_Model model = clockSync_models[clockSync_activeModel];
+
+    return Ros_ClockSync_Evaluate(&model, Ros_ClockSync_Elapsed(&model), NULL);
+}
+
+//Returns FALSE if the round trip of the sample is too long compared to recent ones.
+//The shortest round trip of the last few updates is used as the reference, so the gate
+//adapts when the network path changes.
+static BOOL Ros_ClockSync_CheckRoundTrip(INT64 rtt_ns)
+{
+    INT64 minRtt_ns = rtt_ns;
+    int count = (clockSync_rttHistoryCount < CLOCK_SYNC_RTT_HISTORY) ? clockSync_rttHistoryCount : CLOCK_SYNC_RTT_HISTORY;
+
+    for (int i = 0; i < count; i += 1)
+    {
+        if (clockSync_rttHistory_ns[i] < minRtt_ns)
+            minRtt_ns = clockSync_rttHistory_ns[i];
+    }
+
+    clockSync_rttHistory_ns[clockSync_rttHistoryCount % CLOCK_SYNC_RTT_HISTORY] = rtt_ns;
+    clockSync_rttHistoryCount += 1;
+
+    clockSync_stats.lastRtt_ns = rtt_ns;
+    clockSync_stats.minRtt_ns = minRtt_ns;
+
+    return (rtt_ns <= (minRtt_ns * CLOCK_SYNC_RTT_GATE_FACTOR) + CLOCK_SYNC_RTT_GATE_MARGIN_NS);
+}
+
+void Ros_ClockSync_Update()
+{
+    ClockSync_Model const* const current = &clockSync_models[clockSync_activeModel];
+    ClockSync_Model updated;
+    BOOL bHaveSample = FALSE;
+    INT64 sampleElapsed_ns = 0;     // since the start of current->baseTick
+    INT64 sampleTime_ns = 0;
+    INT64 sampleRtt_ns = 0;
+
+    if (g_nodeConfigSettings.sync_timeclock_with_agent)
+    {
+        //The exchange with the shortest round trip is the least likely to have been
+        //delayed asymmetrically.
+        for (int i = 0; i < CLOCK_SYNC_EXCHANGES_PER_UPDATE; i += 1)
+        {
+            INT64 start_ns = Ros_ClockSync_Elapsed(current);
+            if (rmw_uros_sync_session(CLOCK_SYNC_SESSION_TIMEOUT_MS) != RMW_RET_OK)
+                break; //no point in trying again if the Agent doesn't reply now
+
+            INT64 agentTime_ns = rmw_uros_epoch_nanos();
+            INT64 end_ns = Ros_ClockSync_Elapsed(current);
+            INT64 rtt_ns = end_ns - start_ns;
+
+            Ros_Communication_NotifyAgentActivity();
+
+            if (!bHaveSample || rtt_ns < sampleRtt_ns)
+            {
+                //The offset of the XRCE session assumes both legs of the exchange took
+                //equally long, so the sample is taken at its midpoint
+                bHaveSample = TRUE;
+                sampleElapsed_ns = start_ns + (rtt_ns / 2);
+                sampleTime_ns = agentTime_ns - (end_ns - sampleElapsed_ns);
+                sampleRtt_ns = rtt_ns;
+            }
+        }
+
+        if (bHaveSample && !Ros_ClockSync_CheckRoundTrip(sampleRtt_ns))
+            bHaveSample = FALSE;
+
+        if (!bHaveSample)
+            clockSync_stats.numDiscarded += 1;
+    }
+    else
+    {
+        //Follow the wall clock of the controller, so changes to it (fi: made on the
+        //pendant) are picked up as well. Those are stepped or slewed like offsets to
+        //the Agent's clock.
+        sampleElapsed_ns = Ros_ClockSync_Elapsed(current);
+        sampleTime_ns = Ros_ClockSync_RealtimeNanos();
+        bHaveSample = TRUE;
+    }
+
+    //the new model also recalibrates the interpolation within a tick
+    ULONG tickNow;
+    INT64 tickNowRealtime_ns;
+    Ros_ClockSync_WaitForTickStart(&tickNow, &tickNowRealtime_ns);
+
+    if (!bHaveSample)
+    {
+        //keep extrapolating with the current estimates
+        Ros_ClockSync_Rebase(current, tickNow, tickNowRealtime_ns, &updated);
+        Ros_ClockSync_Publish(&updated);
+        return;
+    }
+
+    INT64 slewAppliedAtSample_ns;
+    INT64 offset_ns = sampleTime_ns - Ros_ClockSync_Evaluate(current, sampleElapsed_ns, &slewAppliedAtSample_ns);
+    INT64 absOffset_ns = (offset_ns < 0) ? -offset_ns : offset_ns;
+
+    if (!clockSync_bSynchronized || absOffset_ns > CLOCK_SYNC_STEP_THRESHOLD_NS)
+    {
+        Ros_Debug_BroadcastMsg("Clock sync: stepping clock by %lld us", offset_ns / 1000);
+
+        updated.baseTick = tickNow;
+        updated.baseTickRealtime_ns = tickNowRealtime_ns;
+        updated.baseTime_ns = sampleTime_ns + (Ros_ClockSync_TickElapsed(current, tickNow) - sampleElapsed_ns);
+        updated.drift = clockSync_bSynchronized ? current->drift : 0.0;
+        updated.slew_ns = 0;
+
+        clockSync_bSynchronized = TRUE;
+        clockSync_prevOffset_ns = 0;
+        clockSync_stats.numSteps += 1;
+        clockSync_stats.maxAbsOffset_ns = 0;
+        clockSync_stats.jitter_ns = 0;
+    }
+    else
+    {
+        //The offset includes the part of the previous correction which had not been applied
+        //yet, which is not caused by a difference in rate
+        INT64 interval_ns = (INT64)(ULONG)(current->baseTick - clockSync_lastSampleBaseTick) * clockSync_nsPerTick +
+            sampleElapsed_ns - clockSync_lastSampleElapsed_ns;
+        INT64 unapplied_ns = current->slew_ns - slewAppliedAtSample_ns;
+        double drift = current->drift;
+
+        if (interval_ns > 0)
+            drift += CLOCK_SYNC_DRIFT_GAIN * ((double)(offset_ns - unapplied_ns) / (double)interval_ns);
+        if (drift > CLOCK_SYNC_MAX_DRIFT_PPM * 1e-6)
+            drift = CLOCK_SYNC_MAX_DRIFT_PPM * 1e-6;
+        if (drift < -CLOCK_SYNC_MAX_DRIFT_PPM * 1e-6)
+            drift = -CLOCK_SYNC_MAX_DRIFT_PPM * 1e-6;
+
+        //Restart from the current time (instead of from the sample) as the clock may already
+        //have been read since. The part of the old correction applied since the sample
+        //no longer needs to be applied.
+        INT64 slewAppliedNow_ns;
+        Ros_ClockSync_Rebase(current, tickNow, tickNowRealtime_ns, &updated);
+        Ros_ClockSync_Evaluate(current, Ros_ClockSync_TickElapsed(current, tickNow), &slewAppliedNow_ns);
+        updated.drift = drift;
+        updated.slew_ns = offset_ns - (slewAppliedNow_ns - slewAppliedAtSample_ns);
+
+        INT64 change_ns = offset_ns - clockSync_prevOffset_ns;
+        if (change_ns < 0)
+            change_ns = -change_ns;
+        clockSync_stats.jitter_ns += (INT64)((double)(change_ns - clockSync_stats.jitter_ns) * CLOCK_SYNC_JITTER_GAIN);
+        if (absOffset_ns > clockSync_stats.maxAbsOffset_ns)
+            clockSync_stats.maxAbsOffset_ns = absOffset_ns;
+        clockSync_prevOffset_ns = offset_ns;
+    }
+
+    Ros_ClockSync_Publish(&updated);
+
+    clockSync_lastSampleBaseTick = current->baseTick;
+    clockSync_lastSampleElapsed_ns = sampleElapsed_ns;
+    clockSync_stats.lastOffset_ns = offset_ns;
+    clockSync_stats.drift_ppm = updated.drift * 1e6;
+    clockSync_stats.numUpdates += 1;
+
+    Ros_Telemetry_Record(TELEMETRY_EVENT_CLOCK_SYNC, 0, (INT32)(offset_ns / 1000), (INT32)(sampleRtt_ns / 1000),
+        (INT32)(updated.drift * 1e9), (INT32)(clockSync_stats.jitter_ns / 1000));
+
+    if ((clockSync_stats.numUpdates % CLOCK_SYNC_REPORT_PERIOD) == 0)
+        Ros_ClockSync_ReportStats();
+}
+
+void Ros_ClockSync_GetStats(ClockSync_Stats* const stats)
+{
+    *stats = clockSync_stats;
+}
+
+void Ros_ClockSync_ReportStats()
+{
+    ClockSync_Stats stats;
+
+    if (!g_nodeConfigSettings.sync_timeclock_with_agent)
+        return;
+
+    Ros_ClockSync_GetStats(&stats);
+    Ros_Debug_BroadcastMsg("Clock sync: offset %lld us (max %lld us), jitter %lld us, drift %.3f ppm, "
+        "round trip %lld us (min %lld us), %d updates (%d discarded), %d steps",
+        stats.lastOffset_ns / 1000, stats.maxAbsOffset_ns / 1000, stats.jitter_ns / 1000, stats.drift_ppm,
+        stats.lastRtt_ns / 1000, stats.minRtt_ns / 1000,
+        (int)stats.numUpdates, (int)stats.numDiscarded, (int)stats.numSteps);
+}
@@ -0,0 +1,73 @@
+//ClockSync.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_CLOCK_SYNC_H
+#define MOTOROS2_CLOCK_SYNC_H
+
+#define CLOCK_SYNC_SESSION_TIMEOUT_MS       100
+#define CLOCK_SYNC_EXCHANGES_PER_UPDATE     4       // the one with the shortest round trip is used
+
+//Samples with a round trip longer than (CLOCK_SYNC_RTT_GATE_FACTOR * shortest recent round trip)
+//+ CLOCK_SYNC_RTT_GATE_MARGIN_NS are most likely delayed on one leg only, and are discarded
+#define CLOCK_SYNC_RTT_HISTORY              8       // updates
+#define CLOCK_SYNC_RTT_GATE_FACTOR          2
+#define CLOCK_SYNC_RTT_GATE_MARGIN_NS       1000000LL
+
+//Errors larger than this are corrected by stepping the clock instead of slewing it (fi: the first sync)
+#define CLOCK_SYNC_STEP_THRESHOLD_NS        100000000LL
+#define CLOCK_SYNC_MAX_SLEW_PPM             500     // max rate at which offset errors are corrected
+#define CLOCK_SYNC_MAX_DRIFT_PPM            500
+#define CLOCK_SYNC_DRIFT_GAIN               0.25    // fraction of the observed frequency error corrected per update
+#define CLOCK_SYNC_JITTER_GAIN              (1.0 / 16.0)
+
+#define CLOCK_SYNC_REPORT_PERIOD            12      // updates between reports of the statistics on the debug log
+
+typedef struct
+{
+    UINT32 numUpdates;          // updates which produced a sample
+    UINT32 numDiscarded;        // updates rejected because of a long round trip (or which got no reply at all)
+    UINT32 numSteps;
+    INT64 lastOffset_ns;        // error of the MotoROS2 clock w.r.t. the Agent, before correcting it
+    INT64 maxAbsOffset_ns;      // since the last step
+    INT64 jitter_ns;            // smoothed variation of the offset between updates
+    INT64 lastRtt_ns;
+    INT64 minRtt_ns;
+    double drift_ppm;           // estimated rate of the Agent's clock relative to the controller's tick
+} ClockSync_Stats;
+
+//Anchor the MotoROS2 clock to the wall clock of the controller. Timestamps follow the
+//controller's clock until the first sample from the Agent has been processed.
+//Waits for the start of the next tick.
+extern void Ros_ClockSync_Initialize();
+
+//Exchange a few sync messages with the Agent, and use the one with the shortest round trip
+//to update the offset and drift estimates. Only called by the Agent monitor task. Waits
+//for the start of the next tick.
+//
+//If 'sync_timeclock_with_agent' is disabled, the wall clock of the controller is used as the
+//reference instead, so changes to it are followed. As this is only called while connected to
+//the Agent, the clock continues at its last rate while disconnected.
+//
+//Must be called at least once every 2^32 ticks, as Ros_ClockSync_Now() extrapolates from
+//the tick of the last update.
+extern void Ros_ClockSync_Update();
+
+//Current time, in nanoseconds since the epoch (of the Agent's clock, if 'sync_timeclock_with_agent'
+//is enabled). Derived from the controller's tick, and interpolated within a tick using the
+//wall clock of the controller (which doesn't improve the resolution on controllers where that
+//clock is also tick based). Offset errors are corrected by slightly
+//changing the rate of the clock, so small corrections don't make it jump. Errors larger than
+//CLOCK_SYNC_STEP_THRESHOLD_NS (and the first sync) are stepped, which can make the clock jump
+//backwards.
+//
+//Can be called from any task.
+extern INT64 Ros_ClockSync_Now();
+
+extern void Ros_ClockSync_GetStats(ClockSync_Stats* const stats);
+extern void Ros_ClockSync_ReportStats();
+
+#endif  // MOTOROS2_CLOCK_SYNC_H
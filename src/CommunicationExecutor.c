@@ -8,9 +8,12 @@
 #include "MotoROS.h"
 
 Communication_NodeInfo g_microRosNodeInfo;
-BOOL g_Ros_Communication_AgentIsConnected;
+volatile BOOL g_Ros_Communication_AgentIsConnected;
 rmw_init_options_t* rmw_connectionoptions;
 
+//tick of the last sign of life of the Agent (or of a client talking to us through it)
+static volatile ULONG communicationExecutor_tickLastAgentActivity;
+
 void Ros_Communication_ConnectToAgent()
 {
     rcl_ret_t ret = RCL_RET_ERROR;
@@ -210,22 +213,269 @@ void Ros_Communication_Cleanup()
     MOTOROS2_MEM_TRACE_REPORT(comm_exec_fini);
 }
 
-void Ros_Communication_PingAgentConnection(rcl_timer_t* timer, int64_t last_call_time)
+void Ros_Communication_NotifyAgentActivity()
+{
+    communicationExecutor_tickLastAgentActivity = tickGet();
+}
+
+//Returns FALSE (and flags the Agent as disconnected) if there has been no activity for
+//longer than 'agent_heartbeat_timeout'. Motion is stopped right away (if configured to),
+//instead of leaving that to the executor task, which may first have to wait for callbacks
+//and the other tasks to finish.
+static BOOL Ros_Communication_CheckAgentHeartbeat()
+{
+    int msSinceActivity = (int)((tickGet() - communicationExecutor_tickLastAgentActivity) * mpGetRtc());
+
+    if (msSinceActivity < g_nodeConfigSettings.agent_heartbeat_timeout)
+        return TRUE;
+
+    g_Ros_Communication_AgentIsConnected = FALSE;
+    Ros_Debug_BroadcastMsg("Agent heartbeat lost: no activity for %d ms (timeout: %d ms), flagging Agent as disconnected",
+        msSinceActivity, g_nodeConfigSettings.agent_heartbeat_timeout);
+
+    if (g_nodeConfigSettings.stop_motion_on_disconnect &&
+        Ros_Controller_IsInMotion() && Ros_MotionControl_IsRosControllingMotion())
+    {
+        Ros_MotionControl_StopMotion(/*bKeepJobRunning = */ TRUE);
+        Ros_Debug_BroadcastMsg("Stopped ROS-controlled motion %d ms after last Agent activity",
+            (int)((tickGet() - communicationExecutor_tickLastAgentActivity) * mpGetRtc()));
+    }
+    return FALSE;
+}
+
+//Checks the connection with the Agent (and synchronises the clocks, if enabled) in its own
+//task, as a ping can take up to (AGENT_PING_TIMEOUT_MS * AGENT_PING_ATTEMPTS) on a lossy link.
+//Doing this from one of the executors would block all of its callbacks for that long.
+//
+//If 'agent_heartbeat_timeout' is set, the Agent is also pinged multiple times per timeout
+//period (with a single attempt each). Any reply, or any incoming motion command, counts as
+//a heartbeat.
+//
+//This task only ever flags the Agent as disconnected: it never sets
+//g_Ros_Communication_AgentIsConnected, so it can't revive a connection which was
+//dropped by any of the other monitors (fi: the UserLan link state monitor).
+void Ros_Communication_RunAgentMonitor(SEM_ID semAgentMonitorStatus)
+{
+    BOOL bHeartbeatEnabled = (g_nodeConfigSettings.agent_heartbeat_timeout > 0);
+    int poll_ms = bHeartbeatEnabled ?
+        (g_nodeConfigSettings.agent_heartbeat_timeout / AGENT_HEARTBEAT_PINGS_PER_TIMEOUT) :
+        PERIOD_COMMUNICATION_AGENT_MONITOR_POLL_MS;
+    int elapsed_ms = 0;
+    rcl_ret_t ret;
+
+    //we just connected, so that counts as activity
+    Ros_Communication_NotifyAgentActivity();
+
+    //don't wait a full period before (re)synchronising with the Agent's clock
+    Ros_ClockSync_Update();
+
+    while (g_Ros_Communication_AgentIsConnected)
+    {
+        //sleep in short increments, to notice a disconnect (by someone else) in time
+        Ros_Sleep(poll_ms);
+
+        if (bHeartbeatEnabled)
+        {
+            ret = rmw_uros_ping_agent_options(poll_ms, 1, rmw_connectionoptions);
+            if (ret == RCL_RET_OK)
+                Ros_Communication_NotifyAgentActivity();
+
+            if (!Ros_Communication_CheckAgentHeartbeat())
+                break;
+        }
+
+        elapsed_ms += poll_ms;
+        if (elapsed_ms < PERIOD_COMMUNICATION_PING_AGENT_MS)
+            continue;
+        elapsed_ms = 0;
+
+        //Ensure the Agent is still connected (the heartbeat already does this, if enabled)
+        if (!bHeartbeatEnabled)
+        {
+            ret = rmw_uros_ping_agent_options(AGENT_PING_TIMEOUT_MS, AGENT_PING_ATTEMPTS, rmw_connectionoptions);
+            if (ret != RCL_RET_OK)
+            {
+                Ros_Debug_BroadcastMsg("Agent did not respond to ping (%d), flagging Agent as disconnected", (int)ret);
+                g_Ros_Communication_AgentIsConnected = FALSE;
+                break;
+            }
+        }
+
+        Ros_ClockSync_Update();
+    }
+    Ros_ClockSync_ReportStats();
+    Ros_Debug_BroadcastMsg("Terminating Agent Monitor Task");
+
+    //notify parent task that this has finished
+    mpSemGive(semAgentMonitorStatus);
+
+    mpDeleteSelf;
+}
+
+//==========================================================
+//Callback timing statistics
+//
+//Every executor only updates its own statistics. The report is only informational,
+//so it reads them without synchronisation.
+typedef struct
+{
+    UINT32 numCallbacks;
+    ULONG totalTicks;
+    ULONG maxTicks;
+} Communication_CallbackStats;
+
+static Communication_CallbackStats communicationExecutor_callbackStats[NUM_COMMUNICATION_EXECUTORS];
+
+static const char* const communicationExecutor_names[NUM_COMMUNICATION_EXECUTORS] =
+{
+    "streaming",
+    "goals",
+    "mode changes",
+    "I/O",
+    "diagnostics",
+};
+
+//Returns the tick to pass to Ros_Communication_RecordCallbackDuration when the callback returns
+static ULONG Ros_Communication_BeginCallback(Communication_Executor executor)
+{
+    MOTOROS2_TASK_TRACE_BEGIN(TASK_TRACE_TASK_EXECUTOR + executor, TASK_TRACE_POINT_EXECUTOR_CALLBACK);
+    return tickGet();
+}
+
+static void Ros_Communication_RecordCallbackDuration(Communication_Executor executor, ULONG tickStart)
+{
+    Communication_CallbackStats* stats = &communicationExecutor_callbackStats[executor];
+    ULONG ticks = tickGet() - tickStart;
+
+    MOTOROS2_TASK_TRACE_END(TASK_TRACE_TASK_EXECUTOR + executor, TASK_TRACE_POINT_EXECUTOR_CALLBACK);
+
+    stats->numCallbacks += 1;
+    stats->totalTicks += ticks;
+    if (ticks > stats->maxTicks)
+        stats->maxTicks = ticks;
+}
+
+static void Ros_Communication_ReportCallbackStats()
+{
+    float msPerTick = mpGetRtc();
+
+    for (int i = 0; i < NUM_COMMUNICATION_EXECUTORS; i += 1)
+    {
+        Communication_CallbackStats const* stats = &communicationExecutor_callbackStats[i];
+        if (stats->numCallbacks == 0)
+        {
+            Ros_Debug_BroadcastMsg("Executor '%s': no callbacks", communicationExecutor_names[i]);
+            continue;
+        }
+        Ros_Debug_BroadcastMsg("Executor '%s': %u callbacks, avg: %.2f ms, max: %.1f ms (resolution: %.1f ms)",
+            communicationExecutor_names[i], stats->numCallbacks,
+            (stats->totalTicks * msPerTick) / stats->numCallbacks, stats->maxTicks * msPerTick, msPerTick);
+    }
+}
+
+static void Ros_Communication_ReportCallbackStatsTimer(rcl_timer_t* timer, int64_t last_call_time)
+{
+    Ros_Communication_ReportCallbackStats();
+}
+
+//The callbacks which change the motion mode, or which depend on it not changing while they
+//run (accepting a goal, queueing a point, starting a staged goal), used to be executed one
+//after the other by a single executor. Now that they're spread over several executor tasks,
+//they hold this lock instead. Starting a motion mode can take seconds (starting the job,
+//turning on the servos), so Ros_MotionControl_StartMotionMode only takes the lock to check
+//and update the mode, and start_traj_mode and start_point_queue_mode don't hold it.
+static SEM_ID communicationExecutor_motionModeLock;
+
+void Ros_Communication_LockMotionMode()
+{
+    mpSemTake(communicationExecutor_motionModeLock, WAIT_FOREVER);
+}
+
+void Ros_Communication_UnlockMotionMode()
+{
+    mpSemGive(communicationExecutor_motionModeLock);
+}
+
+//Defines 'callback'_Timed, which calls 'callback' and records its duration for 'executor'
+#define COMMUNICATION_TIMED_SERVICE_CALLBACK(executor, callback) \
+    static void callback##_Timed(const void* request_msg, void* response_msg) \
+    { \
+        ULONG tickStart = Ros_Communication_BeginCallback(executor); \
+        callback(request_msg, response_msg); \
+        Ros_Communication_RecordCallbackDuration(executor, tickStart); \
+    }
+
+//Same, but holds the motion mode lock while 'callback' runs
+#define COMMUNICATION_TIMED_MOTION_MODE_SERVICE_CALLBACK(executor, callback) \
+    static void callback##_Timed(const void* request_msg, void* response_msg) \
+    { \
+        ULONG tickStart = Ros_Communication_BeginCallback(executor); \
+        Ros_Communication_LockMotionMode(); \
+        callback(request_msg, response_msg); \
+        Ros_Communication_UnlockMotionMode(); \
+        Ros_Communication_RecordCallbackDuration(executor, tickStart); \
+    }
+
+#define COMMUNICATION_TIMED_SUBSCRIPTION_CALLBACK(executor, callback) \
+    static void callback##_Timed(const void* msg) \
+    { \
+        ULONG tickStart = Ros_Communication_BeginCallback(executor); \
+        callback(msg); \
+        Ros_Communication_RecordCallbackDuration(executor, tickStart); \
+    }
+
+COMMUNICATION_TIMED_MOTION_MODE_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_STREAMING, Ros_ServiceQueueTrajPoint_Trigger)
+COMMUNICATION_TIMED_SUBSCRIPTION_CALLBACK(COMMUNICATION_EXECUTOR_STREAMING, Ros_TwistServo_CommandReceived)
+
+//these lock the motion mode themselves (see Ros_MotionControl_StartMotionMode)
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_MODE_CHANGES, Ros_ServiceStartTrajMode_Trigger)
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_MODE_CHANGES, Ros_ServiceStartPointQueueMode_Trigger)
+COMMUNICATION_TIMED_MOTION_MODE_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_MODE_CHANGES, Ros_ServiceStopTrajMode_Trigger)
+//these don't access the motion mode
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_MODE_CHANGES, Ros_ServiceResetError_Trigger)
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_MODE_CHANGES, Ros_ServiceSelectMotionTool_Trigger)
+
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_IO, Ros_ServiceReadSingleIO_Trigger)
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_IO, Ros_ServiceReadGroupIO_Trigger)
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_IO, Ros_ServiceWriteSingleIO_Trigger)
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_IO, Ros_ServiceWriteGroupIO_Trigger)
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_IO, Ros_ServiceReadMRegister_Trigger)
+COMMUNICATION_TIMED_SERVICE_CALLBACK(COMMUNICATION_EXECUTOR_IO, Ros_ServiceWriteMRegister_Trigger)
+
+COMMUNICATION_TIMED_SUBSCRIPTION_CALLBACK(COMMUNICATION_EXECUTOR_DIAGNOSTICS, Ros_LogLevel_CommandReceived)
+
+static rcl_ret_t Ros_Communication_FJT_Goal_Received_Timed(rclc_action_goal_handle_t* goal_handle, void* context)
 {
-    //Ensure the Agent is still connected.
-    const int timeout_ms = 1000;
-    const uint8_t attempts = 3;
-    rcl_ret_t ret = rmw_uros_ping_agent_options(timeout_ms, attempts, rmw_connectionoptions);
-    g_Ros_Communication_AgentIsConnected = (ret == RCL_RET_OK);
-
-    if (g_Ros_Communication_AgentIsConnected && g_nodeConfigSettings.sync_timeclock_with_agent)
-        rmw_uros_sync_session(100);
+    ULONG tickStart = Ros_Communication_BeginCallback(COMMUNICATION_EXECUTOR_GOALS);
+    Ros_Communication_LockMotionMode();
+    rcl_ret_t ret = Ros_ActionServer_FJT_Goal_Received(goal_handle, context);
+    Ros_Communication_UnlockMotionMode();
+    Ros_Communication_RecordCallbackDuration(COMMUNICATION_EXECUTOR_GOALS, tickStart);
+    return ret;
 }
 
+static bool Ros_Communication_FJT_Goal_Cancel_Timed(rclc_action_goal_handle_t* goal_handle, void* context)
+{
+    ULONG tickStart = Ros_Communication_BeginCallback(COMMUNICATION_EXECUTOR_GOALS);
+    Ros_Communication_LockMotionMode();
+    bool bCancelled = Ros_ActionServer_FJT_Goal_Cancel(goal_handle, context);
+    Ros_Communication_UnlockMotionMode();
+    Ros_Communication_RecordCallbackDuration(COMMUNICATION_EXECUTOR_GOALS, tickStart);
+    return bCancelled;
+}
+
+//==========================================================
 void Ros_Communication_PublishActionFeedback(rcl_timer_t* timer, int64_t last_call_time)
 {
+    ULONG tickStart = Ros_Communication_BeginCallback(COMMUNICATION_EXECUTOR_GOALS);
+
+    //may stop the motion, or start a staged goal
+    Ros_Communication_LockMotionMode();
     Ros_ActionServer_FJT_ProcessFeedback();
     Ros_ActionServer_FJT_ProcessResult();
+    Ros_Communication_UnlockMotionMode();
+
+    Ros_Communication_RecordCallbackDuration(COMMUNICATION_EXECUTOR_GOALS, tickStart);
 }
 
 static void Ros_Communication_MonitorUserLanState(rcl_timer_t* timer, int64_t last_call_time)
@@ -279,21 +529,50 @@ static void Ros_Communication_MonitorUserLanState(rcl_timer_t* timer, int64_t la
     bLinkWasUp = bLinkIsUp;
 }
 
-void Ros_Communication_RunIoExecutor(rclc_executor_t* executor, SEM_ID semIoExecutorStatus)
+static void Ros_Communication_MonitorUserLanState_Timed(rcl_timer_t* timer, int64_t last_call_time)
+{
+    ULONG tickStart = Ros_Communication_BeginCallback(COMMUNICATION_EXECUTOR_DIAGNOSTICS);
+    Ros_Communication_MonitorUserLanState(timer, last_call_time);
+    Ros_Communication_RecordCallbackDuration(COMMUNICATION_EXECUTOR_DIAGNOSTICS, tickStart);
+}
+
+static void Ros_Communication_ValidateMotionModeIsOk()
 {
-    mpSemTake(semIoExecutorStatus, NO_WAIT);
+    Ros_Communication_LockMotionMode();
+    Ros_MotionControl_ValidateMotionModeIsOk();
+    Ros_Communication_UnlockMotionMode();
+}
 
+//==========================================================
+typedef struct
+{
+    rclc_executor_t executor;
+    Communication_Executor id;
+    int sleepPeriod;                //delay between checks for activity (ms)
+    void (*housekeeping)();         //optional, called after every spin
+    SEM_ID semStatus;               //given when the task has finished
+} Communication_ExecutorTask;
+
+void Ros_Communication_RunExecutor(Communication_ExecutorTask* task)
+{
     while (g_Ros_Communication_AgentIsConnected)
     {
-        Ros_Sleep(g_nodeConfigSettings.executor_sleep_period);
+        Ros_Sleep(task->sleepPeriod);
 
         // timeout specified in nanoseconds
-        rclc_executor_spin_some(executor, RCL_MS_TO_NS(1));
+        rclc_executor_spin_some(&task->executor, RCL_MS_TO_NS(1));
+
+        if (task->housekeeping)
+        {
+            MOTOROS2_TASK_TRACE_BEGIN(TASK_TRACE_TASK_EXECUTOR + task->id, TASK_TRACE_POINT_EXECUTOR_HOUSEKEEPING);
+            task->housekeeping();
+            MOTOROS2_TASK_TRACE_END(TASK_TRACE_TASK_EXECUTOR + task->id, TASK_TRACE_POINT_EXECUTOR_HOUSEKEEPING);
+        }
     }
-    Ros_Debug_BroadcastMsg("Terminating I/O Executor Task");
+    Ros_Debug_BroadcastMsg("Terminating '%s' Executor Task", communicationExecutor_names[task->id]);
 
     //notify parent task that this has finished
-    mpSemGive(semIoExecutorStatus);
+    mpSemGive(task->semStatus);
 
     mpDeleteSelf;
 }
@@ -302,95 +581,135 @@ void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus)
 {
     rcl_ret_t rc;
 
-    rcl_timer_t timerPingAgent = rcl_get_zero_initialized_timer();
     rcl_timer_t timerPublishActionFeedback = rcl_get_zero_initialized_timer();
     rcl_timer_t timerMonitorUserLanState = rcl_get_zero_initialized_timer();
+    rcl_timer_t timerReportCallbackStats = rcl_get_zero_initialized_timer();
+
+    const size_t numHandles[NUM_COMMUNICATION_EXECUTORS] =
+    {
+        QUANTITY_OF_HANDLES_FOR_STREAMING_EXECUTOR,
+        QUANTITY_OF_HANDLES_FOR_GOAL_EXECUTOR,
+        QUANTITY_OF_HANDLES_FOR_MODE_EXECUTOR,
+        QUANTITY_OF_HANDLES_FOR_IO_EXECUTOR,
+        QUANTITY_OF_HANDLES_FOR_DIAGNOSTICS_EXECUTOR,
+    };
+    const int createSubcodes[NUM_COMMUNICATION_EXECUTORS] =
+    {
+        SUBCODE_FAIL_CREATE_STREAMING_EXECUTOR,
+        SUBCODE_FAIL_CREATE_MOTION_EXECUTOR,
+        SUBCODE_FAIL_CREATE_MODE_EXECUTOR,
+        SUBCODE_FAIL_CREATE_IO_EXECUTOR,
+        SUBCODE_FAIL_CREATE_DIAGNOSTICS_EXECUTOR,
+    };
+
+    Communication_ExecutorTask tasks[NUM_COMMUNICATION_EXECUTORS];
+    rclc_executor_t* executor_streaming = &tasks[COMMUNICATION_EXECUTOR_STREAMING].executor;
+    rclc_executor_t* executor_goals = &tasks[COMMUNICATION_EXECUTOR_GOALS].executor;
+    rclc_executor_t* executor_mode_changes = &tasks[COMMUNICATION_EXECUTOR_MODE_CHANGES].executor;
+    rclc_executor_t* executor_io_control = &tasks[COMMUNICATION_EXECUTOR_IO].executor;
+    rclc_executor_t* executor_diagnostics = &tasks[COMMUNICATION_EXECUTOR_DIAGNOSTICS].executor;
 
     mpSemTake(semCommunicationExecutorStatus, NO_WAIT);
 
+    bzero(communicationExecutor_callbackStats, sizeof(communicationExecutor_callbackStats));
+
+    communicationExecutor_motionModeLock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+
     //---------------------------------
     //Create timers
-    rc = rclc_timer_init_default(&timerPingAgent, &g_microRosNodeInfo.support, RCL_MS_TO_NS(PERIOD_COMMUNICATION_PING_AGENT_MS), Ros_Communication_PingAgentConnection);
-    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_INIT_PING, "Failed creating rclc timer (%d)", (int)rc);
-
     rc = rclc_timer_init_default(&timerPublishActionFeedback, &g_microRosNodeInfo.support, RCL_MS_TO_NS(g_nodeConfigSettings.action_feedback_publisher_period), Ros_Communication_PublishActionFeedback);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_INIT_ACTION_FB, "Failed creating rclc timer (%d)", (int)rc);
 
     rc = rclc_timer_init_default(&timerMonitorUserLanState, &g_microRosNodeInfo.support,
         RCL_MS_TO_NS(PERIOD_COMMUNICATION_USERLAN_LINK_CHECK_MS),
-        Ros_Communication_MonitorUserLanState);
+        Ros_Communication_MonitorUserLanState_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_INIT_USERLAN_MONITOR,
         "Failed creating rclc timer (%d)", (int)rc);
 
+    rc = rclc_timer_init_default(&timerReportCallbackStats, &g_microRosNodeInfo.support,
+        RCL_MS_TO_NS(PERIOD_COMMUNICATION_CALLBACK_STATS_REPORT_MS),
+        Ros_Communication_ReportCallbackStatsTimer);
+    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_INIT_CALLBACK_STATS,
+        "Failed creating rclc timer (%d)", (int)rc);
+
     //---------------------------------
     //Create executors
-    rclc_executor_t executor_motion_control;
-    executor_motion_control = rclc_executor_get_zero_initialized_executor();
+    for (int i = 0; i < NUM_COMMUNICATION_EXECUTORS; i += 1)
+    {
+        tasks[i].id = (Communication_Executor)i;
+        tasks[i].sleepPeriod = (g_nodeConfigSettings.executor_periods[i] > 0) ?
+            g_nodeConfigSettings.executor_periods[i] : g_nodeConfigSettings.executor_sleep_period;
+        tasks[i].housekeeping = NULL;
+
+        tasks[i].executor = rclc_executor_get_zero_initialized_executor();
+        rc = rclc_executor_init(&tasks[i].executor, &g_microRosNodeInfo.support.context, numHandles[i], &g_motoros2_Allocator);
+        motoRosAssert_withMsg(rc == RCL_RET_OK, createSubcodes[i], "Failed creating %s executor (%d)", communicationExecutor_names[i], (int)rc);
+    }
 
-    rc = rclc_executor_init(&executor_motion_control, &g_microRosNodeInfo.support.context, QUANTITY_OF_HANDLES_FOR_MOTION_EXECUTOR, &g_motoros2_Allocator);
-    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_CREATE_MOTION_EXECUTOR, "Failed creating motion control executor (%d)", (int)rc);
+    //Checking the motion mode may stop it, so it's a mode change as well
+    tasks[COMMUNICATION_EXECUTOR_MODE_CHANGES].housekeeping = Ros_Communication_ValidateMotionModeIsOk;
 
-    rclc_executor_t executor_io_control;
-    executor_io_control = rclc_executor_get_zero_initialized_executor();
+    //==========================================================
+    //Add entities to streaming executor
+    //
+    // WARNING: Be sure to update QUANTITY_OF_HANDLES_FOR_STREAMING_EXECUTOR
+    //
+    rc = rclc_executor_add_service(
+        executor_streaming, &g_serviceQueueTrajPoint, g_messages_QueueTrajPoint.request,
+        g_messages_QueueTrajPoint.response, Ros_ServiceQueueTrajPoint_Trigger_Timed);
+    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_QUEUE_POINT, "Failed adding service (%d)", (int)rc);
 
-    rc = rclc_executor_init(&executor_io_control, &g_microRosNodeInfo.support.context, QUANTITY_OF_HANDLES_FOR_IO_EXECUTOR, &g_motoros2_Allocator);
-    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_CREATE_IO_EXECUTOR, "Failed creating I/O control executor (%d)", (int)rc);
+    rc = rclc_executor_add_subscription(
+        executor_streaming, &g_subscriberTwistServo, &g_messages_TwistServo.twistCommand,
+        Ros_TwistServo_CommandReceived_Timed, ON_NEW_DATA);
+    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SUBSCRIBER_TWIST_SERVO, "Failed adding subscriber (%d)", (int)rc);
 
     //==========================================================
-    //Add entities to motion executor
+    //Add entities to goal executor
     //
-    // WARNING: Be sure to update QUANTITY_OF_HANDLES_FOR_MOTION_EXECUTOR
+    // WARNING: Be sure to update QUANTITY_OF_HANDLES_FOR_GOAL_EXECUTOR
     //
-    rc = rclc_executor_add_timer(&executor_motion_control, &timerPingAgent);
-    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_ADD_PING, "Failed adding timer (%d)", (int)rc);
-
-    rc = rclc_executor_add_timer(&executor_motion_control, &timerPublishActionFeedback);
+    rc = rclc_executor_add_timer(executor_goals, &timerPublishActionFeedback);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_ADD_ACTION_FB, "Failed adding timer (%d)", (int)rc);
 
-    //NOTE: add userlan monitor timer to the io executor, to prevent timerPingAgent
-    //from blocking it in case agent connection is lost (ie: ping needs to time out)
-    rc = rclc_executor_add_timer(&executor_io_control, &timerMonitorUserLanState);
-    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_ADD_USERLAN_MONITOR,
-        "Failed adding timer (%d)", (int)rc);
-
-    rc = rclc_executor_add_action_server(&executor_motion_control,
+    rc = rclc_executor_add_action_server(executor_goals,
         &g_actionServerFollowJointTrajectory,
-        1,
-        &g_actionServer_FJT_SendGoal_Request,
+        FJT_NUMBER_OF_GOAL_HANDLES,
+        g_actionServer_FJT_SendGoal_Request,
         g_actionServer_FJT_SendGoal_Request__sizeof,
-        Ros_ActionServer_FJT_Goal_Received,
-        Ros_ActionServer_FJT_Goal_Cancel,
+        Ros_Communication_FJT_Goal_Received_Timed,
+        Ros_Communication_FJT_Goal_Cancel_Timed,
         &g_actionServerFollowJointTrajectory);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_FJT_SERVER, "Failed adding FJT server (%d)", (int)rc);
 
+    //==========================================================
+    //Add entities to mode change executor
+    //
+    // WARNING: Be sure to update QUANTITY_OF_HANDLES_FOR_MODE_EXECUTOR
+    //
     rc = rclc_executor_add_service(
-        &executor_motion_control, &g_serviceStopTrajMode, &g_messages_StopTrajMode.request,
-        &g_messages_StopTrajMode.response, Ros_ServiceStopTrajMode_Trigger);
+        executor_mode_changes, &g_serviceStopTrajMode, &g_messages_StopTrajMode.request,
+        &g_messages_StopTrajMode.response, Ros_ServiceStopTrajMode_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_STOP_TRAJ, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_motion_control, &g_serviceResetError, &g_messages_ResetError.request,
-        &g_messages_ResetError.response, Ros_ServiceResetError_Trigger);
+        executor_mode_changes, &g_serviceResetError, &g_messages_ResetError.request,
+        &g_messages_ResetError.response, Ros_ServiceResetError_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_RESET_ERROR, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_motion_control, &g_serviceStartTrajMode, &g_messages_StartTrajMode.request,
-        &g_messages_StartTrajMode.response, Ros_ServiceStartTrajMode_Trigger);
+        executor_mode_changes, &g_serviceStartTrajMode, &g_messages_StartTrajMode.request,
+        &g_messages_StartTrajMode.response, Ros_ServiceStartTrajMode_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_START_TRAJ_MODE, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_motion_control, &g_serviceStartPointQueueMode, &g_messages_StartPointQueueMode.request,
-        &g_messages_StartPointQueueMode.response, Ros_ServiceStartPointQueueMode_Trigger);
+        executor_mode_changes, &g_serviceStartPointQueueMode, &g_messages_StartPointQueueMode.request,
+        &g_messages_StartPointQueueMode.response, Ros_ServiceStartPointQueueMode_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_START_QUEUE_MODE, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_motion_control, &g_serviceQueueTrajPoint, g_messages_QueueTrajPoint.request,
-        g_messages_QueueTrajPoint.response, Ros_ServiceQueueTrajPoint_Trigger);
-    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_QUEUE_POINT, "Failed adding service (%d)", (int)rc);
-
-    rc = rclc_executor_add_service(
-        &executor_motion_control, &g_serviceSelectMotionTool, &g_messages_SelectMotionTool.request,
-        &g_messages_SelectMotionTool.response, Ros_ServiceSelectMotionTool_Trigger);
+        executor_mode_changes, &g_serviceSelectMotionTool, &g_messages_SelectMotionTool.request,
+        &g_messages_SelectMotionTool.response, Ros_ServiceSelectMotionTool_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_SELECT_MOTION_TOOL, "Failed adding service (%d)", (int)rc);
 
     //==========================================================
@@ -400,40 +719,58 @@ void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus)
     //
     // 
     rc = rclc_executor_add_service(
-        &executor_io_control, &g_serviceReadSingleIO, &g_messages_ReadWriteIO.req_single_io_read,
-        &g_messages_ReadWriteIO.resp_single_io_read, Ros_ServiceReadSingleIO_Trigger);
+        executor_io_control, &g_serviceReadSingleIO, &g_messages_ReadWriteIO.req_single_io_read,
+        &g_messages_ReadWriteIO.resp_single_io_read, Ros_ServiceReadSingleIO_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_READ_SINGLE_IO, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_io_control, &g_serviceReadGroupIO, &g_messages_ReadWriteIO.req_group_io_read,
-        &g_messages_ReadWriteIO.resp_group_io_read, Ros_ServiceReadGroupIO_Trigger);
+        executor_io_control, &g_serviceReadGroupIO, &g_messages_ReadWriteIO.req_group_io_read,
+        &g_messages_ReadWriteIO.resp_group_io_read, Ros_ServiceReadGroupIO_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_READ_GROUP_IO, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_io_control, &g_serviceWriteSingleIO, &g_messages_ReadWriteIO.req_single_io_write,
-        &g_messages_ReadWriteIO.resp_single_io_write, Ros_ServiceWriteSingleIO_Trigger);
+        executor_io_control, &g_serviceWriteSingleIO, &g_messages_ReadWriteIO.req_single_io_write,
+        &g_messages_ReadWriteIO.resp_single_io_write, Ros_ServiceWriteSingleIO_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_WRITE_SINGLE_IO, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_io_control, &g_serviceWriteGroupIO, &g_messages_ReadWriteIO.req_group_io_write,
-        &g_messages_ReadWriteIO.resp_group_io_write, Ros_ServiceWriteGroupIO_Trigger);
+        executor_io_control, &g_serviceWriteGroupIO, &g_messages_ReadWriteIO.req_group_io_write,
+        &g_messages_ReadWriteIO.resp_group_io_write, Ros_ServiceWriteGroupIO_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_WRITE_GROUP_IO, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_io_control, &g_serviceReadMRegister, &g_messages_ReadWriteIO.req_mreg_read,
-        &g_messages_ReadWriteIO.resp_mreg_read, Ros_ServiceReadMRegister_Trigger);
+        executor_io_control, &g_serviceReadMRegister, &g_messages_ReadWriteIO.req_mreg_read,
+        &g_messages_ReadWriteIO.resp_mreg_read, Ros_ServiceReadMRegister_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_READ_M_REG, "Failed adding service (%d)", (int)rc);
 
     rc = rclc_executor_add_service(
-        &executor_io_control, &g_serviceWriteMRegister, &g_messages_ReadWriteIO.req_mreg_write,
-        &g_messages_ReadWriteIO.resp_mreg_write, Ros_ServiceWriteMRegister_Trigger);
+        executor_io_control, &g_serviceWriteMRegister, &g_messages_ReadWriteIO.req_mreg_write,
+        &g_messages_ReadWriteIO.resp_mreg_write, Ros_ServiceWriteMRegister_Trigger_Timed);
     motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SERVICE_WRITE_M_REG, "Failed adding service (%d)", (int)rc);
 
+    //==========================================================
+    //Add entities to diagnostics executor
+    //
+    // WARNING: Be sure to update QUANTITY_OF_HANDLES_FOR_DIAGNOSTICS_EXECUTOR
+    //
+    rc = rclc_executor_add_timer(executor_diagnostics, &timerMonitorUserLanState);
+    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_ADD_USERLAN_MONITOR,
+        "Failed adding timer (%d)", (int)rc);
+
+    rc = rclc_executor_add_timer(executor_diagnostics, &timerReportCallbackStats);
+    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_TIMER_ADD_CALLBACK_STATS,
+        "Failed adding timer (%d)", (int)rc);
+
+    rc = rclc_executor_add_subscription(
+        executor_diagnostics, &g_subscriberLogLevel, &g_messages_LogLevel.command,
+        Ros_LogLevel_CommandReceived_Timed, ON_NEW_DATA);
+    motoRosAssert_withMsg(rc == RCL_RET_OK, SUBCODE_FAIL_ADD_SUBSCRIBER_LOG_LEVEL, "Failed adding subscriber (%d)", (int)rc);
+
     //===========================================================
 
     // Optional prepare for avoiding allocations during spin
-    rclc_executor_prepare(&executor_motion_control);
-    rclc_executor_prepare(&executor_io_control);
+    for (int i = 0; i < NUM_COMMUNICATION_EXECUTORS; i += 1)
+        rclc_executor_prepare(&tasks[i].executor);
 
     //===========================================================
     //===========================================================
@@ -452,26 +789,44 @@ void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus)
             g_nodeConfigSettings.userlan_monitor_port);
     }
 
-    // Start executor that runs the I/O executor
+    // Start a task for each of the executors
+    // (These tasks delete themselves when the agent disconnects.)
+    for (int i = 0; i < NUM_COMMUNICATION_EXECUTORS; i += 1)
+    {
+        Ros_Debug_BroadcastMsg("Starting '%s' executor (priority: %s, sleep period: %d ms)",
+            communicationExecutor_names[i],
+            Ros_ConfigFile_TaskPrioritySetting_ToString(g_nodeConfigSettings.executor_priorities[i]),
+            tasks[i].sleepPeriod);
+
+        tasks[i].semStatus = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
+        int tid = mpCreateTask(Ros_ConfigFile_To_Mp_Task_Priority(g_nodeConfigSettings.executor_priorities[i]), MP_STACK_SIZE,
+            (FUNCPTR)Ros_Communication_RunExecutor,
+            (int)&tasks[i], 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        if (tid == ERROR)
+            mpSetAlarm(ALARM_TASK_CREATE_FAIL, APPLICATION_NAME " FAILED TO CREATE TASK", SUBCODE_EXECUTOR);
+    }
+
+    // Start task that monitors the connection with the Agent
     // (This task deletes itself when the agent disconnects.)
-    SEM_ID semIoExecutorStatus = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+    SEM_ID semAgentMonitorStatus = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
     mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE,
-        (FUNCPTR)Ros_Communication_RunIoExecutor,
-        (int)&executor_io_control, (int)semIoExecutorStatus, 0, 0, 0, 0, 0, 0, 0, 0);
+        (FUNCPTR)Ros_Communication_RunAgentMonitor,
+        (int)semAgentMonitorStatus, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 
-    while (g_Ros_Communication_AgentIsConnected)
+    //wait for all executor tasks to finish before cleaning shared resources
+    for (int i = 0; i < NUM_COMMUNICATION_EXECUTORS; i += 1)
     {
-        Ros_Sleep(g_nodeConfigSettings.executor_sleep_period);
+        mpSemTake(tasks[i].semStatus, WAIT_FOREVER);
+        mpSemDelete(tasks[i].semStatus);
+    }
 
-        // timeout specified in nanoseconds
-        rclc_executor_spin_some(&executor_motion_control, RCL_MS_TO_NS(1));
+    //and for the Agent monitor, as a ping in progress still uses the session
+    mpSemTake(semAgentMonitorStatus, WAIT_FOREVER);
+    mpSemDelete(semAgentMonitorStatus);
 
-        Ros_MotionControl_ValidateMotionModeIsOk();
-    }
-    
-    //wait for Ros_Communication_RunIoExecutor task to finish before cleaning shared resources
-    mpSemTake(semIoExecutorStatus, WAIT_FOREVER);
-    mpSemDelete(semIoExecutorStatus);
+    mpSemDelete(communicationExecutor_motionModeLock);
+
+    Ros_Communication_ReportCallbackStats();
 
     //===========================================================
     //===========================================================
@@ -498,11 +853,16 @@ void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus)
         }
     }
 
-    Ros_Debug_BroadcastMsg("Cleanup motion control executor");
-    rclc_executor_fini(&executor_motion_control);
+    for (int i = 0; i < NUM_COMMUNICATION_EXECUTORS; i += 1)
+    {
+        Ros_Debug_BroadcastMsg("Cleanup %s executor", communicationExecutor_names[i]);
+        rclc_executor_fini(&tasks[i].executor);
+    }
 
-    Ros_Debug_BroadcastMsg("Cleanup I/O control executor");
-    rclc_executor_fini(&executor_io_control);
+    Ros_Debug_BroadcastMsg("Cleanup timer for executor statistics");
+    rc = rcl_timer_fini(&timerReportCallbackStats);
+    if (rc != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up executor statistics timer: %d", rc);
 
     Ros_Debug_BroadcastMsg("Cleanup timer for UserLan link state monitor");
     rc = rcl_timer_fini(&timerMonitorUserLanState);
@@ -514,11 +874,6 @@ void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus)
     if (rc != RCL_RET_OK)
         Ros_Debug_BroadcastMsg("Failed cleaning up action feedback timer: %d", rc);
 
-    Ros_Debug_BroadcastMsg("Cleanup timer for ping");
-    rc = rcl_timer_fini(&timerPingAgent);
-    if (rc != RCL_RET_OK)
-        Ros_Debug_BroadcastMsg("Failed cleaning up ping timer: %d", rc);
-
     //notify main task that this has finished
     mpSemGive(semCommunicationExecutorStatus);
 
@@ -9,24 +9,57 @@
 #define MOTOROS2_COMMUNICATION_EXECUTOR_H
 
 #define PERIOD_COMMUNICATION_PING_AGENT_MS                  5000
+#define PERIOD_COMMUNICATION_AGENT_MONITOR_POLL_MS          100
+
+#define AGENT_PING_TIMEOUT_MS                               1000
+#define AGENT_PING_ATTEMPTS                                 3
+
+//number of (single attempt) pings per 'agent_heartbeat_timeout' period
+#define AGENT_HEARTBEAT_PINGS_PER_TIMEOUT                   4
 
 #define PERIOD_COMMUNICATION_USERLAN_LINK_CHECK_MS          500
 
+#define PERIOD_COMMUNICATION_CALLBACK_STATS_REPORT_MS       60000
+
+//The executors, grouped by the latency their callbacks need. Each runs in its own
+//task, so a slow callback (fi: start_traj_mode) can't delay the others.
+typedef enum
+{
+    COMMUNICATION_EXECUTOR_STREAMING = 0,   //queue_traj_point, twist commands
+    COMMUNICATION_EXECUTOR_GOALS,           //FJT goals, cancellation, feedback and results
+    COMMUNICATION_EXECUTOR_MODE_CHANGES,    //start/stop motion modes, reset errors, select tool
+    COMMUNICATION_EXECUTOR_IO,              //I/O and M-register services
+    COMMUNICATION_EXECUTOR_DIAGNOSTICS,     //UserLan link monitor, callback statistics
+
+    NUM_COMMUNICATION_EXECUTORS
+} Communication_Executor;
+
 // total number of handles =
-//      timers +                                            2
+//      service queue_traj_point                            1
+//      subscriber twist_servo                              1
+#define QUANTITY_OF_HANDLES_FOR_STREAMING_EXECUTOR          (2)
+
+// total number of handles =
+//      timers +                                            1
 //      action_server +                                     1
+#define QUANTITY_OF_HANDLES_FOR_GOAL_EXECUTOR               (2)
+
+// total number of handles =
 //      service reset                                       1
 //      service start_traj_mode                             1
 //      service start_point_queue_mode                      1
 //      service stop_traj_mode                              1
-//      service queue_traj_point                            1
 //      service select_tool                                 1
-#define QUANTITY_OF_HANDLES_FOR_MOTION_EXECUTOR             (9)
+#define QUANTITY_OF_HANDLES_FOR_MODE_EXECUTOR               (5)
 
 // total number of handles =
-//      timers +                                            1
 //      service read & write I/O +                          6
-#define QUANTITY_OF_HANDLES_FOR_IO_EXECUTOR                 (7)
+#define QUANTITY_OF_HANDLES_FOR_IO_EXECUTOR                 (6)
+
+// total number of handles =
+//      timers +                                            2
+//      subscriber set_log_level                            1
+#define QUANTITY_OF_HANDLES_FOR_DIAGNOSTICS_EXECUTOR        (3)
 
 typedef struct
 {
@@ -36,11 +69,20 @@ typedef struct
 } Communication_NodeInfo;
 extern Communication_NodeInfo g_microRosNodeInfo;
 
-extern BOOL g_Ros_Communication_AgentIsConnected;
+extern volatile BOOL g_Ros_Communication_AgentIsConnected;
 
 extern void Ros_Communication_ConnectToAgent();
 extern void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus);
 
+//Record a sign of life of the Agent, for the heartbeat (see 'agent_heartbeat_timeout').
+//Call this from callbacks which handle incoming traffic.
+extern void Ros_Communication_NotifyAgentActivity();
+
+//Serializes changes of the motion mode with the callbacks which depend on it. Only hold it
+//while the motion mode state is accessed: never while waiting for the controller.
+extern void Ros_Communication_LockMotionMode();
+extern void Ros_Communication_UnlockMotionMode();
+
 extern void Ros_Communication_Initialize();
 extern void Ros_Communication_Cleanup();
 
@@ -0,0 +1,146 @@
+//CompactJointState.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+CompactJointState_Publishers g_publishers_CompactJointState;
+CompactJointState_Messages g_messages_CompactJointState;
+
+static UINT32 compactJointState_sequence = 0;
+
+//The joint names are only published once, together with the first compact message
+static BOOL compactJointState_bJointNamesPublished = FALSE;
+
+void Ros_CompactJointState_Initialize()
+{
+    int numJoints = g_Ros_Controller.totalAxesCount;
+    rcl_ret_t ret;
+
+    if (!g_nodeConfigSettings.publish_compact_joint_states)
+        return;
+
+    MOTOROS2_MEM_TRACE_START(compact_js_init);
+
+    Ros_Debug_BroadcastMsg("Initializing compact joint state publishers");
+
+    //==================================
+    //create the publisher for the compact joint states, using the same QoS as 'joint_states'
+    ret = rclc_publisher_init(
+        &g_publishers_CompactJointState.jointStates,
+        &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32MultiArray),
+        TOPIC_NAME_JOINT_STATES_COMPACT,
+        Ros_ConfigFile_To_Rmw_Qos_Profile(g_nodeConfigSettings.qos_joint_states));
+    motoRosAssert_withMsg(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_COMPACT_JOINT_STATES, "Failed to init publisher (%d)", (int)ret);
+
+    //The joint order is published once, so late-joining subscribers must receive the last message
+    //(same QoS as tf2 uses for static transforms)
+    rmw_qos_profile_t qos_profile_names = rmw_qos_profile_default;
+    qos_profile_names.depth = 1;
+    qos_profile_names.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos_profile_names.durability = RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+
+    ret = rclc_publisher_init(
+        &g_publishers_CompactJointState.jointNames,
+        &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, JointState),
+        TOPIC_NAME_JOINT_STATES_COMPACT_JOINT_NAMES,
+        &qos_profile_names);
+    motoRosAssert_withMsg(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_COMPACT_JOINT_STATES, "Failed to init publisher (%d)", (int)ret);
+
+    //==================================
+    //header, plus position, velocity and effort of each joint. The layout is left empty,
+    //as it would otherwise add a label string to every message.
+    g_messages_CompactJointState.jointStates = std_msgs__msg__Int32MultiArray__create();
+    rosidl_runtime_c__int32__Sequence__init(&g_messages_CompactJointState.jointStates->data,
+        COMPACT_JOINT_STATE_HEADER_LENGTH + (numJoints * 3));
+
+    //copy the joint names (and so the order) from the /joint_states message
+    g_messages_CompactJointState.jointNames = sensor_msgs__msg__JointState__create();
+    rosidl_runtime_c__String__Sequence__init(&g_messages_CompactJointState.jointNames->name, numJoints);
+    for (int i = 0; i < numJoints; i += 1)
+    {
+        rosidl_runtime_c__String__assign(&g_messages_CompactJointState.jointNames->name.data[i],
+            g_messages_PositionMonitor.jointStateAllGroups->name.data[i].data);
+    }
+
+    compactJointState_sequence = 0;
+    compactJointState_bJointNamesPublished = FALSE;
+
+    MOTOROS2_MEM_TRACE_REPORT(compact_js_init);
+}
+
+void Ros_CompactJointState_Cleanup()
+{
+    rcl_ret_t ret;
+
+    if (!g_nodeConfigSettings.publish_compact_joint_states)
+        return;
+
+    MOTOROS2_MEM_TRACE_START(compact_js_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup compact joint state publishers");
+    ret = rcl_publisher_fini(&g_publishers_CompactJointState.jointStates, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up " TOPIC_NAME_JOINT_STATES_COMPACT " publisher: %d", ret);
+    ret = rcl_publisher_fini(&g_publishers_CompactJointState.jointNames, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up " TOPIC_NAME_JOINT_STATES_COMPACT_JOINT_NAMES " publisher: %d", ret);
+
+    std_msgs__msg__Int32MultiArray__destroy(g_messages_CompactJointState.jointStates);
+    sensor_msgs__msg__JointState__destroy(g_messages_CompactJointState.jointNames);
+
+    MOTOROS2_MEM_TRACE_REPORT(compact_js_fini);
+}
+
+//Round 'value' to the nearest multiple of 1/scale, saturating at the limits of an INT32
+static INT32 Ros_CompactJointState_ToFixedPoint(double value, double scale)
+{
+    double scaled = floor((value * scale) + 0.5);
+
+    if (scaled > INT_MAX)
+        return INT_MAX;
+    if (scaled < INT_MIN)
+        return INT_MIN;
+    return (INT32)scaled;
+}
+
+void Ros_CompactJointState_Publish(sensor_msgs__msg__JointState const* jointStates)
+{
+    std_msgs__msg__Int32MultiArray* msg = g_messages_CompactJointState.jointStates;
+    int numJoints = jointStates->position.size;
+    INT32* header = &msg->data.data[0];
+    INT32* positions = &msg->data.data[COMPACT_JOINT_STATE_HEADER_LENGTH];
+    INT32* velocities = &positions[numJoints];
+    INT32* efforts = &velocities[numJoints];
+    rcl_ret_t ret;
+
+    if (!compactJointState_bJointNamesPublished)
+    {
+        g_messages_CompactJointState.jointNames->header.stamp = jointStates->header.stamp;
+        ret = rcl_publish(&g_publishers_CompactJointState.jointNames, g_messages_CompactJointState.jointNames, NULL);
+        compactJointState_bJointNamesPublished = (ret == RCL_RET_OK);
+    }
+
+    compactJointState_sequence += 1;
+    header[COMPACT_JOINT_STATE_IDX_SEQUENCE] = (INT32)compactJointState_sequence;
+    header[COMPACT_JOINT_STATE_IDX_STAMP_SEC] = jointStates->header.stamp.sec;
+    header[COMPACT_JOINT_STATE_IDX_STAMP_NANOSEC] = (INT32)jointStates->header.stamp.nanosec;
+
+    for (int i = 0; i < numJoints; i += 1)
+    {
+        positions[i] = Ros_CompactJointState_ToFixedPoint(jointStates->position.data[i], COMPACT_JOINT_STATE_POSITION_SCALE);
+        velocities[i] = Ros_CompactJointState_ToFixedPoint(jointStates->velocity.data[i], COMPACT_JOINT_STATE_VELOCITY_SCALE);
+        efforts[i] = Ros_CompactJointState_ToFixedPoint(jointStates->effort.data[i], COMPACT_JOINT_STATE_EFFORT_SCALE);
+    }
+    msg->data.size = COMPACT_JOINT_STATE_HEADER_LENGTH + (numJoints * 3);
+
+    ret = rcl_publish(&g_publishers_CompactJointState.jointStates, msg, NULL);
+    // publishing can fail, but we choose to ignore those errors in this implementation
+    RCL_UNUSED(ret);
+    Ros_IdlePublishing_CountPublished(IDLE_PUBLISHING_TOPIC_JOINT_STATES, ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32MultiArray), msg);
+}
@@ -0,0 +1,54 @@
+//CompactJointState.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_COMPACT_JOINT_STATE_H
+#define MOTOROS2_COMPACT_JOINT_STATE_H
+
+//Layout of the 'data' field of a compact joint state message (std_msgs/Int32MultiArray),
+//for N joints (in the order announced on TOPIC_NAME_JOINT_STATES_COMPACT_JOINT_NAMES):
+//
+//  [0]                     sequence number (incremented for every message)
+//  [1]                     stamp: seconds
+//  [2]                     stamp: nanoseconds
+//  [3 .. 3+N)              positions, in COMPACT_JOINT_STATE_POSITION_SCALE units
+//  [3+N .. 3+2N)           velocities, in COMPACT_JOINT_STATE_VELOCITY_SCALE units
+//  [3+2N .. 3+3N)          efforts, in COMPACT_JOINT_STATE_EFFORT_SCALE units
+typedef enum
+{
+    COMPACT_JOINT_STATE_IDX_SEQUENCE = 0,
+    COMPACT_JOINT_STATE_IDX_STAMP_SEC,
+    COMPACT_JOINT_STATE_IDX_STAMP_NANOSEC,
+
+    COMPACT_JOINT_STATE_HEADER_LENGTH
+} CompactJointState_HeaderIndex;
+
+#define COMPACT_JOINT_STATE_POSITION_SCALE  1000000.0   // 1 = 1 microradian or micrometre
+#define COMPACT_JOINT_STATE_VELOCITY_SCALE  1000000.0   // 1 = 1 microradian/s or micrometre/s
+#define COMPACT_JOINT_STATE_EFFORT_SCALE    1000.0      // 1 = 1 mNm or mN
+
+typedef struct
+{
+    rcl_publisher_t jointStates;
+    rcl_publisher_t jointNames;
+} CompactJointState_Publishers;
+extern CompactJointState_Publishers g_publishers_CompactJointState;
+
+typedef struct
+{
+    std_msgs__msg__Int32MultiArray* jointStates;
+    sensor_msgs__msg__JointState* jointNames;   // names only
+} CompactJointState_Messages;
+extern CompactJointState_Messages g_messages_CompactJointState;
+
+//Does nothing if 'publish_compact_joint_states' is not enabled
+extern void Ros_CompactJointState_Initialize();
+extern void Ros_CompactJointState_Cleanup();
+
+//Publish the aggregate joint state of all groups ('jointStates') in the compact format
+extern void Ros_CompactJointState_Publish(sensor_msgs__msg__JointState const* jointStates);
+
+#endif  // MOTOROS2_COMPACT_JOINT_STATE_H
@@ -86,6 +86,8 @@ typedef enum
     Value_JointNameArray,
     Value_Qos,
     Value_UserLanPort,
+    Value_TaskPriority,
+    Value_LogLevel,
 } Value_Type;
 
 typedef struct
@@ -104,18 +106,56 @@ Configuration_Item Ros_ConfigFile_Items[] =
     { "agent_ip_address", g_nodeConfigSettings.agent_ip_address, Value_String },
     { "agent_port_number", g_nodeConfigSettings.agent_port_number, Value_String },
     { "sync_timeclock_with_agent", &g_nodeConfigSettings.sync_timeclock_with_agent, Value_Bool },
+    { "scheduled_start_horizon", &g_nodeConfigSettings.scheduled_start_horizon, Value_Int },
     { "namespace_tf", &g_nodeConfigSettings.namespace_tf, Value_Bool },
     { "publish_tf", &g_nodeConfigSettings.publish_tf, Value_Bool },
+    { "publish_group_joint_states", &g_nodeConfigSettings.publish_group_joint_states, Value_Bool },
+    { "publish_joint_command_states", &g_nodeConfigSettings.publish_joint_command_states, Value_Bool },
+    { "publish_compact_joint_states", &g_nodeConfigSettings.publish_compact_joint_states, Value_Bool },
     { "joint_names", &joint_names_iterator, Value_JointNameArray },
     { "log_to_stdout", &g_nodeConfigSettings.log_to_stdout, Value_Bool },
+    { "log_level", &g_nodeConfigSettings.log_level, Value_LogLevel },
+    { "log_rate_limit", &g_nodeConfigSettings.log_rate_limit, Value_Int },
+    { "log_telemetry", &g_nodeConfigSettings.log_telemetry, Value_Bool },
+    { "general_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_GENERAL], Value_LogLevel },
+    { "communication_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_COMMUNICATION], Value_LogLevel },
+    { "config_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_CONFIG], Value_LogLevel },
+    { "controller_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_CONTROLLER], Value_LogLevel },
+    { "motion_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_MOTION], Value_LogLevel },
+    { "fjt_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_FJT], Value_LogLevel },
+    { "publishers_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_PUBLISHERS], Value_LogLevel },
+    { "io_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_IO], Value_LogLevel },
+    { "tests_log_level", &g_nodeConfigSettings.module_log_levels[DEBUG_MODULE_TESTS], Value_LogLevel },
     { "executor_sleep_period", &g_nodeConfigSettings.executor_sleep_period, Value_Int },
+    { "streaming_executor_period", &g_nodeConfigSettings.executor_periods[COMMUNICATION_EXECUTOR_STREAMING], Value_Int },
+    { "goal_executor_period", &g_nodeConfigSettings.executor_periods[COMMUNICATION_EXECUTOR_GOALS], Value_Int },
+    { "mode_executor_period", &g_nodeConfigSettings.executor_periods[COMMUNICATION_EXECUTOR_MODE_CHANGES], Value_Int },
+    { "io_executor_period", &g_nodeConfigSettings.executor_periods[COMMUNICATION_EXECUTOR_IO], Value_Int },
+    { "diagnostics_executor_period", &g_nodeConfigSettings.executor_periods[COMMUNICATION_EXECUTOR_DIAGNOSTICS], Value_Int },
+    { "streaming_executor_priority", &g_nodeConfigSettings.executor_priorities[COMMUNICATION_EXECUTOR_STREAMING], Value_TaskPriority },
+    { "goal_executor_priority", &g_nodeConfigSettings.executor_priorities[COMMUNICATION_EXECUTOR_GOALS], Value_TaskPriority },
+    { "mode_executor_priority", &g_nodeConfigSettings.executor_priorities[COMMUNICATION_EXECUTOR_MODE_CHANGES], Value_TaskPriority },
+    { "io_executor_priority", &g_nodeConfigSettings.executor_priorities[COMMUNICATION_EXECUTOR_IO], Value_TaskPriority },
+    { "diagnostics_executor_priority", &g_nodeConfigSettings.executor_priorities[COMMUNICATION_EXECUTOR_DIAGNOSTICS], Value_TaskPriority },
     { "action_feedback_publisher_period", &g_nodeConfigSettings.action_feedback_publisher_period, Value_Int },
     { "controller_status_monitor_period", &g_nodeConfigSettings.controller_status_monitor_period, Value_Int },
+    { "joint_states_publish_period", &g_nodeConfigSettings.joint_states_publish_period, Value_Int },
+    { "group_joint_states_publish_period", &g_nodeConfigSettings.group_joint_states_publish_period, Value_Int },
+    { "joint_command_states_publish_period", &g_nodeConfigSettings.joint_command_states_publish_period, Value_Int },
+    { "tf_publish_period", &g_nodeConfigSettings.tf_publish_period, Value_Int },
+    { "robot_status_publish_period", &g_nodeConfigSettings.robot_status_publish_period, Value_Int },
+    { "idle_keepalive_period", &g_nodeConfigSettings.idle_keepalive_period, Value_Int },
+    { "idle_change_threshold", &g_nodeConfigSettings.idle_change_threshold, Value_Int },
+    { "joint_states_batch_size", &g_nodeConfigSettings.joint_states_batch_size, Value_Int },
+    { "joint_states_batch_speed_torque", &g_nodeConfigSettings.joint_states_batch_speed_torque, Value_Bool },
     { "robot_status", &g_nodeConfigSettings.qos_robot_status, Value_Qos },
     { "joint_states", &g_nodeConfigSettings.qos_joint_states, Value_Qos },
     { "tf", &g_nodeConfigSettings.qos_tf, Value_Qos },
     { "tf_frame_prefix", &g_nodeConfigSettings.tf_frame_prefix, Value_String },
     { "stop_motion_on_disconnect", &g_nodeConfigSettings.stop_motion_on_disconnect, Value_Bool },
+    { "agent_heartbeat_timeout", &g_nodeConfigSettings.agent_heartbeat_timeout, Value_Int },
+    { "max_cartesian_linear_speed", &g_nodeConfigSettings.max_cartesian_linear_speed, Value_Int },
+    { "max_cartesian_angular_speed", &g_nodeConfigSettings.max_cartesian_angular_speed, Value_Int },
     { "inform_job_name", &g_nodeConfigSettings.inform_job_name, Value_String },
     { "allow_custom_inform_job", &g_nodeConfigSettings.allow_custom_inform_job, Value_Bool },
     { "userlan_monitor_enabled", &g_nodeConfigSettings.userlan_monitor_enabled, Value_Bool },
@@ -177,10 +217,26 @@ void Ros_ConfigFile_SetAllDefaultValues()
     //sync_timeclock_with_agent
     g_nodeConfigSettings.sync_timeclock_with_agent = DEFAULT_SYNCTIME;
 
+    //=========
+    //scheduled_start_horizon
+    g_nodeConfigSettings.scheduled_start_horizon = DEFAULT_SCHEDULED_START_HORIZON;
+
     //=========
     //publish_tf
     g_nodeConfigSettings.publish_tf = DEFAULT_PUBLISH_TF;
 
+    //=========
+    //publish_group_joint_states
+    g_nodeConfigSettings.publish_group_joint_states = DEFAULT_PUBLISH_GROUP_JOINT_STATES;
+
+    //=========
+    //publish_joint_command_states
+    g_nodeConfigSettings.publish_joint_command_states = DEFAULT_PUBLISH_JOINT_COMMAND_STATES;
+
+    //=========
+    //publish_compact_joint_states
+    g_nodeConfigSettings.publish_compact_joint_states = DEFAULT_PUBLISH_COMPACT_JOINT_STATES;
+
     //=========
     //namespace_tf
     g_nodeConfigSettings.namespace_tf = DEFAULT_NAMESPACE_TF;
@@ -196,10 +252,29 @@ void Ros_ConfigFile_SetAllDefaultValues()
     //log_to_stdout
     g_nodeConfigSettings.log_to_stdout = DEFAULT_LOG_TO_STDOUT;
 
+    //=========
+    //log_level, *_log_level and log_rate_limit
+    g_nodeConfigSettings.log_level = DEFAULT_LOG_LEVEL;
+    for (int i = 0; i < NUM_DEBUG_MODULES; i += 1)
+        g_nodeConfigSettings.module_log_levels[i] = CFG_LOG_LEVEL_DEFAULT;
+    g_nodeConfigSettings.log_rate_limit = DEFAULT_LOG_RATE_LIMIT;
+
+    //=========
+    //log_telemetry
+    g_nodeConfigSettings.log_telemetry = DEFAULT_LOG_TELEMETRY;
+
     //=========
     //executor_sleep_period
     g_nodeConfigSettings.executor_sleep_period = DEFAULT_EXECUTOR_SLEEP_PERIOD;
 
+    //=========
+    //*_executor_period and *_executor_priority
+    for (int i = 0; i < NUM_COMMUNICATION_EXECUTORS; i += 1)
+    {
+        g_nodeConfigSettings.executor_periods[i] = DEFAULT_EXECUTOR_PERIOD;
+        g_nodeConfigSettings.executor_priorities[i] = DEFAULT_EXECUTOR_PRIORITY;
+    }
+
     //=========
     //feedback_publisher_period
     g_nodeConfigSettings.action_feedback_publisher_period = DEFAULT_FEEDBACK_PUBLISH_PERIOD;
@@ -208,6 +283,30 @@ void Ros_ConfigFile_SetAllDefaultValues()
     //controller_status_monitor_period
     g_nodeConfigSettings.controller_status_monitor_period = DEFAULT_CONTROLLER_IO_PERIOD;
 
+    //=========
+    //*_publish_period
+    g_nodeConfigSettings.joint_states_publish_period = DEFAULT_PUBLISH_PERIOD;
+    g_nodeConfigSettings.group_joint_states_publish_period = DEFAULT_PUBLISH_PERIOD;
+    g_nodeConfigSettings.joint_command_states_publish_period = DEFAULT_PUBLISH_PERIOD;
+    g_nodeConfigSettings.tf_publish_period = DEFAULT_PUBLISH_PERIOD;
+    g_nodeConfigSettings.robot_status_publish_period = DEFAULT_PUBLISH_PERIOD;
+
+    //=========
+    //idle_keepalive_period
+    g_nodeConfigSettings.idle_keepalive_period = DEFAULT_IDLE_KEEPALIVE_PERIOD;
+
+    //=========
+    //idle_change_threshold
+    g_nodeConfigSettings.idle_change_threshold = DEFAULT_IDLE_CHANGE_THRESHOLD;
+
+    //=========
+    //joint_states_batch_size
+    g_nodeConfigSettings.joint_states_batch_size = DEFAULT_JOINT_STATES_BATCH_SIZE;
+
+    //=========
+    //joint_states_batch_speed_torque
+    g_nodeConfigSettings.joint_states_batch_speed_torque = DEFAULT_JOINT_STATES_BATCH_SPEED_TORQUE;
+
     //=========
     //qos_robot_status
     g_nodeConfigSettings.qos_robot_status = DEFAULT_QOS_ROBOT_STATUS;
@@ -228,6 +327,15 @@ void Ros_ConfigFile_SetAllDefaultValues()
     //stop_motion_on_disconnect
     g_nodeConfigSettings.stop_motion_on_disconnect = DEFAULT_STOP_MOTION_ON_DISCON;
 
+    //=========
+    //agent_heartbeat_timeout
+    g_nodeConfigSettings.agent_heartbeat_timeout = DEFAULT_AGENT_HEARTBEAT_TIMEOUT;
+
+    //=========
+    //max_cartesian_linear_speed and max_cartesian_angular_speed
+    g_nodeConfigSettings.max_cartesian_linear_speed = DEFAULT_MAX_CARTESIAN_LINEAR_SPEED;
+    g_nodeConfigSettings.max_cartesian_angular_speed = DEFAULT_MAX_CARTESIAN_ANGULAR_SPEED;
+
     //=========
     //inform_job_name
     snprintf(g_nodeConfigSettings.inform_job_name, MAX_JOB_NAME_LEN, "%s", DEFAULT_INFORM_JOB_NAME);
@@ -324,6 +432,51 @@ void Ros_ConfigFile_CheckYamlEvent(yaml_event_t* event)
                     }
                     break;
 
+                case Value_TaskPriority:
+                    if (strcmp((char*)event->data.scalar.value, CFG_TASK_PRIORITY_NORMAL_NAME) == 0)
+                        *(Ros_Task_Priority_Setting*)activeItem->valueToSet = CFG_TASK_PRIORITY_NORMAL;
+                    else if (strcmp((char*)event->data.scalar.value, CFG_TASK_PRIORITY_HIGH_NAME) == 0)
+                        *(Ros_Task_Priority_Setting*)activeItem->valueToSet = CFG_TASK_PRIORITY_HIGH;
+                    else
+                    {
+                        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid task priority", SUBCODE_CONFIGURATION_INVALID_TASK_PRIORITY);
+
+                        *(Ros_Task_Priority_Setting*)activeItem->valueToSet = DEFAULT_EXECUTOR_PRIORITY;
+                        Ros_Debug_BroadcastMsg(
+                            "Falling back to '%s' priority for '%s': unrecognised priority: '%s'",
+                            CFG_TASK_PRIORITY_NORMAL_NAME,
+                            (char*)activeItem->yamlKey,
+                            (char*)event->data.scalar.value);
+                    }
+                    break;
+
+                case Value_LogLevel:
+                {
+                    int level = -2;
+
+                    if (strcmp((char*)event->data.scalar.value, CFG_LOG_LEVEL_DEFAULT_NAME) == 0)
+                        level = CFG_LOG_LEVEL_DEFAULT;
+                    for (int i = 0; i < NUM_DEBUG_LEVELS; i += 1)
+                    {
+                        if (strcmp((char*)event->data.scalar.value, Ros_Debug_LevelToString((Debug_Level)i)) == 0)
+                            level = i;
+                    }
+
+                    if (level == -2)
+                    {
+                        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid log level", SUBCODE_CONFIGURATION_INVALID_LOG_LEVEL);
+
+                        level = CFG_LOG_LEVEL_DEFAULT;
+                        Ros_Debug_BroadcastMsg(
+                            "Falling back to '%s' for '%s': unrecognised log level: '%s'",
+                            CFG_LOG_LEVEL_DEFAULT_NAME,
+                            (char*)activeItem->yamlKey,
+                            (char*)event->data.scalar.value);
+                    }
+                    *(int*)activeItem->valueToSet = level;
+                    break;
+                }
+
                 case Value_UserLanPort:
 #if defined (FS100) || defined (DX200)
                     // single port, override whatever was configured
@@ -411,7 +564,7 @@ void Ros_ConfigFile_CheckUsbForNewConfigFile()
     {
         //No point in alarming. There's nothing the user can do about it. But, they can still load
         //the file through the pendant.
-        Ros_Debug_BroadcastMsg("ERROR: Path to config file on USB exceeds maximum. Config file must be loaded through the pendant menu.");
+        Ros_Debug_BroadcastErrorMsg("Path to config file on USB exceeds maximum. Config file must be loaded through the pendant menu.");
         return;
     }
 
@@ -421,7 +574,7 @@ void Ros_ConfigFile_CheckUsbForNewConfigFile()
     if (ret < 0 || ret >= MAX_PATH_LEN)
     {
         //No point in alarming. There's nothing the user can do about it. It'll just be truncated on the rename.
-        Ros_Debug_BroadcastMsg("WARNING: Config file will be renamed with a timestamp. The timestamp will be truncated due to the length.");
+        Ros_Debug_BroadcastWarningMsg("Config file will be renamed with a timestamp. The timestamp will be truncated due to the length.");
     }
 
     ret = snprintf(sramFilePath, MAX_PATH_LEN, "%s\\%s", MP_SRAM_DEV_DOS, CONFIG_FILE_NAME);
@@ -429,7 +582,7 @@ void Ros_ConfigFile_CheckUsbForNewConfigFile()
     {
         //No point in alarming. There's nothing the user can do about it. But, they can still load
         //the file through the pendant.
-        Ros_Debug_BroadcastMsg("ERROR: Path to config file on SRAM exceeds maximum. Config file must be loaded through the pendant menu.");
+        Ros_Debug_BroadcastErrorMsg("Path to config file on SRAM exceeds maximum. Config file must be loaded through the pendant menu.");
         return;
     }
 
@@ -600,6 +753,39 @@ void Ros_ConfigFile_ValidateNonCriticalSettings()
         g_nodeConfigSettings.executor_sleep_period = DEFAULT_EXECUTOR_SLEEP_PERIOD;
     }
 
+    //-----------------------------------------------------------------------------
+    //'default' is only meaningful for the per-module thresholds
+    if (g_nodeConfigSettings.log_level == CFG_LOG_LEVEL_DEFAULT)
+        g_nodeConfigSettings.log_level = DEFAULT_LOG_LEVEL;
+
+    if (g_nodeConfigSettings.log_rate_limit < MIN_LOG_RATE_LIMIT ||
+        g_nodeConfigSettings.log_rate_limit > MAX_LOG_RATE_LIMIT)
+    {
+        Ros_Debug_BroadcastMsg("log_rate_limit value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.log_rate_limit, DEFAULT_LOG_RATE_LIMIT);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid log_rate_limit", SUBCODE_CONFIGURATION_INVALID_LOG_RATE_LIMIT);
+
+        g_nodeConfigSettings.log_rate_limit = DEFAULT_LOG_RATE_LIMIT;
+    }
+
+    //-----------------------------------------------------------------------------
+    //0 means: use executor_sleep_period
+    for (int i = 0; i < NUM_COMMUNICATION_EXECUTORS; i += 1)
+    {
+        if (g_nodeConfigSettings.executor_periods[i] != 0 &&
+            (g_nodeConfigSettings.executor_periods[i] < MIN_EXECUTOR_SLEEP_PERIOD ||
+             g_nodeConfigSettings.executor_periods[i] > MAX_EXECUTOR_SLEEP_PERIOD))
+        {
+            Ros_Debug_BroadcastMsg("*_executor_period value %d (executor %d) is invalid; reverting to default of %d",
+                g_nodeConfigSettings.executor_periods[i], i, DEFAULT_EXECUTOR_PERIOD);
+
+            mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid *_executor_period", SUBCODE_CONFIGURATION_INVALID_EXECUTOR_PERIOD);
+
+            g_nodeConfigSettings.executor_periods[i] = DEFAULT_EXECUTOR_PERIOD;
+        }
+    }
+
     //-----------------------------------------------------------------------------
     if (g_nodeConfigSettings.action_feedback_publisher_period < MIN_FEEDBACK_PUBLISH_PERIOD ||
         g_nodeConfigSettings.action_feedback_publisher_period > MAX_FEEDBACK_PUBLISH_PERIOD)
@@ -624,6 +810,117 @@ void Ros_ConfigFile_ValidateNonCriticalSettings()
         g_nodeConfigSettings.controller_status_monitor_period = DEFAULT_CONTROLLER_IO_PERIOD;
     }
 
+    //-----------------------------------------------------------------------------
+    struct
+    {
+        const char* name;
+        int* value;
+    } const publishPeriods[] =
+    {
+        { "joint_states_publish_period", &g_nodeConfigSettings.joint_states_publish_period },
+        { "group_joint_states_publish_period", &g_nodeConfigSettings.group_joint_states_publish_period },
+        { "joint_command_states_publish_period", &g_nodeConfigSettings.joint_command_states_publish_period },
+        { "tf_publish_period", &g_nodeConfigSettings.tf_publish_period },
+        { "robot_status_publish_period", &g_nodeConfigSettings.robot_status_publish_period },
+    };
+    for (int i = 0; i < sizeof(publishPeriods) / sizeof(publishPeriods[0]); i += 1)
+    {
+        if (*publishPeriods[i].value < MIN_PUBLISH_PERIOD || *publishPeriods[i].value > MAX_PUBLISH_PERIOD)
+        {
+            Ros_Debug_BroadcastMsg("%s value %d is invalid; reverting to default of %d",
+                publishPeriods[i].name, *publishPeriods[i].value, DEFAULT_PUBLISH_PERIOD);
+
+            mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid *_publish_period", SUBCODE_CONFIGURATION_INVALID_PUBLISH_PERIOD);
+
+            *publishPeriods[i].value = DEFAULT_PUBLISH_PERIOD;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    if (g_nodeConfigSettings.idle_keepalive_period < MIN_IDLE_KEEPALIVE_PERIOD ||
+        g_nodeConfigSettings.idle_keepalive_period > MAX_IDLE_KEEPALIVE_PERIOD)
+    {
+        Ros_Debug_BroadcastMsg("idle_keepalive_period value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.idle_keepalive_period, DEFAULT_IDLE_KEEPALIVE_PERIOD);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid idle_keepalive_period", SUBCODE_CONFIGURATION_INVALID_IDLE_KEEPALIVE_PERIOD);
+
+        g_nodeConfigSettings.idle_keepalive_period = DEFAULT_IDLE_KEEPALIVE_PERIOD;
+    }
+
+    //-----------------------------------------------------------------------------
+    //0 disables the heartbeat
+    if (g_nodeConfigSettings.agent_heartbeat_timeout != 0 &&
+        (g_nodeConfigSettings.agent_heartbeat_timeout < MIN_AGENT_HEARTBEAT_TIMEOUT ||
+         g_nodeConfigSettings.agent_heartbeat_timeout > MAX_AGENT_HEARTBEAT_TIMEOUT))
+    {
+        Ros_Debug_BroadcastMsg("agent_heartbeat_timeout value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.agent_heartbeat_timeout, DEFAULT_AGENT_HEARTBEAT_TIMEOUT);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid agent_heartbeat_timeout", SUBCODE_CONFIGURATION_INVALID_AGENT_HEARTBEAT_TIMEOUT);
+
+        g_nodeConfigSettings.agent_heartbeat_timeout = DEFAULT_AGENT_HEARTBEAT_TIMEOUT;
+    }
+
+    //-----------------------------------------------------------------------------
+    if (g_nodeConfigSettings.scheduled_start_horizon < MIN_SCHEDULED_START_HORIZON ||
+        g_nodeConfigSettings.scheduled_start_horizon > MAX_SCHEDULED_START_HORIZON)
+    {
+        Ros_Debug_BroadcastMsg("scheduled_start_horizon value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.scheduled_start_horizon, DEFAULT_SCHEDULED_START_HORIZON);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid scheduled_start_horizon", SUBCODE_CONFIGURATION_INVALID_SCHEDULED_START_HORIZON);
+
+        g_nodeConfigSettings.scheduled_start_horizon = DEFAULT_SCHEDULED_START_HORIZON;
+    }
+
+    //-----------------------------------------------------------------------------
+    if (g_nodeConfigSettings.max_cartesian_linear_speed < MIN_MAX_CARTESIAN_LINEAR_SPEED ||
+        g_nodeConfigSettings.max_cartesian_linear_speed > MAX_MAX_CARTESIAN_LINEAR_SPEED)
+    {
+        Ros_Debug_BroadcastMsg("max_cartesian_linear_speed value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.max_cartesian_linear_speed, DEFAULT_MAX_CARTESIAN_LINEAR_SPEED);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid Cartesian speed limit", SUBCODE_CONFIGURATION_INVALID_CARTESIAN_SPEED_LIMIT);
+
+        g_nodeConfigSettings.max_cartesian_linear_speed = DEFAULT_MAX_CARTESIAN_LINEAR_SPEED;
+    }
+
+    if (g_nodeConfigSettings.max_cartesian_angular_speed < MIN_MAX_CARTESIAN_ANGULAR_SPEED ||
+        g_nodeConfigSettings.max_cartesian_angular_speed > MAX_MAX_CARTESIAN_ANGULAR_SPEED)
+    {
+        Ros_Debug_BroadcastMsg("max_cartesian_angular_speed value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.max_cartesian_angular_speed, DEFAULT_MAX_CARTESIAN_ANGULAR_SPEED);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid Cartesian speed limit", SUBCODE_CONFIGURATION_INVALID_CARTESIAN_SPEED_LIMIT);
+
+        g_nodeConfigSettings.max_cartesian_angular_speed = DEFAULT_MAX_CARTESIAN_ANGULAR_SPEED;
+    }
+
+    //-----------------------------------------------------------------------------
+    if (g_nodeConfigSettings.idle_change_threshold < MIN_IDLE_CHANGE_THRESHOLD ||
+        g_nodeConfigSettings.idle_change_threshold > MAX_IDLE_CHANGE_THRESHOLD)
+    {
+        Ros_Debug_BroadcastMsg("idle_change_threshold value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.idle_change_threshold, DEFAULT_IDLE_CHANGE_THRESHOLD);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid idle_change_threshold", SUBCODE_CONFIGURATION_INVALID_IDLE_CHANGE_THRESHOLD);
+
+        g_nodeConfigSettings.idle_change_threshold = DEFAULT_IDLE_CHANGE_THRESHOLD;
+    }
+
+    //-----------------------------------------------------------------------------
+    if (g_nodeConfigSettings.joint_states_batch_size < MIN_JOINT_STATES_BATCH_SIZE ||
+        g_nodeConfigSettings.joint_states_batch_size > MAX_JOINT_STATES_BATCH_SIZE)
+    {
+        Ros_Debug_BroadcastMsg("joint_states_batch_size value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.joint_states_batch_size, DEFAULT_JOINT_STATES_BATCH_SIZE);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid js_batch_size", SUBCODE_CONFIGURATION_INVALID_JOINT_STATES_BATCH_SIZE);
+
+        g_nodeConfigSettings.joint_states_batch_size = DEFAULT_JOINT_STATES_BATCH_SIZE;
+    }
+
     //-----------------------------------------------------------------------------
     if (g_nodeConfigSettings.userlan_monitor_enabled)
     {
@@ -718,6 +1015,15 @@ const char* const Ros_ConfigFile_Rmw_Qos_ProfileSetting_ToString(Ros_QoS_Profile
     return ROS_QOS_PROFILE_UNKNOWN_NAME;
 }
 
+const char* const Ros_ConfigFile_TaskPrioritySetting_ToString(Ros_Task_Priority_Setting val)
+{
+    if (val == CFG_TASK_PRIORITY_NORMAL)
+        return CFG_TASK_PRIORITY_NORMAL_NAME;
+    if (val == CFG_TASK_PRIORITY_HIGH)
+        return CFG_TASK_PRIORITY_HIGH_NAME;
+    return CFG_TASK_PRIORITY_UNKNOWN_NAME;
+}
+
 void Ros_ConfigFile_PrintActiveConfiguration(Ros_Configuration_Settings const* const config)
 {
     Ros_Debug_BroadcastMsg("Config: ros_domain_id = %d", config->ros_domain_id);
@@ -727,8 +1033,12 @@ void Ros_ConfigFile_PrintActiveConfiguration(Ros_Configuration_Settings const* c
     Ros_Debug_BroadcastMsg("Config: agent_ip_address = '%s'", config->agent_ip_address);
     Ros_Debug_BroadcastMsg("Config: agent_port_number = '%s'", config->agent_port_number);
     Ros_Debug_BroadcastMsg("Config: sync_timeclock_with_agent = %d", config->sync_timeclock_with_agent);
+    Ros_Debug_BroadcastMsg("Config: scheduled_start_horizon = %d", config->scheduled_start_horizon);
     Ros_Debug_BroadcastMsg("Config: namespace_tf = %d", config->namespace_tf);
     Ros_Debug_BroadcastMsg("Config: publish_tf = %d", config->publish_tf);
+    Ros_Debug_BroadcastMsg("Config: publish_group_joint_states = %d", config->publish_group_joint_states);
+    Ros_Debug_BroadcastMsg("Config: publish_joint_command_states = %d", config->publish_joint_command_states);
+    Ros_Debug_BroadcastMsg("Config: publish_compact_joint_states = %d", config->publish_compact_joint_states);
     Ros_Debug_BroadcastMsg("List of configured joint names:");
 
     for (int i = 0; i < MAX_CONTROLLABLE_GROUPS; i += 1)
@@ -745,14 +1055,45 @@ void Ros_ConfigFile_PrintActiveConfiguration(Ros_Configuration_Settings const* c
     Ros_Debug_BroadcastMsg("---");
 
     Ros_Debug_BroadcastMsg("Config: logging.log_to_stdout = %d", config->log_to_stdout);
+    Ros_Debug_BroadcastMsg("Config: logging.log_level = '%s'", Ros_Debug_LevelToString((Debug_Level)config->log_level));
+    for (int i = 0; i < NUM_DEBUG_MODULES; i += 1)
+    {
+        Ros_Debug_BroadcastMsg("Config: logging.%s_log_level = '%s'", Ros_Debug_ModuleToString((Debug_Module)i),
+            (config->module_log_levels[i] == CFG_LOG_LEVEL_DEFAULT) ?
+                CFG_LOG_LEVEL_DEFAULT_NAME : Ros_Debug_LevelToString((Debug_Level)config->module_log_levels[i]));
+    }
+    Ros_Debug_BroadcastMsg("Config: logging.log_rate_limit = %d", config->log_rate_limit);
+    Ros_Debug_BroadcastMsg("Config: logging.log_telemetry = %d", config->log_telemetry);
     Ros_Debug_BroadcastMsg("Config: update_periods.executor_sleep_period = %d", config->executor_sleep_period);
+    Ros_Debug_BroadcastMsg("Config: executors.streaming_executor_period = %d", config->executor_periods[COMMUNICATION_EXECUTOR_STREAMING]);
+    Ros_Debug_BroadcastMsg("Config: executors.goal_executor_period = %d", config->executor_periods[COMMUNICATION_EXECUTOR_GOALS]);
+    Ros_Debug_BroadcastMsg("Config: executors.mode_executor_period = %d", config->executor_periods[COMMUNICATION_EXECUTOR_MODE_CHANGES]);
+    Ros_Debug_BroadcastMsg("Config: executors.io_executor_period = %d", config->executor_periods[COMMUNICATION_EXECUTOR_IO]);
+    Ros_Debug_BroadcastMsg("Config: executors.diagnostics_executor_period = %d", config->executor_periods[COMMUNICATION_EXECUTOR_DIAGNOSTICS]);
+    Ros_Debug_BroadcastMsg("Config: executors.streaming_executor_priority = '%s'", Ros_ConfigFile_TaskPrioritySetting_ToString(config->executor_priorities[COMMUNICATION_EXECUTOR_STREAMING]));
+    Ros_Debug_BroadcastMsg("Config: executors.goal_executor_priority = '%s'", Ros_ConfigFile_TaskPrioritySetting_ToString(config->executor_priorities[COMMUNICATION_EXECUTOR_GOALS]));
+    Ros_Debug_BroadcastMsg("Config: executors.mode_executor_priority = '%s'", Ros_ConfigFile_TaskPrioritySetting_ToString(config->executor_priorities[COMMUNICATION_EXECUTOR_MODE_CHANGES]));
+    Ros_Debug_BroadcastMsg("Config: executors.io_executor_priority = '%s'", Ros_ConfigFile_TaskPrioritySetting_ToString(config->executor_priorities[COMMUNICATION_EXECUTOR_IO]));
+    Ros_Debug_BroadcastMsg("Config: executors.diagnostics_executor_priority = '%s'", Ros_ConfigFile_TaskPrioritySetting_ToString(config->executor_priorities[COMMUNICATION_EXECUTOR_DIAGNOSTICS]));
     Ros_Debug_BroadcastMsg("Config: update_periods.action_feedback_publisher_period = %d", config->action_feedback_publisher_period);
     Ros_Debug_BroadcastMsg("Config: update_periods.controller_status_monitor_period = %d", config->controller_status_monitor_period);
+    Ros_Debug_BroadcastMsg("Config: update_periods.joint_states_publish_period = %d", config->joint_states_publish_period);
+    Ros_Debug_BroadcastMsg("Config: update_periods.group_joint_states_publish_period = %d", config->group_joint_states_publish_period);
+    Ros_Debug_BroadcastMsg("Config: update_periods.joint_command_states_publish_period = %d", config->joint_command_states_publish_period);
+    Ros_Debug_BroadcastMsg("Config: update_periods.tf_publish_period = %d", config->tf_publish_period);
+    Ros_Debug_BroadcastMsg("Config: update_periods.robot_status_publish_period = %d", config->robot_status_publish_period);
+    Ros_Debug_BroadcastMsg("Config: update_periods.idle_keepalive_period = %d", config->idle_keepalive_period);
+    Ros_Debug_BroadcastMsg("Config: update_periods.idle_change_threshold = %d", config->idle_change_threshold);
+    Ros_Debug_BroadcastMsg("Config: joint_states_batch_size = %d", config->joint_states_batch_size);
+    Ros_Debug_BroadcastMsg("Config: joint_states_batch_speed_torque = %d", config->joint_states_batch_speed_torque);
     Ros_Debug_BroadcastMsg("Config: publisher_qos.robot_status = '%s'", Ros_ConfigFile_Rmw_Qos_ProfileSetting_ToString(config->qos_robot_status));
     Ros_Debug_BroadcastMsg("Config: publisher_qos.joint_states = '%s'", Ros_ConfigFile_Rmw_Qos_ProfileSetting_ToString(config->qos_joint_states));
     Ros_Debug_BroadcastMsg("Config: publisher_qos.tf = '%s'", Ros_ConfigFile_Rmw_Qos_ProfileSetting_ToString(config->qos_tf));
     Ros_Debug_BroadcastMsg("Config: tf_frame_prefix = '%s'", config->tf_frame_prefix);
     Ros_Debug_BroadcastMsg("Config: stop_motion_on_disconnect = %d", config->stop_motion_on_disconnect);
+    Ros_Debug_BroadcastMsg("Config: agent_heartbeat_timeout = %d", config->agent_heartbeat_timeout);
+    Ros_Debug_BroadcastMsg("Config: max_cartesian_linear_speed = %d", config->max_cartesian_linear_speed);
+    Ros_Debug_BroadcastMsg("Config: max_cartesian_angular_speed = %d", config->max_cartesian_angular_speed);
     Ros_Debug_BroadcastMsg("Config: inform_job_name = '%s'", config->inform_job_name);
     Ros_Debug_BroadcastMsg("Config: allow_custom_inform_job = %d", config->allow_custom_inform_job);
     Ros_Debug_BroadcastMsg("Config: userlan_monitor_enabled = %d", config->userlan_monitor_enabled);
@@ -881,3 +1222,12 @@ rmw_qos_profile_t const* const Ros_ConfigFile_To_Rmw_Qos_Profile(Ros_QoS_Profile
         return &rmw_qos_profile_system_default;
     return &rmw_qos_profile_unknown;
 }
+
+int Ros_ConfigFile_To_Mp_Task_Priority(Ros_Task_Priority_Setting val)
+{
+    //One level below MP_PRI_TIME_CRITICAL (larger values are lower priorities), so a
+    //busy executor can't delay the tasks which keep the increment queues filled
+    if (val == CFG_TASK_PRIORITY_HIGH)
+        return MP_PRI_TIME_CRITICAL + 1;
+    return MP_PRI_TIME_NORMAL;
+}
@@ -27,7 +27,14 @@
 
 #define DEFAULT_SYNCTIME                TRUE
 
+#define DEFAULT_SCHEDULED_START_HORIZON 10000 //ms
+#define MIN_SCHEDULED_START_HORIZON     1
+#define MAX_SCHEDULED_START_HORIZON     600000
+
 #define DEFAULT_PUBLISH_TF              TRUE
+#define DEFAULT_PUBLISH_GROUP_JOINT_STATES  TRUE
+#define DEFAULT_PUBLISH_JOINT_COMMAND_STATES    FALSE
+#define DEFAULT_PUBLISH_COMPACT_JOINT_STATES    FALSE
 
 #define DEFAULT_NAMESPACE_TF            TRUE
 
@@ -37,10 +44,20 @@
 
 #define DEFAULT_LOG_TO_STDOUT           FALSE
 
+#define CFG_LOG_LEVEL_DEFAULT           -1  // module threshold: same as 'log_level'
+#define CFG_LOG_LEVEL_DEFAULT_NAME      "default"
+#define DEFAULT_LOG_LEVEL               DEBUG_LEVEL_INFO
+#define DEFAULT_LOG_RATE_LIMIT          0   // messages per call site per PERIOD_DEBUG_LOG_RATE_LIMIT_MS (0: unlimited)
+#define MIN_LOG_RATE_LIMIT              0   // disabled
+#define MAX_LOG_RATE_LIMIT              1000
+#define DEFAULT_LOG_TELEMETRY           FALSE
+
 #define DEFAULT_EXECUTOR_SLEEP_PERIOD   10 //ms
 #define MIN_EXECUTOR_SLEEP_PERIOD       1
 #define MAX_EXECUTOR_SLEEP_PERIOD       100
 
+#define DEFAULT_EXECUTOR_PERIOD         0 //ms (0: same as executor_sleep_period)
+
 #define DEFAULT_FEEDBACK_PUBLISH_PERIOD 20 //ms
 #define MIN_FEEDBACK_PUBLISH_PERIOD     1
 #define MAX_FEEDBACK_PUBLISH_PERIOD     100
@@ -49,6 +66,35 @@
 #define MIN_CONTROLLER_IO_PERIOD        1
 #define MAX_CONTROLLER_IO_PERIOD        100
 
+#define DEFAULT_PUBLISH_PERIOD          0 //ms (0: same as controller_status_monitor_period)
+#define MIN_PUBLISH_PERIOD              0
+#define MAX_PUBLISH_PERIOD              1000
+
+#define DEFAULT_IDLE_KEEPALIVE_PERIOD   0 //ms (0: always publish at full rate)
+#define MIN_IDLE_KEEPALIVE_PERIOD       0
+#define MAX_IDLE_KEEPALIVE_PERIOD       60000
+
+#define DEFAULT_IDLE_CHANGE_THRESHOLD   2 //pulses
+#define MIN_IDLE_CHANGE_THRESHOLD       0
+#define MAX_IDLE_CHANGE_THRESHOLD       100
+
+#define DEFAULT_AGENT_HEARTBEAT_TIMEOUT 0 //ms (0: disabled)
+#define MIN_AGENT_HEARTBEAT_TIMEOUT     100
+#define MAX_AGENT_HEARTBEAT_TIMEOUT     5000
+
+#define DEFAULT_MAX_CARTESIAN_LINEAR_SPEED  1500 //mm/s
+#define MIN_MAX_CARTESIAN_LINEAR_SPEED      1
+#define MAX_MAX_CARTESIAN_LINEAR_SPEED      5000
+
+#define DEFAULT_MAX_CARTESIAN_ANGULAR_SPEED 180 //deg/s
+#define MIN_MAX_CARTESIAN_ANGULAR_SPEED     1
+#define MAX_MAX_CARTESIAN_ANGULAR_SPEED     1000
+
+#define DEFAULT_JOINT_STATES_BATCH_SIZE 0 //samples (0: disabled)
+#define MIN_JOINT_STATES_BATCH_SIZE     0
+#define MAX_JOINT_STATES_BATCH_SIZE     25
+#define DEFAULT_JOINT_STATES_BATCH_SPEED_TORQUE TRUE
+
 #define DEFAULT_QOS_ROBOT_STATUS        ROS_QOS_PROFILE_SENSOR_DATA
 
 #define DEFAULT_QOS_JOINT_STATES        ROS_QOS_PROFILE_SENSOR_DATA
@@ -82,6 +128,18 @@ typedef enum
 #define ROS_QOS_PROFILE_SYSTEM_DEFAULT_NAME "system_default"
 #define ROS_QOS_PROFILE_UNKNOWN_NAME "unknown"
 
+typedef enum
+{
+    CFG_TASK_PRIORITY_NORMAL = 0,   // MP_PRI_TIME_NORMAL
+    CFG_TASK_PRIORITY_HIGH = 1,     // MP_PRI_TIME_CRITICAL + 1
+} Ros_Task_Priority_Setting;
+
+#define CFG_TASK_PRIORITY_NORMAL_NAME   "normal"
+#define CFG_TASK_PRIORITY_HIGH_NAME     "high"
+#define CFG_TASK_PRIORITY_UNKNOWN_NAME  "unknown"
+
+#define DEFAULT_EXECUTOR_PRIORITY       CFG_TASK_PRIORITY_NORMAL
+
 #define DEFAULT_REMAP_RULES             ""
 #define MAX_REMAP_RULE_NUM              16
 #define MAX_REMAP_RULE_LEN              256
@@ -113,17 +171,37 @@ typedef struct
     char agent_port_number[MAX_YAML_STRING_LEN];
 
     BOOL sync_timeclock_with_agent;
+    int scheduled_start_horizon;
 
     BOOL publish_tf;
+    BOOL publish_group_joint_states;
+    BOOL publish_joint_command_states;
+    BOOL publish_compact_joint_states;
     BOOL namespace_tf;
 
     char joint_names[MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM][MAX_JOINT_NAME_LENGTH];
 
     BOOL log_to_stdout;
+    int log_level;
+    int module_log_levels[NUM_DEBUG_MODULES];
+    int log_rate_limit;
+    BOOL log_telemetry;
 
     int executor_sleep_period;
+    int executor_periods[NUM_COMMUNICATION_EXECUTORS];
+    Ros_Task_Priority_Setting executor_priorities[NUM_COMMUNICATION_EXECUTORS];
     int action_feedback_publisher_period;
     int controller_status_monitor_period;
+    int joint_states_publish_period;
+    int group_joint_states_publish_period;
+    int joint_command_states_publish_period;
+    int tf_publish_period;
+    int robot_status_publish_period;
+    int idle_keepalive_period;
+    int idle_change_threshold;
+
+    int joint_states_batch_size;
+    BOOL joint_states_batch_speed_torque;
 
     Ros_QoS_Profile_Setting qos_robot_status;
     Ros_QoS_Profile_Setting qos_joint_states;
@@ -132,6 +210,10 @@ typedef struct
     char tf_frame_prefix[MAX_YAML_STRING_LEN];
 
     BOOL stop_motion_on_disconnect;
+    int agent_heartbeat_timeout;
+
+    int max_cartesian_linear_speed;
+    int max_cartesian_angular_speed;
 
     char inform_job_name[MAX_JOB_NAME_LEN];
 
@@ -149,4 +231,7 @@ extern void Ros_ConfigFile_Parse();
 
 extern rmw_qos_profile_t const* const Ros_ConfigFile_To_Rmw_Qos_Profile(Ros_QoS_Profile_Setting val);
 
+extern int Ros_ConfigFile_To_Mp_Task_Priority(Ros_Task_Priority_Setting val);
+extern const char* const Ros_ConfigFile_TaskPrioritySetting_ToString(Ros_Task_Priority_Setting val);
+
 #endif  // MOTOROS2_CONFIG_FILE_H
@@ -0,0 +1,120 @@
+//ControllerSnapshot.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+#define CONTROLLER_SNAPSHOT_MAX_SPEED_REGISTERS     (MAX_CONTROLLABLE_GROUPS * MAX_PULSE_AXES * 2)
+
+//speed feedback registers of all groups, read with a single mpReadIO call
+static MP_IO_INFO controllerSnapshot_speedRegisters[CONTROLLER_SNAPSHOT_MAX_SPEED_REGISTERS];
+static int controllerSnapshot_numSpeedRegisters = 0;
+static int controllerSnapshot_speedRegisterOffset[MAX_CONTROLLABLE_GROUPS];    // -1: speed feedback not enabled for this group
+
+//only written by the RosInitTask
+static ControllerSnapshot controllerSnapshot_latest;
+
+void Ros_ControllerSnapshot_Initialize()
+{
+    controllerSnapshot_numSpeedRegisters = 0;
+
+    for (int groupIndex = 0; groupIndex < MAX_CONTROLLABLE_GROUPS; groupIndex += 1)
+    {
+        controllerSnapshot_speedRegisterOffset[groupIndex] = -1;
+
+        if (groupIndex >= g_Ros_Controller.numGroup)
+            continue;
+
+        CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+        if (!group->speedFeedbackRegisterAddress.bFeedbackSpeedEnabled)
+            continue;
+
+        controllerSnapshot_speedRegisterOffset[groupIndex] = controllerSnapshot_numSpeedRegisters;
+        for (int axis = 0; axis < MAX_PULSE_AXES; axis += 1)
+        {
+            //values are 4 bytes, which consumes 2 registers
+            controllerSnapshot_speedRegisters[controllerSnapshot_numSpeedRegisters].ulAddr = group->speedFeedbackRegisterAddress.cioAddressForAxis[axis][0];
+            controllerSnapshot_speedRegisters[controllerSnapshot_numSpeedRegisters + 1].ulAddr = group->speedFeedbackRegisterAddress.cioAddressForAxis[axis][1];
+            controllerSnapshot_numSpeedRegisters += 2;
+        }
+    }
+}
+
+void Ros_ControllerSnapshot_ReadSpeed(BOOL bFbPulseSpeedValid[MAX_CONTROLLABLE_GROUPS], long fbPulseSpeed[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES])
+{
+    int groupIndex;
+
+#ifndef DUMMY_SERVO_MODE
+    USHORT registerValues[CONTROLLER_SNAPSHOT_MAX_SPEED_REGISTERS];
+    BOOL bSpeedOk = FALSE;
+
+    if (controllerSnapshot_numSpeedRegisters > 0)
+    {
+        LONG status = mpReadIO(controllerSnapshot_speedRegisters, registerValues, controllerSnapshot_numSpeedRegisters);
+        bSpeedOk = (status == OK);
+        if (!bSpeedOk)
+            Ros_Debug_BroadcastMsg("Failed to get pulse feedback speed: %u", status);
+    }
+
+    for (groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        int offset = controllerSnapshot_speedRegisterOffset[groupIndex];
+
+        bFbPulseSpeedValid[groupIndex] = bSpeedOk && (offset >= 0);
+        if (bFbPulseSpeedValid[groupIndex])
+            Ros_CtrlGroup_ConvertSpeedRegistersToPulse(g_Ros_Controller.ctrlGroups[groupIndex], &registerValues[offset], fbPulseSpeed[groupIndex]);
+        else
+            bzero(fbPulseSpeed[groupIndex], sizeof(fbPulseSpeed[groupIndex]));
+    }
+#else
+    for (groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+        bFbPulseSpeedValid[groupIndex] = Ros_CtrlGroup_GetFBServoSpeed(g_Ros_Controller.ctrlGroups[groupIndex], fbPulseSpeed[groupIndex]);
+#endif
+}
+
+void Ros_ControllerSnapshot_ReadTorque(double torque[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES])
+{
+    MP_GRP_AXES_T dst_vel;
+    MP_TRQ_CTL_VAL dst_trq;
+
+    //torque of all groups at once (instead of using Ros_CtrlGroup_GetTorque for each group)
+    bzero(dst_trq.data, sizeof(MP_TRQCTL_DATA));
+    dst_trq.unit = TRQ_NEWTON_METER; //request data in Nm
+    bzero(&dst_vel, sizeof(MP_GRP_AXES_T));
+    BOOL bTorqueOk = (mpSvsGetVelTrqFb(dst_vel, &dst_trq) == OK);
+
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        int groupNo = g_Ros_Controller.ctrlGroups[groupIndex]->groupNo;
+
+        for (int axis = 0; axis < MAX_PULSE_AXES; axis += 1)
+            torque[groupIndex][axis] = bTorqueOk ? (double)dst_trq.data[groupNo][axis] * 0.000001 : 0.0; //Use double.  Float only good for 6 sig digits.
+    }
+}
+
+void Ros_ControllerSnapshot_Read(ControllerSnapshot* snapshot)
+{
+    snapshot->timestamp = Ros_ClockSync_Now();
+
+    //positions can only be retrieved per group
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+
+        snapshot->bFbPulsePosValid[groupIndex] = Ros_CtrlGroup_GetFBPulsePos(group, snapshot->fbPulsePos[groupIndex]);
+        Ros_CtrlGroup_GetPulsePosCmd(group, snapshot->cmdPulsePos[groupIndex]);
+    }
+
+    //speed and torque of all groups at once
+    Ros_ControllerSnapshot_ReadSpeed(snapshot->bFbPulseSpeedValid, snapshot->fbPulseSpeed);
+    Ros_ControllerSnapshot_ReadTorque(snapshot->torque);
+}
+
+ControllerSnapshot const* Ros_ControllerSnapshot_Update()
+{
+    Ros_ControllerSnapshot_Read(&controllerSnapshot_latest);
+    return &controllerSnapshot_latest;
+}
@@ -0,0 +1,41 @@
+//ControllerSnapshot.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_CONTROLLER_SNAPSHOT_H
+#define MOTOROS2_CONTROLLER_SNAPSHOT_H
+
+//Feedback and command data of all groups, read in a single pass and stamped with
+//a single timestamp. All positions and speeds are in motoman joint order.
+typedef struct
+{
+    INT64 timestamp;                                                // synchronized time (ns)
+    BOOL bFbPulsePosValid[MAX_CONTROLLABLE_GROUPS];
+    BOOL bFbPulseSpeedValid[MAX_CONTROLLABLE_GROUPS];
+    long fbPulsePos[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+    long cmdPulsePos[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+    long fbPulseSpeed[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+    double torque[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];        // moto units (Nm or N)
+} ControllerSnapshot;
+
+//Build the list of speed feedback registers of all groups. Must be called after Ros_Controller_Initialize.
+extern void Ros_ControllerSnapshot_Initialize();
+
+//Read the feedback and command data of all groups into 'snapshot'. The speed registers of
+//all groups are read with a single mpReadIO call and the torque with a single
+//mpSvsGetVelTrqFb call. Can be called from any task.
+extern void Ros_ControllerSnapshot_Read(ControllerSnapshot* snapshot);
+
+//Read only the speed feedback or only the torque of all groups, the same way as
+//Ros_ControllerSnapshot_Read does. Can be called from any task.
+extern void Ros_ControllerSnapshot_ReadSpeed(BOOL bFbPulseSpeedValid[MAX_CONTROLLABLE_GROUPS], long fbPulseSpeed[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES]);
+extern void Ros_ControllerSnapshot_ReadTorque(double torque[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES]);
+
+//Read a new snapshot for the status monitor and feedback publishers. Must only be called
+//from the RosInitTask. The returned snapshot is valid until the next call.
+extern ControllerSnapshot const* Ros_ControllerSnapshot_Update();
+
+#endif  // MOTOROS2_CONTROLLER_SNAPSHOT_H
@@ -32,7 +32,9 @@ BOOL Ros_Controller_WaitInitReady()
 
 //-------------------------------------------------------------------
 // Initialize the controller structure
-// This should be done before the controller is used for anything
+// This should be done before the controller is used for anything.
+// The controller model does not depend on the connection with the
+// Agent, so this is only done once (and not after every reconnect).
 //-------------------------------------------------------------------
 BOOL Ros_Controller_Initialize()
 {
@@ -147,19 +149,8 @@ BOOL Ros_Controller_Initialize()
 #endif
 
     //==================================
-    //create publisher for robot status
-    const rmw_qos_profile_t* qos_profile = Ros_ConfigFile_To_Rmw_Qos_Profile(g_nodeConfigSettings.qos_robot_status);
-    rcl_ret_t ret;
-    ret = rclc_publisher_init(
-        &g_publishers_RobotStatus.robotStatus,
-        &g_microRosNodeInfo.node,
-        ROSIDL_GET_MSG_TYPE_SUPPORT(industrial_msgs, msg, RobotStatus),
-        TOPIC_NAME_ROBOT_STATUS,
-        qos_profile);
-    motoRosAssert(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_ROBOT_STATUS);
-
-    //==================================
-    //create message for robot status
+    //create message for robot status (the publisher is created for every
+    //connection, by Ros_Controller_InitializeRobotStatusPublisher())
     //TODO(gavanderhoorn): use micro_ros_utilities_create_message_memory(..) instead
     g_messages_RobotStatus.msgRobotStatus = industrial_msgs__msg__RobotStatus__create();
     rosidl_runtime_c__int32__Sequence__init(&g_messages_RobotStatus.msgRobotStatus->error_codes, MAX_ALARM_COUNT + 1);
@@ -220,37 +211,32 @@ BOOL Ros_Controller_Initialize()
     return bInitOk;
 }
 
-void Ros_Controller_Cleanup()
+//-------------------------------------------------------------------
+// Create the publisher for the robot status. The publisher belongs to
+// the node, so this must be done for every connection with the Agent.
+//-------------------------------------------------------------------
+void Ros_Controller_InitializeRobotStatusPublisher()
 {
     rcl_ret_t ret;
 
-    MOTOROS2_MEM_TRACE_START(ctrlr_fini);
-
-    //--------------------------------
-    // Cleanup memory
-    //
-
-    for (int groupNum = 0; groupNum < MAX_CONTROLLABLE_GROUPS; groupNum += 1)
-    {
-        if (g_Ros_Controller.ctrlGroups[groupNum] != NULL)
-        {
-            Ros_Debug_BroadcastMsg("Cleanup control group %d", groupNum + 1);
-            Ros_CtrlGrp_Cleanup(g_Ros_Controller.ctrlGroups[groupNum]);
-            mpFree(g_Ros_Controller.ctrlGroups[groupNum]);
-        }
-    }
+    const rmw_qos_profile_t* qos_profile = Ros_ConfigFile_To_Rmw_Qos_Profile(g_nodeConfigSettings.qos_robot_status);
+    ret = rclc_publisher_init(
+        &g_publishers_RobotStatus.robotStatus,
+        &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(industrial_msgs, msg, RobotStatus),
+        TOPIC_NAME_ROBOT_STATUS,
+        qos_profile);
+    motoRosAssert(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_ROBOT_STATUS);
+}
 
-    mpDeleteTask(g_Ros_Controller.tidIncMoveThread);
-    g_Ros_Controller.tidIncMoveThread = INVALID_TASK;
+void Ros_Controller_CleanupRobotStatusPublisher()
+{
+    rcl_ret_t ret;
 
     Ros_Debug_BroadcastMsg("Cleanup publisher robot status");
     ret = rcl_publisher_fini(&g_publishers_RobotStatus.robotStatus, &g_microRosNodeInfo.node);
     if (ret != RCL_RET_OK)
         Ros_Debug_BroadcastMsg("Failed cleaning up robot status publisher: %d", ret);
-
-    industrial_msgs__msg__RobotStatus__destroy(g_messages_RobotStatus.msgRobotStatus);
-
-    MOTOROS2_MEM_TRACE_REPORT(ctrlr_fini);
 }
 
 //-------------------------------------------------------------------
@@ -262,7 +248,7 @@ BOOL Ros_Controller_IsValidGroupNo(int groupNo)
         return TRUE;
     else
     {
-        Ros_Debug_BroadcastMsg("ERROR: Attempt to access invalid Group No. (%d)", groupNo);
+        Ros_Debug_BroadcastErrorMsg("Attempt to access invalid Group No. (%d)", groupNo);
         return FALSE;
     }
 }
@@ -497,49 +483,14 @@ BOOL Ros_Controller_MasterTaskIsJobName(const char* const jobName)
     return strncmp(curJobResponseData.cJobName, jobName, MAX_JOB_NAME_LEN) == 0;
 }
 
+//-------------------------------------------------------------------
+// Whether the robot is moving. This is determined by the IncMoveTask
+// every interpolation cycle, so calling this is cheap. Returns ERROR
+// if it could not be determined.
+//-------------------------------------------------------------------
 BOOL Ros_Controller_IsInMotion()
 {
-    int i;
-    int groupNo;
-    long fbPulsePos[MAX_PULSE_AXES];
-    long cmdPulsePos[MAX_PULSE_AXES];
-    BOOL bDataInQ;
-    CtrlGroup* ctrlGroup;
-
-    bDataInQ = Ros_MotionControl_HasDataInQueue();
-
-    if (bDataInQ == TRUE)
-        return TRUE;
-    else if (bDataInQ == ERROR)
-        return ERROR;
-    else
-    {
-        //for each control group
-        for (groupNo = 0; groupNo < g_Ros_Controller.numGroup; groupNo++)
-        {
-            //Check group number valid
-            if (!Ros_Controller_IsValidGroupNo(groupNo))
-                continue;
-
-            //Check if the feeback position has caught up to the command position
-            ctrlGroup = g_Ros_Controller.ctrlGroups[groupNo];
-
-            Ros_CtrlGroup_GetFBPulsePos(ctrlGroup, fbPulsePos);
-            Ros_CtrlGroup_GetPulsePosCmd(ctrlGroup, cmdPulsePos);
-
-            for (i = 0; i < MP_GRP_AXES_NUM; i += 1)
-            {
-                if (!Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
-                {
-                    // Check if position matches current command position
-                    if (abs(fbPulsePos[i] - cmdPulsePos[i]) > START_MAX_PULSE_DEVIATION)
-                        return TRUE;
-                }
-            }
-        }
-    }
-
-    return FALSE;
+    return Ros_MotionControl_IsInMotion();
 }
 
 //-------------------------------------------------------------------
@@ -550,6 +501,40 @@ BOOL Ros_Controller_StatusRead(USHORT ioStatus[IO_ROBOTSTATUS_MAX])
     return (mpReadIO(g_Ros_Controller.ioStatusAddr, ioStatus, IO_ROBOTSTATUS_MAX) == 0);
 }
 
+//-------------------------------------------------------------------
+// Whether the contents of the robot_status message differ from the
+// last published message (ignoring the header)
+//-------------------------------------------------------------------
+static BOOL Ros_Controller_HasRobotStatusChanged(industrial_msgs__msg__RobotStatus const* const msg)
+{
+    static industrial_msgs__msg__RobotStatus published;
+    static int32_t publishedErrorCodes[MAX_ALARM_COUNT + 1];
+    static BOOL bPublishedValid = FALSE;
+
+    BOOL bChanged = !bPublishedValid ||
+        (msg->drives_powered.val != published.drives_powered.val) ||
+        (msg->e_stopped.val != published.e_stopped.val) ||
+        (msg->in_motion.val != published.in_motion.val) ||
+        (msg->mode.val != published.mode.val) ||
+        (msg->motion_possible.val != published.motion_possible.val) ||
+        (msg->in_error.val != published.in_error.val) ||
+        (msg->error_codes.size != published.error_codes.size);
+
+    for (size_t i = 0; !bChanged && i < msg->error_codes.size; i += 1)
+        bChanged = (msg->error_codes.data[i] != publishedErrorCodes[i]);
+
+    if (bChanged)
+    {
+        //only the scalar fields are used from this copy, the error codes are stored separately
+        published = *msg;
+        for (size_t i = 0; i < msg->error_codes.size; i += 1)
+            publishedErrorCodes[i] = msg->error_codes.data[i];
+        bPublishedValid = TRUE;
+    }
+
+    return bChanged;
+}
+
 //-------------------------------------------------------------------
 // Update I/O state on the controller
 //-------------------------------------------------------------------
@@ -560,12 +545,11 @@ BOOL Ros_Controller_IoStatusUpdate()
     int i;
     BOOL prevReadyStatus;
     INT64 theTime;
-    rcl_ret_t ret;
 
     prevReadyStatus = Ros_Controller_IsMotionReady();
 
     //Timestamp
-    theTime = rmw_uros_epoch_nanos();
+    theTime = Ros_ClockSync_Now();
 
     if(Ros_Controller_StatusRead(ioStatus))
     {
@@ -661,7 +645,7 @@ BOOL Ros_Controller_IoStatusUpdate()
             int num_alarms = Ros_Controller_GetActiveAlarmCodes(active_alarms);
             if (num_alarms < 0)
             {
-                Ros_Debug_BroadcastMsg("Error retrieving active alarms: %d", num_alarms);
+                Ros_Debug_BroadcastErrorMsg("Could not retrieve active alarms: %d", num_alarms);
             }
             else
             {
@@ -673,15 +657,32 @@ BOOL Ros_Controller_IoStatusUpdate()
             }
         }
 
-        //publish status topic
+        return TRUE;
+    }
+    else
+        return FALSE;
+}
+
+//-------------------------------------------------------------------
+// Publish the status as last read by Ros_Controller_IoStatusUpdate()
+//-------------------------------------------------------------------
+BOOL Ros_Controller_PublishRobotStatus(BOOL bPositionChanged)
+{
+    rcl_ret_t ret;
+
+    //while the robot is stationary, only if the status or the position changed
+    BOOL bChanged = Ros_Controller_HasRobotStatusChanged(g_messages_RobotStatus.msgRobotStatus) || bPositionChanged;
+    if (Ros_IdlePublishing_ShouldPublish(IDLE_PUBLISHING_TOPIC_ROBOT_STATUS, bChanged))
+    {
         ret = rcl_publish(&g_publishers_RobotStatus.robotStatus, g_messages_RobotStatus.msgRobotStatus, NULL);
         // publishing can fail, but we choose to ignore those errors in this implementation
         RCL_UNUSED(ret);
-
+        Ros_IdlePublishing_CountPublished(IDLE_PUBLISHING_TOPIC_ROBOT_STATUS,
+            ROSIDL_GET_MSG_TYPE_SUPPORT(industrial_msgs, msg, RobotStatus), g_messages_RobotStatus.msgRobotStatus);
         return TRUE;
     }
-    else
-        return FALSE;
+
+    return FALSE;
 }
 
 
@@ -103,13 +103,17 @@ extern ControllerStatus_Messages g_messages_RobotStatus;
 extern Controller g_Ros_Controller;
 
 extern BOOL Ros_Controller_Initialize();
-extern void Ros_Controller_Cleanup();
+extern void Ros_Controller_InitializeRobotStatusPublisher();
+extern void Ros_Controller_CleanupRobotStatusPublisher();
 
 extern BOOL Ros_Controller_IsValidGroupNo(int groupNo);
 
 extern void Ros_Controller_StatusInit();
 extern BOOL Ros_Controller_StatusRead(USHORT ioStatus[IO_ROBOTSTATUS_MAX]);
 extern BOOL Ros_Controller_IoStatusUpdate();
+//bPositionChanged: whether the feedback position changed since robot_status was last published.
+//Returns whether robot_status was published.
+extern BOOL Ros_Controller_PublishRobotStatus(BOOL bPositionChanged);
 extern BOOL Ros_Controller_IsAlarm();
 extern BOOL Ros_Controller_IsError();
 extern BOOL Ros_Controller_IsPlay();
@@ -150,9 +150,15 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupIndex, BOOL bIsLastGrpToInit, float int
                 ctrlGroup->axisType.type[i] = AXIS_INVALID;
         }
 
+        Ros_CtrlGroup_InitializeConversionTables(ctrlGroup);
+
         bzero(&ctrlGroup->inc_q, sizeof(Incremental_q));
         ctrlGroup->inc_q.q_lock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
 
+        //one buffer holds the trajectory being executed, the other one the next (staged) trajectory
+        ctrlGroup->trajectoryToProcess = ctrlGroup->trajectoryBuffers[0];
+        ctrlGroup->trajectoryToStage = ctrlGroup->trajectoryBuffers[1];
+
         // Calculate maximum speed in radian per second
         bzero(maxSpeedPulse, sizeof(maxSpeedPulse));
         for(i=0; i<MP_GRP_AXES_NUM; i++)
@@ -172,7 +178,7 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupIndex, BOOL bIsLastGrpToInit, float int
                 strcat(startupMessage, "---\t");
             }
         }
-        Ros_Debug_BroadcastMsg(startupMessage);
+        Ros_Debug_BroadcastMsg("%s", startupMessage);
 
         sprintf(startupMessage, "pulse->unit[%d]: ", groupIndex);
         for (i = 0; i < MP_GRP_AXES_NUM; i++)
@@ -184,7 +190,7 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupIndex, BOOL bIsLastGrpToInit, float int
             else
                 strcat(startupMessage, "--\t");
         }
-        Ros_Debug_BroadcastMsg(startupMessage);
+        Ros_Debug_BroadcastMsg("%s", startupMessage);
 
         Ros_Debug_BroadcastMsg("maxInc[%d] (in motoman joint order): %d, %d, %d, %d, %d, %d, %d",
             groupIndex,
@@ -233,15 +239,6 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupIndex, BOOL bIsLastGrpToInit, float int
     return ctrlGroup;
 }
 
-void Ros_CtrlGrp_Cleanup(CtrlGroup* ctrlGroup)
-{
-    mpDeleteTask(ctrlGroup->tidAddToIncQueue);
-    ctrlGroup->tidAddToIncQueue = INVALID_TASK;
-
-    mpSemDelete(ctrlGroup->inc_q.q_lock);
-}
-
-
 //-------------------------------------------------------------------
 // Search through the control group to find the GroupId that matches
 // the group number
@@ -297,6 +294,17 @@ BOOL Ros_CtrlGroup_GetPulsePosCmd(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_
     for (i=0; i<MAX_PULSE_AXES; ++i)
         pulsePos[i] = pulse_data.lPos[i];
 
+    Ros_CtrlGroup_CompensateBaxisCmd(ctrlGroup, pulsePos);
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Apply the B axis compensation to a command position read with
+// mpGetPulsePos. Does nothing for groups without a slaved B axis.
+//-------------------------------------------------------------------
+void Ros_CtrlGroup_CompensateBaxisCmd(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES])
+{
     // For MPL80/100 robot type (SLUBT): Controller automatically moves the B-axis
     // to maintain orientation as other axes are moved.
     if (ctrlGroup->bIsBaxisSlave)
@@ -309,8 +317,6 @@ BOOL Ros_CtrlGroup_GetPulsePosCmd(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_
         rosAnglePos[3] += -rosAnglePos[1] + rosAnglePos[2];
         Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(ctrlGroup, rosAnglePos, pulsePos);
     }
-
-    return TRUE;
 }
 
 
@@ -372,6 +378,40 @@ BOOL Ros_CtrlGroup_GetFBPulsePos(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_A
     return TRUE;
 }
 
+//-------------------------------------------------------------------
+// Convert the contents of the speed feedback registers (two registers
+// per axis, see speedFeedbackRegisterAddress) to pulse/sec.
+//-------------------------------------------------------------------
+void Ros_CtrlGroup_ConvertSpeedRegistersToPulse(CtrlGroup const* const ctrlGroup, USHORT const registerValues[MAX_PULSE_AXES * 2], long pulseSpeed[MAX_PULSE_AXES])
+{
+    UINT32 registerValuesLong[MAX_PULSE_AXES * 2];
+
+    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        //move to 32 bit storage
+        registerValuesLong[i * 2] = registerValues[i * 2];
+        registerValuesLong[(i * 2) + 1] = registerValues[(i * 2) + 1];
+
+        //combine both registers into single 4 byte value (0.0001 deg/sec or 1 um/sec)
+        double dblRegister = (registerValuesLong[(i * 2) + 1] << 16) | registerValuesLong[i * 2];
+
+        //convert to pulse/sec
+        if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
+        {
+            dblRegister /= 1.0E4; //deg/sec
+            dblRegister *= RAD_PER_DEGREE; //rad/sec
+            dblRegister *= ctrlGroup->pulseToRad.PtoR[i]; //pulse/sec
+        }
+        else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
+        {
+            dblRegister /= 1.0E6; //m/sec
+            dblRegister *= ctrlGroup->pulseToMeter.PtoM[i]; //pulse/sec
+        }
+
+        pulseSpeed[i] = (long)dblRegister;
+    }
+}
+
 //-------------------------------------------------------------------
 // Get the corrected feedback pulse speed in pulse for each axis.
 //-------------------------------------------------------------------
@@ -383,7 +423,6 @@ BOOL Ros_CtrlGroup_GetFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PUL
     LONG status;
     MP_IO_INFO registerInfo[MAX_PULSE_AXES * 2]; //values are 4 bytes, which consumes 2 registers
     USHORT registerValues[MAX_PULSE_AXES * 2];
-    UINT32 registerValuesLong[MAX_PULSE_AXES * 2];
 
     bzero(pulseSpeed, sizeof(long[MAX_PULSE_AXES]));
 
@@ -404,30 +443,7 @@ BOOL Ros_CtrlGroup_GetFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PUL
         return FALSE;
     }
 
-    for (i = 0; i < MAX_PULSE_AXES; i += 1)
-    {
-        //move to 32 bit storage
-        registerValuesLong[i * 2] = registerValues[i * 2];
-        registerValuesLong[(i * 2) + 1] = registerValues[(i * 2) + 1];
-
-        //combine both registers into single 4 byte value (0.0001 deg/sec or 1 um/sec)
-        double dblRegister = (registerValuesLong[(i * 2) + 1] << 16) | registerValuesLong[i * 2];
-
-        //convert to pulse/sec
-        if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
-        {
-            dblRegister /= 1.0E4; //deg/sec
-            dblRegister *= RAD_PER_DEGREE; //rad/sec
-            dblRegister *= ctrlGroup->pulseToRad.PtoR[i]; //pulse/sec
-        }
-        else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
-        {
-            dblRegister /= 1.0E6; //m/sec
-            dblRegister *= ctrlGroup->pulseToMeter.PtoM[i]; //pulse/sec
-        }
-
-        pulseSpeed[i] = (long)dblRegister;
-    }
+    Ros_CtrlGroup_ConvertSpeedRegistersToPulse(ctrlGroup, registerValues, pulseSpeed);
 
 #else //dummy-servo mode for testing
     MP_CTRL_GRP_SEND_DATA sData;
@@ -498,100 +514,134 @@ BOOL Ros_CtrlGroup_GetEncoderTemperature(CtrlGroup const* const ctrlGroup, long
     return TRUE;
 }
 
-//Convert the Motoman position units (pulses) to ROS position units (radians/meters).
-//This function must be called BEFORE calling Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder.
-//The joints must be in Motoman (non-sequential) ordering.
-void Ros_CtrlGroup_ConvertMotoUnitsToRosUnits(CtrlGroup* ctrlGroup, long const motopulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
+//-------------------------------------------------------------------
+// Build the tables used by the conversion functions below. The checks
+// for invalid axes and the robot-type specific joint ordering are done
+// once here, so the conversions themselves are straight loops.
+//-------------------------------------------------------------------
+void Ros_CtrlGroup_InitializeConversionTables(CtrlGroup* ctrlGroup)
 {
+    JointOrderMap* map = &ctrlGroup->jointOrder;
     int i;
-    double conversion = 1;
-
-    bzero(rosPos, sizeof(double) * MAX_PULSE_AXES);
 
-    //Delta: (SLU--T-) All rotary axes
-    //Scara: (SLUR---) U-axis is linear
-    //Large Palletizing: (SLU--T-) All rotary axes
-    //High Speed Picking: (SLU-BT-) All rotary axes
+    ctrlGroup->numValidAxes = 0;
     for (i = 0; i < MAX_PULSE_AXES; i += 1)
     {
-        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
-        {
-            continue;
-        }
-
         if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
-            conversion = ctrlGroup->pulseToRad.PtoR[i];
+            ctrlGroup->pulsePerUnit[i] = ctrlGroup->pulseToRad.PtoR[i];
         else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
-            conversion = ctrlGroup->pulseToMeter.PtoM[i];
+            ctrlGroup->pulsePerUnit[i] = ctrlGroup->pulseToMeter.PtoM[i];
         else
-            conversion = 1.0;
+            ctrlGroup->pulsePerUnit[i] = 1.0;
 
-        rosPos[i] = motopulsePos[i] / conversion;
+        if (!Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
+        {
+            ctrlGroup->validAxes[ctrlGroup->numValidAxes] = i;
+            ctrlGroup->numValidAxes += 1;
+        }
     }
 
-}
-
-void Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(CtrlGroup* ctrlGroup, double const motoPos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
-{
-    int i;
-
+    map->numJoints = 0;
     if ((ctrlGroup->numAxes == 7) && Ros_CtrlGroup_IsRobot(ctrlGroup)) //is robot, and is 7 axis
     {
-        // Adjust joint order for 7 axis robot (SLURBTE > SLEURBT); All rotary axes
-
-        for (i = 0; i < ctrlGroup->numAxes; i++)
+        // Adjust joint order for 7 axis robot (SLURBTE <> SLEURBT); All rotary axes
+        for (i = 0; i < ctrlGroup->numAxes; i += 1)
         {
+            map->rosIndex[i] = i;
             if (i < 2)
-                rosPos[i] = motoPos[i];
+                map->motoIndex[i] = i;
             else if (i == 2)
-                rosPos[2] = motoPos[6];
+                map->motoIndex[i] = 6;
             else
-                rosPos[i] = motoPos[i - 1];
+                map->motoIndex[i] = i - 1;
         }
+        map->numJoints = ctrlGroup->numAxes;
     }
     else if (Ros_CtrlGroup_IsRobot(ctrlGroup) && ctrlGroup->numAxes < 6)
     {
-        //Delta: (SLU--T- > SLUT---) All rotary axes
-        //Scara: (SLUR--- > SLUR---) U-axis is linear
-        //Large Palletizing: (SLU--T- > SLUT---) All rotary axes
-        //High Speed Picking: (SLU-BT- > SLUBT--) All rotary axes
-
-        int rpi = 0; //rosPos index
+        //Delta: (SLU--T- <> SLUT---) All rotary axes
+        //Scara: (SLUR--- <> SLUR---) U-axis is linear
+        //Large Palletizing: (SLU--T- <> SLUT---) All rotary axes
+        //High Speed Picking: (SLU-BT- <> SLUBT--) All rotary axes
         int mpi = 0; //motopos index
 
-        for (i = 0; i < ctrlGroup->numAxes; i += 1, rpi += 1, mpi += 1)
+        for (i = 0; i < ctrlGroup->numAxes; i += 1, mpi += 1)
         {
-            while (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, mpi))
-            {
+            while (mpi < MAX_PULSE_AXES && Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, mpi))
                 mpi += 1;
-                if (mpi >= MAX_PULSE_AXES)
-                    return;
-            }
 
-            rosPos[rpi] = motoPos[mpi];
+            if (mpi >= MAX_PULSE_AXES)
+                break;
+
+            map->rosIndex[i] = i;
+            map->motoIndex[i] = mpi;
+            map->numJoints += 1;
         }
     }
     else
     {
-        for (i = 0; i < MAX_PULSE_AXES; i++)
+        for (i = 0; i < MAX_PULSE_AXES; i += 1)
         {
-            rosPos[i] = motoPos[i];
+            map->rosIndex[i] = i;
+            map->motoIndex[i] = i;
         }
+        map->numJoints = MAX_PULSE_AXES;
+    }
+
+    //the position of an invalid axis is always 0, so it doesn't need to be copied
+    ctrlGroup->validJointOrder.numJoints = 0;
+    for (i = 0; i < map->numJoints; i += 1)
+    {
+        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, map->motoIndex[i]))
+            continue;
+
+        int j = ctrlGroup->validJointOrder.numJoints;
+        ctrlGroup->validJointOrder.rosIndex[j] = map->rosIndex[i];
+        ctrlGroup->validJointOrder.motoIndex[j] = map->motoIndex[i];
+        ctrlGroup->validJointOrder.numJoints += 1;
+    }
+}
+
+//Convert the Motoman position units (pulses) to ROS position units (radians/meters).
+//The joints are kept in Motoman (non-sequential) ordering. Invalid axes are set to 0.
+void Ros_CtrlGroup_ConvertMotoUnitsToRosUnits(CtrlGroup* ctrlGroup, long const motopulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
+{
+    bzero(rosPos, sizeof(double) * MAX_PULSE_AXES);
+
+    for (int i = 0; i < ctrlGroup->numValidAxes; i += 1)
+    {
+        int axis = ctrlGroup->validAxes[i];
+        rosPos[axis] = motopulsePos[axis] / ctrlGroup->pulsePerUnit[axis];
     }
 }
 
+//Reorder the joint data. Joints without a position in the sequential ordering are set to 0.
+void Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(CtrlGroup* ctrlGroup, double const motoPos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
+{
+    JointOrderMap const* map = &ctrlGroup->jointOrder;
+
+    bzero(rosPos, sizeof(double) * MAX_PULSE_AXES);
+
+    for (int i = 0; i < map->numJoints; i += 1)
+        rosPos[map->rosIndex[i]] = motoPos[map->motoIndex[i]];
+}
+
 // Convert Motoman position in pulse to Ros position in radian/meters
 // In the case of a 7, 4, or 5 axis robot, adjust the order to match
 // the physical axis sequence
 //-------------------------------------------------------------------
 void Ros_CtrlGroup_ConvertToRosPos(CtrlGroup* ctrlGroup, long const motopulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
 {
-    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
+    JointOrderMap const* map = &ctrlGroup->validJointOrder;
 
-    //call this first, due to expected joint ordering 
-    Ros_CtrlGroup_ConvertMotoUnitsToRosUnits(ctrlGroup, motopulsePos, rosUnitsWithMotoOrder);
+    bzero(rosPos, sizeof(double) * MAX_PULSE_AXES);
 
-    Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(ctrlGroup, rosUnitsWithMotoOrder, rosPos);
+    //conversion and reordering in one pass
+    for (int i = 0; i < map->numJoints; i += 1)
+    {
+        int axis = map->motoIndex[i];
+        rosPos[map->rosIndex[i]] = motopulsePos[axis] / ctrlGroup->pulsePerUnit[axis];
+    }
 }
 
 // Convert Motoman torque to ROS torque by re-ordering the joints
@@ -602,86 +652,26 @@ void Ros_CtrlGroup_ConvertToRosTorque(CtrlGroup* ctrlGroup, double const motoTor
 }
 
 //Convert the ROS position units (radians/meters) to Motoman position units (pulses).
-//This function must be called AFTER calling Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder.
-//The joints must be in Motoman (non-sequential) ordering.
+//The joints must be in Motoman (non-sequential) ordering. Invalid axes are set to 0.
 void Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(CtrlGroup* ctrlGroup, double const rosPos[MAX_PULSE_AXES], long motopulsePos[MAX_PULSE_AXES])
 {
-    double conversion = 1;
-
     bzero(motopulsePos, sizeof(long) * MAX_PULSE_AXES);
 
-    //Delta: (SLU--T-) All rotary axes
-    //Scara: (SLUR---) U-axis is linear
-    //Large Palletizing: (SLU--T-) All rotary axes
-    //High Speed Picking: (SLU-BT-) All rotary axes
-    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+    for (int i = 0; i < ctrlGroup->numValidAxes; i += 1)
     {
-        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
-        {
-            continue;
-        }
-
-        if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
-            conversion = ctrlGroup->pulseToRad.PtoR[i];
-        else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
-            conversion = ctrlGroup->pulseToMeter.PtoM[i];
-        else
-            conversion = 1.0;
-
-        motopulsePos[i] = (int)(rosPos[i] * conversion);
+        int axis = ctrlGroup->validAxes[i];
+        motopulsePos[axis] = (int)(rosPos[axis] * ctrlGroup->pulsePerUnit[axis]);
     }
 }
 
 void Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(CtrlGroup* ctrlGroup, double const rosPos[MAX_PULSE_AXES], double motoPos[MAX_PULSE_AXES])
 {
-    int i;
+    JointOrderMap const* map = &ctrlGroup->jointOrder;
 
-    // Initialize memory space
     bzero(motoPos, sizeof(double) * MAX_PULSE_AXES);
 
-    if ((ctrlGroup->numAxes == 7) && Ros_CtrlGroup_IsRobot(ctrlGroup))
-    {
-        // Adjust joint order for 7 axis robot (SLEURBT > SLURBTE); All rotary axes
-
-        for (i = 0; i < ctrlGroup->numAxes; i++)
-        {
-            if (i < 2)
-                motoPos[i] = rosPos[i];
-            else if (i == 2)
-                motoPos[6] = rosPos[2];
-            else
-                motoPos[i - 1] = rosPos[i];
-        }
-    }
-    else if (Ros_CtrlGroup_IsRobot(ctrlGroup) && ctrlGroup->numAxes < 6)
-    {
-        //Delta: (SLUT--- > SLU--T-) All rotary axes
-        //Scara: (SLUR--- > SLUR---) U-axis is linear
-        //Large Palletizing: (SLUT--- > SLU--T-) All rotary axes
-        //High Speed Picking: (SLUBT-- > SLU-BT-) All rotary axes
-
-        int rpi = 0; //radpos index
-        int mpi = 0; //motopos index
-
-        for (i = 0; i < ctrlGroup->numAxes; i += 1, rpi += 1, mpi += 1)
-        {
-            while (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, mpi))
-            {
-                mpi += 1;
-                if (mpi >= MAX_PULSE_AXES)
-                    return;
-            }
-
-            motoPos[mpi] = rosPos[rpi];
-        }
-    }
-    else
-    {
-        for (i = 0; i < MAX_PULSE_AXES; i++)
-        {
-            motoPos[i] = rosPos[i];
-        }
-    }
+    for (int i = 0; i < map->numJoints; i += 1)
+        motoPos[map->motoIndex[i]] = rosPos[map->rosIndex[i]];
 }
 
 //-------------------------------------------------------------------
@@ -691,12 +681,16 @@ void Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(CtrlGroup* ctrlGr
 //-------------------------------------------------------------------
 void Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(CtrlGroup* ctrlGroup, double const radPos[MAX_PULSE_AXES], long motopulsePos[MAX_PULSE_AXES])
 {
-    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
+    JointOrderMap const* map = &ctrlGroup->validJointOrder;
 
-    Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(ctrlGroup, radPos, rosUnitsWithMotoOrder);
+    bzero(motopulsePos, sizeof(long) * MAX_PULSE_AXES);
 
-    //must call this after Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder due to expected joint ordering
-    Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(ctrlGroup, rosUnitsWithMotoOrder, motopulsePos);
+    //reordering and conversion in one pass
+    for (int i = 0; i < map->numJoints; i += 1)
+    {
+        int axis = map->motoIndex[i];
+        motopulsePos[axis] = (int)(radPos[map->rosIndex[i]] * ctrlGroup->pulsePerUnit[axis]);
+    }
 }
 
 //-------------------------------------------------------------------
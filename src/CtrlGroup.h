@@ -23,6 +23,8 @@
 #define MAX_JOINT_NAME_LENGTH               32
 #define MAX_TF_FRAME_NAME_LENGTH            96
 
+#define SIZEOF_TRAJECTORY_BUFFER            (sizeof(JointMotionData) * MAX_NUMBER_OF_POINTS_PER_TRAJECTORY)
+
 typedef struct
 {
     UINT64 time;
@@ -49,6 +51,14 @@ typedef struct
     double vel[MP_GRP_AXES_NUM];    // velocity in radians/s
 } JointMotionData;
 
+// Mapping between the motoman (non-sequential) and ROS (sequential) joint order
+typedef struct
+{
+    int numJoints;                              // number of valid entries in rosIndex and motoIndex
+    int rosIndex[MAX_PULSE_AXES];               // index of the joint in ROS joint order
+    int motoIndex[MAX_PULSE_AXES];              // index of the same joint in motoman joint order
+} JointOrderMap;
+
 //---------------------------------------------------------------
 // CtrlGroup:
 // Structure containing all the data related to a control group
@@ -70,12 +80,23 @@ typedef struct
 
     JointMotionData* trajectoryIterator;        // joint motion command data in radian
     JointMotionData* prevTrajectoryIterator;    // joint motion command data in radian
-    JointMotionData trajectoryToProcess[MAX_NUMBER_OF_POINTS_PER_TRAJECTORY];   // joint motion command data in radian to process
+    JointMotionData* trajectoryToProcess;       // joint motion command data in radian to process (points into trajectoryBuffers)
+    JointMotionData* trajectoryToStage;         // converted data of the next trajectory, waiting for the active one to finish (points into trajectoryBuffers)
+    JointMotionData trajectoryBuffers[2][MAX_NUMBER_OF_POINTS_PER_TRAJECTORY];  // storage for the active and the staged trajectory
+    BOOL bCartesianTrajectory;                  // trajectoryToProcess contains TCP poses (see CARTESIAN_IDX_*) instead of joint positions
+    double cartesianIncRemainder[MP_GRP_AXES_NUM]; // fraction of a cartesian increment unit that was not sent yet (rounding)
 
     BOOL hasDataToProcess;                      // indicates that there is data to process
     UINT64 timeLeftover_ms;                     // Time left over after reaching the end of a trajectory to complete the interpolation period
     long prevPulsePos[MAX_PULSE_AXES];          // The commanded pulse position that the trajectory starts at (Ros_MotionServer_StartTrajMode)
     AXIS_MOTION_TYPE axisType;                  // Indicates whether axis is rotary or linear
+
+    //Conversion tables, derived from axisType and the pulse ratios by Ros_CtrlGroup_InitializeConversionTables
+    int numValidAxes;                           // number of entries in validAxes
+    int validAxes[MAX_PULSE_AXES];              // indices of the axes which are not AXIS_INVALID (motoman joint order)
+    double pulsePerUnit[MAX_PULSE_AXES];        // pulses per radian (rotary) or meter (linear) (motoman joint order)
+    JointOrderMap jointOrder;                   // reordering of joint data between motoman and ROS order
+    JointOrderMap validJointOrder;              // same as jointOrder, restricted to valid axes (positions of invalid axes are always 0)
     char jointNames_userDefined[MP_GRP_AXES_NUM][MAX_JOINT_NAME_LENGTH]; //string name for each joint in 'moto' (non-sequential) joint order
 
     BOOL bIsBaxisSlave;                         // Indicates the B axis will automatically move to maintain orientation as other axes are moved
@@ -109,18 +130,23 @@ typedef struct
 //  BOOL bIsLastGrpToInit: TRUE if this is the final group that is being initialized. FALSE if you plan to call this function again.
 //  float interpolPeriod: Value of the interpolation period (ms) for the robot controller.
 extern CtrlGroup* Ros_CtrlGroup_Create(int groupNo, BOOL bIsLastGrpToInit, float interpolPeriod);
-extern void Ros_CtrlGrp_Cleanup(CtrlGroup* ctrlGroup);
 
 extern MP_GRP_ID_TYPE Ros_mpCtrlGrpNo2GrpId(int groupNo);
 
 extern BOOL Ros_CtrlGroup_GetPulsePosCmd(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES]);
+extern void Ros_CtrlGroup_CompensateBaxisCmd(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES]);
 extern BOOL Ros_CtrlGroup_GetFBPulsePos(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES]);
 extern BOOL Ros_CtrlGroup_GetFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PULSE_AXES]);
+extern void Ros_CtrlGroup_ConvertSpeedRegistersToPulse(CtrlGroup const* const ctrlGroup, USHORT const registerValues[MAX_PULSE_AXES * 2], long pulseSpeed[MAX_PULSE_AXES]);
 
 extern BOOL Ros_CtrlGroup_GetTorque(CtrlGroup* ctrlGroup, double torqueValues[MAX_PULSE_AXES]);
 
 extern BOOL Ros_CtrlGroup_GetEncoderTemperature(CtrlGroup const* const ctrlGroup, long encoderTemp[MAX_PULSE_AXES]);
 
+//Derive the joint order mapping and unit conversion factors from axisType, pulseToRad and
+//pulseToMeter. Must be called again if any of those change.
+extern void Ros_CtrlGroup_InitializeConversionTables(CtrlGroup* ctrlGroup);
+
 extern void Ros_CtrlGroup_ConvertToRosPos(CtrlGroup* ctrlGroup, long const pulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES]);
 extern void Ros_CtrlGroup_ConvertToRosTorque(CtrlGroup* ctrlGroup, double const motoTorque[MAX_PULSE_AXES], double rosTorque[MAX_PULSE_AXES]);
 extern void Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(CtrlGroup* ctrlGroup, double const radPos[MAX_PULSE_AXES], long pulsePos[MAX_PULSE_AXES]);
@@ -35,57 +35,690 @@ void Ros_Debug_Init()
     ros_debug_destAddr1.sin_port = mpHtons(DEBUG_UDP_PORT_NUMBER);
 }
 
-void Ros_Debug_BroadcastMsg(char* fmt, ...)
+//Timestamp (in nanoseconds since the epoch) for a message logged now.
+//The timestamp for the message "Found Micro-Ros PC Agent" will be the epoch time (THU 1970-01-01 00:00:00.000) as the global flags 
+//are set to indicate that the Micro-Ros PC Agent is connected but the first sync of the host time using the micro-ROS agent is yet to occur
+static INT64 Ros_Debug_Timestamp()
+{
+    struct timespec tp;
+
+    if (g_Ros_Communication_AgentIsConnected)
+    {
+        //get synchronized time from the agent
+        return Ros_ClockSync_Now();
+    }
+
+    //the clock cannot sync with agent because it's not connected
+    clock_gettime(CLOCK_REALTIME, &tp);
+    return ((INT64)tp.tv_sec * 1000000000LL) + (INT64)tp.tv_nsec;
+}
+
+static void Ros_Debug_Send(INT64 timestamp_ns, char const* msg)
 {
     char str[MAX_DEBUG_MESSAGE_SIZE];
+    struct tm synced_time;
+    struct timespec tp;
+    size_t timestamp_length;
+
+    if (ros_DebugSocket == -1)
+        Ros_Debug_Init();
+
+    // Timestamp, followed by the message
+    Ros_Nanos_To_Timespec(timestamp_ns, &tp);
+    localtime_r(&tp.tv_sec, &synced_time);
+    strftime(str, FORMATTED_TIME_SIZE, "%Y-%m-%d %H:%M:%S", &synced_time);
+    timestamp_length = strlen(str);
+    snprintf(str + timestamp_length, MAX_DEBUG_MESSAGE_SIZE - timestamp_length, ".%06d %s", (int)tp.tv_nsec / 1000, msg);
+
+    mpSendTo(ros_DebugSocket, str, strlen(str), 0, (struct sockaddr*) &ros_debug_destAddr1, sizeof(struct sockaddr_in));
+
+    if (g_nodeConfigSettings.log_to_stdout)
+        puts(str);
+}
+
+void Ros_Debug_SendDatagram(void const* data, size_t length)
+{
+    if (ros_DebugSocket == -1)
+        Ros_Debug_Init();
+
+    mpSendTo(ros_DebugSocket, (char*)data, length, 0, (struct sockaddr*) &ros_debug_destAddr1, sizeof(struct sockaddr_in));
+}
+
+//==========================================================
+//Deferred formatting
+//
+//The arguments of a message are copied according to the conversions in its format string.
+//The same parser is used when formatting the message, so both agree on the type (and
+//number) of the arguments.
+typedef enum
+{
+    DEBUG_ARG_NONE,         //'%%'
+    DEBUG_ARG_INT,          //also char, short and their unsigned versions (promoted to int)
+    DEBUG_ARG_LONG,
+    DEBUG_ARG_LONGLONG,
+    DEBUG_ARG_SIZE,
+    DEBUG_ARG_DOUBLE,
+    DEBUG_ARG_STRING,
+    DEBUG_ARG_POINTER,
+    DEBUG_ARG_UNSUPPORTED,  //'%n', long double
+} Debug_ArgType;
+
+typedef struct
+{
+    int length;             //of the complete conversion specification, including the '%'
+    Debug_ArgType type;
+    BOOL bStarWidth;
+    BOOL bStarPrecision;
+} Debug_Conversion;
+
+typedef union
+{
+    INT64 integer;
+    double real;
+    void* pointer;
+    UINT16 stringOffset;    //in Debug_LogEntry::strings
+} Debug_LogArg;
+
+typedef struct
+{
+    volatile UINT32 sequence;   //see Ros_Debug_QueueMsg
+    const char* fmt;
+    INT64 timestamp_ns;
+    Debug_Level level;
+    UINT32 numSuppressed;
+    UINT8 numArgs;
+    BOOL bTruncated;            //too many arguments, or not enough space for the strings
+    UINT16 stringSpaceUsed;
+    Debug_LogArg args[DEBUG_LOG_MAX_ARGS];
+    char strings[DEBUG_LOG_STRING_SPACE];
+} Debug_LogEntry;
+
+static Debug_LogEntry debug_logQueue[DEBUG_LOG_QUEUE_SIZE];
+static volatile UINT32 debug_logEnqueuePos = 0;
+static UINT32 debug_logDequeuePos = 0;  //only used by the log task
+static volatile UINT32 debug_logNumDropped = 0;
+static volatile BOOL debug_bLogTaskRunning = FALSE;
+
+//'spec' points to the '%'
+static void Ros_Debug_ParseConversion(const char* spec, Debug_Conversion* conv)
+{
+    const char* p = spec + 1;
+
+    conv->bStarWidth = FALSE;
+    conv->bStarPrecision = FALSE;
+
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+        p++;
+
+    if (*p == '*')
+    {
+        conv->bStarWidth = TRUE;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+        p++;
+
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            conv->bStarPrecision = TRUE;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9')
+            p++;
+    }
+
+    Debug_ArgType intType = DEBUG_ARG_INT;
+    if (*p == 'h')
+    {
+        p += (p[1] == 'h') ? 2 : 1;
+    }
+    else if (*p == 'l')
+    {
+        intType = (p[1] == 'l') ? DEBUG_ARG_LONGLONG : DEBUG_ARG_LONG;
+        p += (p[1] == 'l') ? 2 : 1;
+    }
+    else if (*p == 'j')
+    {
+        intType = DEBUG_ARG_LONGLONG;
+        p++;
+    }
+    else if (*p == 'z' || *p == 't')
+    {
+        intType = DEBUG_ARG_SIZE;
+        p++;
+    }
+    else if (*p == 'L')
+    {
+        intType = DEBUG_ARG_UNSUPPORTED;
+        p++;
+    }
+
+    switch (*p)
+    {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+        conv->type = intType;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        conv->type = (intType == DEBUG_ARG_UNSUPPORTED) ? DEBUG_ARG_UNSUPPORTED : DEBUG_ARG_DOUBLE;
+        break;
+    case 's':
+        conv->type = DEBUG_ARG_STRING;
+        break;
+    case 'p':
+        conv->type = DEBUG_ARG_POINTER;
+        break;
+    case '%':
+        conv->type = DEBUG_ARG_NONE;
+        break;
+    case '\0':
+        //incomplete specification at the end of the format
+        conv->type = DEBUG_ARG_UNSUPPORTED;
+        conv->length = (int)(p - spec);
+        return;
+    default:
+        conv->type = DEBUG_ARG_UNSUPPORTED;
+        break;
+    }
+
+    conv->length = (int)(p - spec) + 1;
+}
+
+static BOOL Ros_Debug_CaptureArg(Debug_LogEntry* entry, Debug_ArgType type, va_list* va)
+{
+    Debug_LogArg* arg;
+
+    if (entry->numArgs >= DEBUG_LOG_MAX_ARGS)
+        return FALSE;
+    arg = &entry->args[entry->numArgs];
+
+    switch (type)
+    {
+    case DEBUG_ARG_INT:
+        arg->integer = va_arg(*va, int);
+        break;
+    case DEBUG_ARG_LONG:
+        arg->integer = va_arg(*va, long);
+        break;
+    case DEBUG_ARG_LONGLONG:
+        arg->integer = va_arg(*va, long long);
+        break;
+    case DEBUG_ARG_SIZE:
+        arg->integer = (INT64)va_arg(*va, size_t);
+        break;
+    case DEBUG_ARG_DOUBLE:
+        arg->real = va_arg(*va, double);
+        break;
+    case DEBUG_ARG_POINTER:
+        arg->pointer = va_arg(*va, void*);
+        break;
+    case DEBUG_ARG_STRING:
+    {
+        const char* str = va_arg(*va, const char*);
+        size_t space = DEBUG_LOG_STRING_SPACE - entry->stringSpaceUsed;
+        size_t len;
+
+        if (str == NULL)
+            str = "(null)";
+        len = Ros_strnlen(str, space);
+        if (len >= space)
+        {
+            //no room for the terminator: truncate
+            entry->bTruncated = TRUE;
+            if (space == 0)
+                return FALSE;
+            len = space - 1;
+        }
+        memcpy(&entry->strings[entry->stringSpaceUsed], str, len);
+        entry->strings[entry->stringSpaceUsed + len] = '\0';
+        arg->stringOffset = entry->stringSpaceUsed;
+        entry->stringSpaceUsed += len + 1;
+        break;
+    }
+    default:
+        return FALSE;
+    }
+
+    entry->numArgs += 1;
+    return TRUE;
+}
+
+static void Ros_Debug_CaptureArgs(Debug_LogEntry* entry, va_list* va)
+{
+    const char* p = entry->fmt;
+    Debug_Conversion conv;
+
+    entry->numArgs = 0;
+    entry->bTruncated = FALSE;
+    entry->stringSpaceUsed = 0;
+
+    for (p = strchr(p, '%'); p != NULL; p = strchr(p + conv.length, '%'))
+    {
+        Ros_Debug_ParseConversion(p, &conv);
+
+        if (conv.type == DEBUG_ARG_NONE)
+            continue;
+
+        if ((conv.bStarWidth && !Ros_Debug_CaptureArg(entry, DEBUG_ARG_INT, va)) ||
+            (conv.bStarPrecision && !Ros_Debug_CaptureArg(entry, DEBUG_ARG_INT, va)) ||
+            !Ros_Debug_CaptureArg(entry, conv.type, va))
+        {
+            entry->bTruncated = TRUE;
+            return;
+        }
+    }
+}
+
+//Formats a single conversion, with the arguments starting at 'entry->args[*argIndex]'.
+//Returns FALSE if the arguments ran out.
+static BOOL Ros_Debug_FormatConversion(Debug_LogEntry const* entry, const char* spec, Debug_Conversion const* conv,
+    int* argIndex, char* out, size_t outSize)
+{
+    char convSpec[32];
+    int starArgs[2];
+    int numStarArgs = 0;
+    Debug_LogArg const* arg;
+
+    if (conv->type == DEBUG_ARG_NONE)
+    {
+        snprintf(out, outSize, "%%");
+        return TRUE;
+    }
+
+    if (conv->length >= (int)sizeof(convSpec))
+        return FALSE;
+    memcpy(convSpec, spec, conv->length);
+    convSpec[conv->length] = '\0';
+
+    if (conv->bStarWidth)
+        starArgs[numStarArgs++] = 0;
+    if (conv->bStarPrecision)
+        starArgs[numStarArgs++] = 0;
+    if (*argIndex + numStarArgs >= entry->numArgs)
+        return FALSE;
+    for (int i = 0; i < numStarArgs; i += 1)
+        starArgs[i] = (int)entry->args[(*argIndex)++].integer;
+    arg = &entry->args[(*argIndex)++];
+
+#define DEBUG_FORMAT_ARG(value) \
+    do { \
+        if (numStarArgs == 0) snprintf(out, outSize, convSpec, value); \
+        else if (numStarArgs == 1) snprintf(out, outSize, convSpec, starArgs[0], value); \
+        else snprintf(out, outSize, convSpec, starArgs[0], starArgs[1], value); \
+    } while (0)
+
+    switch (conv->type)
+    {
+    case DEBUG_ARG_INT:
+        DEBUG_FORMAT_ARG((int)arg->integer);
+        break;
+    case DEBUG_ARG_LONG:
+        DEBUG_FORMAT_ARG((long)arg->integer);
+        break;
+    case DEBUG_ARG_LONGLONG:
+        DEBUG_FORMAT_ARG((long long)arg->integer);
+        break;
+    case DEBUG_ARG_SIZE:
+        DEBUG_FORMAT_ARG((size_t)arg->integer);
+        break;
+    case DEBUG_ARG_DOUBLE:
+        DEBUG_FORMAT_ARG(arg->real);
+        break;
+    case DEBUG_ARG_POINTER:
+        DEBUG_FORMAT_ARG(arg->pointer);
+        break;
+    case DEBUG_ARG_STRING:
+        DEBUG_FORMAT_ARG(&entry->strings[arg->stringOffset]);
+        break;
+    default:
+        return FALSE;
+    }
+#undef DEBUG_FORMAT_ARG
+
+    return TRUE;
+}
+
+//Informational messages are sent without a prefix, as they were before levels existed
+static const char* Ros_Debug_LevelPrefix(Debug_Level level)
+{
+    switch (level)
+    {
+    case DEBUG_LEVEL_DEBUG:
+        return "DEBUG: ";
+    case DEBUG_LEVEL_WARNING:
+        return "WARNING: ";
+    case DEBUG_LEVEL_ERROR:
+        return "ERROR: ";
+    default:
+        return "";
+    }
+}
+
+static void Ros_Debug_AppendSuppressed(UINT32 numSuppressed, char* str, size_t size)
+{
+    size_t len = strlen(str);
+
+    if (numSuppressed > 0)
+        snprintf(str + len, size - len, " (%u similar message(s) suppressed)", (unsigned int)numSuppressed);
+}
+
+static void Ros_Debug_FormatEntry(Debug_LogEntry const* entry, char* str, size_t size)
+{
+    const char* p = entry->fmt;
+    size_t len;
+    int argIndex = 0;
+    Debug_Conversion conv;
+
+    snprintf(str, size, "%s", Ros_Debug_LevelPrefix(entry->level));
+    len = strlen(str);
+    while (*p != '\0' && len < size - 1)
+    {
+        const char* spec = strchr(p, '%');
+        size_t literal = (spec == NULL) ? strlen(p) : (size_t)(spec - p);
+
+        if (literal > size - 1 - len)
+            literal = size - 1 - len;
+        memcpy(str + len, p, literal);
+        len += literal;
+        str[len] = '\0';
+        if (spec == NULL)
+            break;
+
+        Ros_Debug_ParseConversion(spec, &conv);
+        if (!Ros_Debug_FormatConversion(entry, spec, &conv, &argIndex, str + len, size - len))
+            break;
+        len += strlen(str + len);
+        p = spec + conv.length;
+    }
+
+    if (entry->bTruncated)
+        snprintf(str + len, size - len, " [truncated]");
+    Ros_Debug_AppendSuppressed(entry->numSuppressed, str, size);
+}
+
+//Multi-producer, single-consumer queue. Every entry has a sequence number, which tells
+//producers whether the entry is free for position 'pos' (sequence == pos), and the log task
+//whether it has been filled (sequence == pos + 1). Producers claim a position with a
+//compare-and-swap, so they never block each other, nor the log task.
+void Ros_Debug_QueueMsg(Debug_Level level, UINT32 numSuppressed, const char* fmt, ...)
+{
+    Debug_LogEntry* entry;
+    UINT32 pos;
     va_list va;
 
-    bzero(str, MAX_DEBUG_MESSAGE_SIZE);
+    if (!debug_bLogTaskRunning)
+    {
+        //format and send right away
+        char str[MAX_DEBUG_MESSAGE_SIZE];
+        INT64 timestamp_ns = Ros_Debug_Timestamp();
+        size_t len;
+
+        snprintf(str, MAX_DEBUG_MESSAGE_SIZE, "%s", Ros_Debug_LevelPrefix(level));
+        len = strlen(str);
+        va_start(va, fmt);
+        vsnprintf(str + len, MAX_DEBUG_MESSAGE_SIZE - len, fmt, va);
+        va_end(va);
+        Ros_Debug_AppendSuppressed(numSuppressed, str, MAX_DEBUG_MESSAGE_SIZE);
+        Ros_Debug_Send(timestamp_ns, str);
+        return;
+    }
 
+    pos = debug_logEnqueuePos;
+    FOREVER
+    {
+        entry = &debug_logQueue[pos & (DEBUG_LOG_QUEUE_SIZE - 1)];
+        INT32 diff = (INT32)(entry->sequence - pos);
+
+        if (diff == 0)
+        {
+            if (__sync_bool_compare_and_swap(&debug_logEnqueuePos, pos, pos + 1))
+                break;
+            pos = debug_logEnqueuePos;
+        }
+        else if (diff < 0)
+        {
+            //queue is full
+            __sync_fetch_and_add(&debug_logNumDropped, 1);
+            return;
+        }
+        else
+        {
+            //another producer claimed this position
+            pos = debug_logEnqueuePos;
+        }
+    }
+
+    entry->fmt = fmt;
+    entry->timestamp_ns = Ros_Debug_Timestamp();
+    entry->level = level;
+    entry->numSuppressed = numSuppressed;
     va_start(va, fmt);
-    vsnprintf(str, MAX_DEBUG_MESSAGE_SIZE, fmt, va);
+    Ros_Debug_CaptureArgs(entry, &va);
     va_end(va);
 
-    if (ros_DebugSocket == -1)
-        Ros_Debug_Init();
+    __sync_synchronize();
+    entry->sequence = pos + 1;
+}
 
-    // Timestamp
-    //The timestamp for the message "Found Micro-Ros PC Agent" will be the epoch time (THU 1970-01-01 00:00:00.000) as the global flags 
-    //are set to indicate that the Micro-Ros PC Agent is connected but the first sync of the host time using the micro-ROS agent is yet to occur
-    struct tm synced_time;
-    struct timespec tp;
-    char timestamp[FORMATTED_TIME_SIZE];
-    if (g_Ros_Communication_AgentIsConnected)
+void Ros_Debug_RunLogTask()
+{
+    char str[MAX_DEBUG_MESSAGE_SIZE];
+    UINT32 numDroppedReported = 0;
+
+    FOREVER
     {
-        //get synchronized time from the agent
-        int64_t nanosecs = rmw_uros_epoch_nanos();
-        Ros_Nanos_To_Timespec(nanosecs, &tp);
+        Debug_LogEntry* entry = &debug_logQueue[debug_logDequeuePos & (DEBUG_LOG_QUEUE_SIZE - 1)];
+
+        //send everything that's been queued (and completely filled in) so far
+        while (entry->sequence == debug_logDequeuePos + 1)
+        {
+            Ros_Debug_FormatEntry(entry, str, MAX_DEBUG_MESSAGE_SIZE);
+            Ros_Debug_Send(entry->timestamp_ns, str);
+
+            __sync_synchronize();
+            entry->sequence = debug_logDequeuePos + DEBUG_LOG_QUEUE_SIZE;
+            debug_logDequeuePos += 1;
+            entry = &debug_logQueue[debug_logDequeuePos & (DEBUG_LOG_QUEUE_SIZE - 1)];
+        }
+
+        UINT32 numDropped = debug_logNumDropped;
+        if (numDropped != numDroppedReported)
+        {
+            snprintf(str, MAX_DEBUG_MESSAGE_SIZE, "Debug log: %u message(s) dropped, queue was full (%u in total)",
+                (unsigned int)(numDropped - numDroppedReported), (unsigned int)numDropped);
+            Ros_Debug_Send(Ros_Debug_Timestamp(), str);
+            numDroppedReported = numDropped;
+        }
+
+        Ros_Telemetry_Flush();
+#ifdef MOTOROS2_TASK_TRACE_ENABLE
+        Ros_TaskTrace_Flush();
+#endif
+
+        Ros_Sleep(PERIOD_DEBUG_LOG_SENDER_MS);
     }
-    else
+}
+
+void Ros_Debug_StartLogTask()
+{
+    if (debug_bLogTaskRunning)
+        return;
+
+    for (UINT32 i = 0; i < DEBUG_LOG_QUEUE_SIZE; i += 1)
+        debug_logQueue[i].sequence = i;
+    debug_logEnqueuePos = 0;
+    debug_logDequeuePos = 0;
+
+    int tid = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE, (FUNCPTR)Ros_Debug_RunLogTask,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    if (tid == ERROR)
     {
-        //rmw_uros_epoch_nanos cannot sync with agent because it's not connected
-        clock_gettime(CLOCK_REALTIME, &tp);
+        mpSetAlarm(ALARM_TASK_CREATE_FAIL, APPLICATION_NAME " FAILED TO CREATE TASK", SUBCODE_DEBUG_LOG);
+        return;
     }
-    localtime_r(&tp.tv_sec, &synced_time);
-    strftime(timestamp, FORMATTED_TIME_SIZE, "%Y-%m-%d %H:%M:%S", &synced_time);
-    snprintf(timestamp + strlen(timestamp), FORMATTED_TIME_SIZE - strlen(timestamp), ".%06d ", (int)tp.tv_nsec / 1000);
 
-    // Pre - pending the timestamp to the debug message
-    size_t timestamp_length = Ros_strnlen(timestamp, FORMATTED_TIME_SIZE);
-    size_t debug_message_length = Ros_strnlen(str, MAX_DEBUG_MESSAGE_SIZE);
-    if (timestamp_length + debug_message_length + 1 < MAX_DEBUG_MESSAGE_SIZE)
+    debug_bLogTaskRunning = TRUE;
+}
+
+//==========================================================
+//Levels, modules and rate limiting
+
+typedef struct
+{
+    const char* fileName;   //a trailing '*' matches any suffix
+    Debug_Module module;
+} Debug_ModuleMapping;
+
+//Files which aren't listed here log to DEBUG_MODULE_GENERAL
+static const Debug_ModuleMapping debug_moduleMappings[] =
+{
+    { "CommunicationExecutor.c", DEBUG_MODULE_COMMUNICATION },
+    { "ClockSync.c", DEBUG_MODULE_COMMUNICATION },
+    { "ConfigFile.c", DEBUG_MODULE_CONFIG },
+    { "InformCheckerAndGenerator.c", DEBUG_MODULE_CONFIG },
+    { "ControllerStatusIO.c", DEBUG_MODULE_CONTROLLER },
+    { "ControllerSnapshot.c", DEBUG_MODULE_CONTROLLER },
+    { "CtrlGroup.c", DEBUG_MODULE_CONTROLLER },
+    { "Ros_mpGetRobotCalibrationData.c", DEBUG_MODULE_CONTROLLER },
+    { "RosMotoPlusConversionUtils.c", DEBUG_MODULE_CONTROLLER },
+    { "MotionControl.c", DEBUG_MODULE_MOTION },
+    { "ServiceQueueTrajPoint.c", DEBUG_MODULE_MOTION },
+    { "ServiceResetError.c", DEBUG_MODULE_MOTION },
+    { "ServiceSelectMotionTool.c", DEBUG_MODULE_MOTION },
+    { "ServiceStartPointQueueMode.c", DEBUG_MODULE_MOTION },
+    { "ServiceStartTrajMode.c", DEBUG_MODULE_MOTION },
+    { "ServiceStopTrajMode.c", DEBUG_MODULE_MOTION },
+    { "TwistServo.c", DEBUG_MODULE_MOTION },
+    { "ActionServer_FJT.c", DEBUG_MODULE_FJT },
+    { "PositionMonitor.c", DEBUG_MODULE_PUBLISHERS },
+    { "JointStateCapture.c", DEBUG_MODULE_PUBLISHERS },
+    { "CompactJointState.c", DEBUG_MODULE_PUBLISHERS },
+    { "IdlePublishing.c", DEBUG_MODULE_PUBLISHERS },
+    { "PublishScheduler.c", DEBUG_MODULE_PUBLISHERS },
+    { "ServiceReadWriteIO.c", DEBUG_MODULE_IO },
+    { "Tests_*", DEBUG_MODULE_TESTS },
+};
+
+static const char* const debug_levelNames[NUM_DEBUG_LEVELS] =
+{
+    "debug",
+    "info",
+    "warning",
+    "error",
+    "none",
+};
+
+static const char* const debug_moduleNames[NUM_DEBUG_MODULES] =
+{
+    "general",
+    "communication",
+    "config",
+    "controller",
+    "motion",
+    "fjt",
+    "publishers",
+    "io",
+    "tests",
+};
+
+//everything is sent until the configuration has been applied
+static volatile Debug_Level debug_thresholds[NUM_DEBUG_MODULES];
+static volatile int debug_rateLimit = 0;
+
+static Debug_Module Ros_Debug_LookupModule(const char* file)
+{
+    const char* baseName = file;
+
+    //__FILE__ may include the path (with either kind of separator)
+    for (const char* p = file; *p != '\0'; p++)
     {
-        // Move existing contents of str buffer to the end by Timestamp_Length to make space 
-        //for the timestamp and avoiding overwriting the debug message during the move 
-        memmove(str + timestamp_length, str, debug_message_length); 
-        // Copy the timestamp stored in Formatted_time buffer to the beginning of str buffer
-        memcpy(str, timestamp, timestamp_length);         
+        if (*p == '/' || *p == '\\')
+            baseName = p + 1;
     }
 
-    mpSendTo(ros_DebugSocket, str, strlen(str), 0, (struct sockaddr*) &ros_debug_destAddr1, sizeof(struct sockaddr_in));
+    for (int i = 0; i < (int)(sizeof(debug_moduleMappings) / sizeof(debug_moduleMappings[0])); i += 1)
+    {
+        const char* name = debug_moduleMappings[i].fileName;
+        size_t len = strlen(name);
 
-    if (g_nodeConfigSettings.log_to_stdout)
-        puts(str);
+        if (name[len - 1] == '*' ? (strncmp(baseName, name, len - 1) == 0) : (strcmp(baseName, name) == 0))
+            return debug_moduleMappings[i].module;
+    }
+    return DEBUG_MODULE_GENERAL;
+}
+
+INT32 Ros_Debug_CheckCallSite(Debug_CallSite* const callSite, Debug_Level level, const char* file)
+{
+    int rateLimit = debug_rateLimit;
+    UINT32 numSuppressed;
+
+    if (callSite->module < 0)
+        callSite->module = Ros_Debug_LookupModule(file);
+
+    if (level < debug_thresholds[callSite->module])
+        return -1;
+
+    if (rateLimit > 0)
+    {
+        ULONG tickNow = tickGet();
+
+        //A window starts with the first message sent in it. The ticks are compared unsigned,
+        //so this keeps working when the tick count wraps around.
+        if (callSite->numInWindow == 0 ||
+            (tickNow - callSite->tickWindowStart) >= (ULONG)(PERIOD_DEBUG_LOG_RATE_LIMIT_MS / mpGetRtc()))
+        {
+            callSite->tickWindowStart = tickNow;
+            callSite->numInWindow = 0;
+        }
+
+        if (callSite->numInWindow >= (UINT32)rateLimit)
+        {
+            callSite->numSuppressed += 1;
+            return -1;
+        }
+        callSite->numInWindow += 1;
+    }
+
+    numSuppressed = callSite->numSuppressed;
+    callSite->numSuppressed = 0;
+    return (INT32)numSuppressed;
+}
+
+void Ros_Debug_ApplyConfiguration()
+{
+    for (int i = 0; i < NUM_DEBUG_MODULES; i += 1)
+    {
+        int moduleLevel = g_nodeConfigSettings.module_log_levels[i];
+        debug_thresholds[i] = (moduleLevel == CFG_LOG_LEVEL_DEFAULT) ? g_nodeConfigSettings.log_level : (Debug_Level)moduleLevel;
+    }
+    debug_rateLimit = g_nodeConfigSettings.log_rate_limit;
+}
+
+void Ros_Debug_SetLevel(Debug_Module module, Debug_Level level)
+{
+    if (module == NUM_DEBUG_MODULES)
+    {
+        for (int i = 0; i < NUM_DEBUG_MODULES; i += 1)
+            debug_thresholds[i] = level;
+    }
+    else if (module >= 0 && module < NUM_DEBUG_MODULES)
+        debug_thresholds[module] = level;
+}
+
+const char* const Ros_Debug_LevelToString(Debug_Level level)
+{
+    if (level >= 0 && level < NUM_DEBUG_LEVELS)
+        return debug_levelNames[level];
+    return "unknown";
+}
+
+const char* const Ros_Debug_ModuleToString(Debug_Module module)
+{
+    if (module >= 0 && module < NUM_DEBUG_MODULES)
+        return debug_moduleNames[module];
+    return "unknown";
 }
 
 void Ros_Debug_LogToConsole(char* fmt, ...)
@@ -8,7 +8,100 @@
 #ifndef MOTOROS2_DEBUG_H
 #define MOTOROS2_DEBUG_H
 
-extern void Ros_Debug_BroadcastMsg(char* fmt, ...);
+#define DEBUG_LOG_QUEUE_SIZE            128     // messages, must be a power of 2
+#define DEBUG_LOG_MAX_ARGS              12      // per message ('*' widths and precisions count as an argument)
+#define DEBUG_LOG_STRING_SPACE          256     // bytes per message for the contents of '%s' arguments
+#define PERIOD_DEBUG_LOG_SENDER_MS      10
+
+#define PERIOD_DEBUG_LOG_RATE_LIMIT_MS  1000    // window in which 'log_rate_limit' messages per call site are sent
+
+typedef enum
+{
+    DEBUG_LEVEL_DEBUG = 0,
+    DEBUG_LEVEL_INFO,
+    DEBUG_LEVEL_WARNING,
+    DEBUG_LEVEL_ERROR,
+    DEBUG_LEVEL_NONE,       // threshold only: disables all messages
+
+    NUM_DEBUG_LEVELS
+} Debug_Level;
+
+//The module of a message is determined by the source file it's logged from (see Debug.c)
+typedef enum
+{
+    DEBUG_MODULE_GENERAL = 0,
+    DEBUG_MODULE_COMMUNICATION,     // connection with the Agent, executors and clock sync
+    DEBUG_MODULE_CONFIG,            // configuration file and INFORM job
+    DEBUG_MODULE_CONTROLLER,        // controller status, control groups and calibration
+    DEBUG_MODULE_MOTION,            // motion control, motion services and twist servo
+    DEBUG_MODULE_FJT,               // FollowJointTrajectory action server
+    DEBUG_MODULE_PUBLISHERS,        // joint states, tf and other feedback
+    DEBUG_MODULE_IO,                // I/O services
+    DEBUG_MODULE_TESTS,
+
+    NUM_DEBUG_MODULES
+} Debug_Module;
+
+//Per call site state, for the module lookup and rate limiting. Updates from different
+//tasks may race, which can only affect the number of suppressed messages reported.
+typedef struct
+{
+    int module;                 // -1: not looked up yet
+    ULONG tickWindowStart;
+    UINT32 numInWindow;
+    UINT32 numSuppressed;
+} Debug_CallSite;
+
+//Once the debug log task has been started, messages are only queued by the caller: the
+//format string and the arguments are copied, and the task formats and sends them later.
+//This keeps logging from delaying time-critical tasks (fi: the IncMoveTask). Messages are
+//dropped (and counted) if the queue is full.
+//
+//Messages below the threshold of their module are discarded right away. Each call site
+//sends at most 'log_rate_limit' messages per PERIOD_DEBUG_LOG_RATE_LIMIT_MS. Any further
+//messages are counted, and the count is added to the next message which is sent.
+//
+//As it's only used after the call returns, the format must be a string literal.
+#define Ros_Debug_Log(level, fmt, ...) \
+    do \
+    { \
+        static Debug_CallSite debug_callSite = { -1, 0, 0, 0 }; \
+        INT32 debug_numSuppressed = Ros_Debug_CheckCallSite(&debug_callSite, (level), __FILE__); \
+        if (debug_numSuppressed >= 0) \
+            Ros_Debug_QueueMsg((level), debug_numSuppressed, "" fmt, ##__VA_ARGS__); \
+    } while (0)
+
+//Debug level messages are compiled out completely if MOTOROS2_DEBUG_LOG_ELIDE_DEBUG is defined
+#ifdef MOTOROS2_DEBUG_LOG_ELIDE_DEBUG
+#define Ros_Debug_BroadcastDebugMsg(fmt, ...)   do { } while (0)
+#else
+#define Ros_Debug_BroadcastDebugMsg(fmt, ...)   Ros_Debug_Log(DEBUG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#endif
+#define Ros_Debug_BroadcastMsg(fmt, ...)        Ros_Debug_Log(DEBUG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define Ros_Debug_BroadcastWarningMsg(fmt, ...) Ros_Debug_Log(DEBUG_LEVEL_WARNING, fmt, ##__VA_ARGS__)
+#define Ros_Debug_BroadcastErrorMsg(fmt, ...)   Ros_Debug_Log(DEBUG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+
+//Returns -1 if the message must be discarded, or else the number of messages suppressed
+//at this call site since the last one which was sent
+extern INT32 Ros_Debug_CheckCallSite(Debug_CallSite* const callSite, Debug_Level level, const char* file);
+extern void Ros_Debug_QueueMsg(Debug_Level level, UINT32 numSuppressed, const char* fmt, ...);
 extern void Ros_Debug_LogToConsole(char* fmt, ...);
 
+//Broadcast binary data on the debug log port (fi: telemetry)
+extern void Ros_Debug_SendDatagram(void const* data, size_t length);
+
+//Until this is called, messages are formatted and sent by the caller
+extern void Ros_Debug_StartLogTask();
+
+//Take the thresholds and rate limit from the configuration. Until this is called, all
+//messages are sent.
+extern void Ros_Debug_ApplyConfiguration();
+
+//Change the threshold of a module (or of all modules, for NUM_DEBUG_MODULES) at runtime.
+//Called for messages on the 'set_log_level' topic (see LogLevel.h).
+extern void Ros_Debug_SetLevel(Debug_Module module, Debug_Level level);
+
+extern const char* const Ros_Debug_LevelToString(Debug_Level level);
+extern const char* const Ros_Debug_ModuleToString(Debug_Module module);
+
 #endif  // MOTOROS2_DEBUG_H
@@ -105,7 +105,7 @@ void motoRosAssert_withMsg(BOOL mustBeTrue, ALARM_ASSERTION_FAIL_SUBCODE subCode
 
     FOREVER
     {
-        Ros_Debug_BroadcastMsg("motoRosAssert: %s (subcode: %d)", msg, subCodeIfFalse);
+        Ros_Debug_BroadcastErrorMsg("motoRosAssert: %s (subcode: %d)", msg, subCodeIfFalse);
         Ros_Sleep(5000);
     }
 }
@@ -52,6 +52,13 @@ typedef enum
     INIT_TRAJ_INVALID_ENDING_VELOCITY,
     INIT_TRAJ_INVALID_ENDING_ACCELERATION,
     INIT_TRAJ_DUPLICATE_JOINT_NAME,
+    INIT_TRAJ_PRECEDING_GOAL_FAILED,
+    INIT_TRAJ_INVALID_CARTESIAN_FRAME,
+    INIT_TRAJ_WRONG_NUMBER_OF_TRANSFORMS,
+    INIT_TRAJ_INVALID_ORIENTATION,
+    INIT_TRAJ_UNSUPPORTED_TOLERANCE,
+    INIT_TRAJ_START_TIME_TOO_FAR,
+    INIT_TRAJ_START_TIME_NOT_SYNCED,
 } Init_Trajectory_Status;
 
 typedef enum
@@ -95,6 +102,9 @@ typedef enum
     SUBCODE_EXECUTOR,
     SUBCODE_INCREMENTAL_MOTION,
     SUBCODE_ADD_TO_INC_Q,
+    SUBCODE_TWIST_SERVO,
+    SUBCODE_JOINT_STATE_CAPTURE,
+    SUBCODE_DEBUG_LOG,
 } ALARM_TASK_CREATE_FAIL_SUBCODE; //8010
 
 typedef enum
@@ -169,6 +179,24 @@ typedef enum
     SUBCODE_CONFIGURATION_FAIL_MP_NICDATA1,
     SUBCODE_FAIL_MP_NICDATA_INIT1,
     SUBCODE_FAIL_INVALID_BASE_TRACK_MOTION_TYPE,
+    SUBCODE_FAIL_ALLOCATE_FJT_GOAL,
+    SUBCODE_FAIL_CREATE_SUBSCRIBER_TWIST_SERVO,
+    SUBCODE_FAIL_ADD_SUBSCRIBER_TWIST_SERVO,
+    SUBCODE_FAIL_ALLOCATE_TWIST_SERVO,
+    SUBCODE_FAIL_CREATE_PUBLISHER_JOINT_STATES_BATCH,
+    SUBCODE_FAIL_ALLOCATE_JOINT_STATES_BATCH,
+    SUBCODE_FAIL_CREATE_PUBLISHER_TRANSFORM_STATIC,
+    SUBCODE_FAIL_ALLOCATE_TRANSFORM_STATIC,
+    SUBCODE_FAIL_CREATE_PUBLISHER_JOINT_COMMAND_STATES,
+    SUBCODE_FAIL_CREATE_PUBLISHER_COMPACT_JOINT_STATES,
+    SUBCODE_FAIL_CREATE_STREAMING_EXECUTOR,
+    SUBCODE_FAIL_CREATE_MODE_EXECUTOR,
+    SUBCODE_FAIL_CREATE_DIAGNOSTICS_EXECUTOR,
+    SUBCODE_FAIL_TIMER_INIT_CALLBACK_STATS,
+    SUBCODE_FAIL_TIMER_ADD_CALLBACK_STATS,
+    SUBCODE_FAIL_CREATE_SUBSCRIBER_LOG_LEVEL,
+    SUBCODE_FAIL_ADD_SUBSCRIBER_LOG_LEVEL,
+    SUBCODE_FAIL_ALLOCATE_LOG_LEVEL,
 
 } ALARM_ASSERTION_FAIL_SUBCODE; //8011
 
@@ -199,6 +227,16 @@ typedef enum
     SUBCODE_CONFIGURATION_USERLAN_MONITOR_AUTO_DETECT_FAILED,
     SUBCODE_CONFIGURATION_RUNTIME_USERLAN_LINKUP_ERR,
     SUBCODE_CONFIGURATION_NO_CALIB_FILES_LOADED,
+    SUBCODE_CONFIGURATION_INVALID_JOINT_STATES_BATCH_SIZE,
+    SUBCODE_CONFIGURATION_INVALID_IDLE_KEEPALIVE_PERIOD,
+    SUBCODE_CONFIGURATION_INVALID_IDLE_CHANGE_THRESHOLD,
+    SUBCODE_CONFIGURATION_INVALID_PUBLISH_PERIOD,
+    SUBCODE_CONFIGURATION_INVALID_AGENT_HEARTBEAT_TIMEOUT,
+    SUBCODE_CONFIGURATION_INVALID_TASK_PRIORITY,
+    SUBCODE_CONFIGURATION_INVALID_LOG_LEVEL,
+    SUBCODE_CONFIGURATION_INVALID_LOG_RATE_LIMIT,
+    SUBCODE_CONFIGURATION_INVALID_CARTESIAN_SPEED_LIMIT,
+    SUBCODE_CONFIGURATION_INVALID_SCHEDULED_START_HORIZON,
 } ALARM_CONFIGURATION_FAIL_SUBCODE; //8013
 
 typedef enum
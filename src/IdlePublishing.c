@@ -0,0 +1,146 @@
+//IdlePublishing.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+typedef enum
+{
+    IDLE_PUBLISHING_STATE_IDLE = 0,
+    IDLE_PUBLISHING_STATE_MOVING,
+
+    IDLE_PUBLISHING_NUM_STATES
+} IdlePublishing_State;
+
+static const char* const idlePublishing_stateNames[IDLE_PUBLISHING_NUM_STATES] = { "idle", "moving" };
+
+typedef struct
+{
+    BOOL bMoving;
+    ULONG tickLastPublish[IDLE_PUBLISHING_NUM_TOPICS];
+
+    //statistics for the current report period
+    ULONG tickLastUpdate;
+    ULONG tickLastReport;
+    ULONG ticksInState[IDLE_PUBLISHING_NUM_STATES];
+    UINT32 bytesInState[IDLE_PUBLISHING_NUM_STATES];
+    UINT32 messagesInState[IDLE_PUBLISHING_NUM_STATES];
+} IdlePublishing_Status;
+
+static IdlePublishing_Status idlePublishing_status;
+
+//robot_status is also published by services, so the statistics are shared between tasks
+static SEM_ID idlePublishing_statsLock = NULL;
+
+void Ros_IdlePublishing_Initialize()
+{
+    ULONG tickNow = tickGet();
+
+    bzero(&idlePublishing_status, sizeof(idlePublishing_status));
+    idlePublishing_status.bMoving = TRUE; //publish everything until the first update
+    idlePublishing_status.tickLastUpdate = tickNow;
+    idlePublishing_status.tickLastReport = tickNow;
+
+    //created once: the lock is reused after the agent reconnects
+    if (idlePublishing_statsLock == NULL)
+        idlePublishing_statsLock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+
+    if (g_nodeConfigSettings.idle_keepalive_period > 0)
+    {
+        Ros_Debug_BroadcastMsg("Idle publishing: keep-alive every %d ms, change threshold %d pulses",
+            g_nodeConfigSettings.idle_keepalive_period, g_nodeConfigSettings.idle_change_threshold);
+    }
+}
+
+static void Ros_IdlePublishing_ReportBandwidth(ULONG tickNow)
+{
+    float msPerTick = mpGetRtc();
+
+    for (int state = 0; state < IDLE_PUBLISHING_NUM_STATES; state += 1)
+    {
+        float seconds = (idlePublishing_status.ticksInState[state] * msPerTick) / 1000.0f;
+
+        if (seconds <= 0.0f)
+            continue;
+
+        Ros_Debug_BroadcastMsg("Publishing bandwidth while %s: %d B/s, %d msg/s (%d s)",
+            idlePublishing_stateNames[state],
+            (int)(idlePublishing_status.bytesInState[state] / seconds),
+            (int)(idlePublishing_status.messagesInState[state] / seconds),
+            (int)seconds);
+    }
+
+    bzero(idlePublishing_status.ticksInState, sizeof(idlePublishing_status.ticksInState));
+    bzero(idlePublishing_status.bytesInState, sizeof(idlePublishing_status.bytesInState));
+    bzero(idlePublishing_status.messagesInState, sizeof(idlePublishing_status.messagesInState));
+    idlePublishing_status.tickLastReport = tickNow;
+}
+
+void Ros_IdlePublishing_SetMoving(BOOL bMoving)
+{
+    ULONG tickNow = tickGet();
+
+    if (mpSemTake(idlePublishing_statsLock, Q_LOCK_TIMEOUT) == ERROR)
+        return;
+
+    //time since the previous update is attributed to the state the robot was in during that time
+    //(unsigned subtraction handles rollover of the tick counter)
+    IdlePublishing_State prevState = idlePublishing_status.bMoving ? IDLE_PUBLISHING_STATE_MOVING : IDLE_PUBLISHING_STATE_IDLE;
+    idlePublishing_status.ticksInState[prevState] += (tickNow - idlePublishing_status.tickLastUpdate);
+    idlePublishing_status.tickLastUpdate = tickNow;
+
+    if (idlePublishing_status.bMoving && !bMoving)
+        Ros_Debug_BroadcastMsg("Idle publishing: robot stationary, publishing on change");
+
+    idlePublishing_status.bMoving = bMoving;
+
+    if (((tickNow - idlePublishing_status.tickLastReport) * mpGetRtc()) >= IDLE_PUBLISHING_REPORT_PERIOD)
+        Ros_IdlePublishing_ReportBandwidth(tickNow);
+
+    mpSemGive(idlePublishing_statsLock);
+}
+
+BOOL Ros_IdlePublishing_ShouldPublish(IdlePublishing_Topic topic, BOOL bChanged)
+{
+    //disabled: always publish at the configured rate
+    if (g_nodeConfigSettings.idle_keepalive_period == 0)
+        return TRUE;
+
+    if (bChanged || idlePublishing_status.bMoving)
+        return TRUE;
+
+    ULONG tickDiff = tickGet() - idlePublishing_status.tickLastPublish[topic];
+    return ((tickDiff * mpGetRtc()) >= g_nodeConfigSettings.idle_keepalive_period);
+}
+
+//Size of 'msg' once serialized, or 0 if this cannot be determined
+static size_t Ros_IdlePublishing_GetSerializedSize(const rosidl_message_type_support_t* typeSupport, const void* msg)
+{
+    const rosidl_message_type_support_t* microXrceTypeSupport =
+        get_message_typesupport_handle(typeSupport, ROSIDL_TYPESUPPORT_MICROXRCEDDS_C__IDENTIFIER_VALUE);
+
+    if (microXrceTypeSupport == NULL)
+        return 0;
+
+    const message_type_support_callbacks_t* callbacks = (const message_type_support_callbacks_t*)microXrceTypeSupport->data;
+    return callbacks->get_serialized_size(msg);
+}
+
+void Ros_IdlePublishing_CountPublished(IdlePublishing_Topic topic, const rosidl_message_type_support_t* typeSupport, const void* msg)
+{
+    size_t msgSize = Ros_IdlePublishing_GetSerializedSize(typeSupport, msg);
+
+    if (mpSemTake(idlePublishing_statsLock, Q_LOCK_TIMEOUT) == ERROR)
+        return;
+
+    IdlePublishing_State state = idlePublishing_status.bMoving ? IDLE_PUBLISHING_STATE_MOVING : IDLE_PUBLISHING_STATE_IDLE;
+
+    idlePublishing_status.tickLastPublish[topic] = tickGet();
+    idlePublishing_status.bytesInState[state] += msgSize;
+    idlePublishing_status.messagesInState[state] += 1;
+
+    mpSemGive(idlePublishing_statsLock);
+}
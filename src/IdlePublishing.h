@@ -0,0 +1,36 @@
+//IdlePublishing.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_IDLE_PUBLISHING_H
+#define MOTOROS2_IDLE_PUBLISHING_H
+
+#define IDLE_PUBLISHING_REPORT_PERIOD   60000   // ms between reports of the used bandwidth on the debug log
+
+typedef enum
+{
+    IDLE_PUBLISHING_TOPIC_JOINT_STATES = 0,     // global and per-group joint_states
+    IDLE_PUBLISHING_TOPIC_TF,
+    IDLE_PUBLISHING_TOPIC_ROBOT_STATUS,
+    IDLE_PUBLISHING_TOPIC_JOINT_COMMAND_STATES,
+
+    IDLE_PUBLISHING_NUM_TOPICS
+} IdlePublishing_Topic;
+
+extern void Ros_IdlePublishing_Initialize();
+
+//Update whether the robot is currently moving. Must be called once per feedback cycle.
+extern void Ros_IdlePublishing_SetMoving(BOOL bMoving);
+
+//Whether a message should be published on 'topic' now. This is always the case while
+//the robot is moving or if the data changed (bChanged). Otherwise, a message is only
+//published once every 'idle_keepalive_period'.
+extern BOOL Ros_IdlePublishing_ShouldPublish(IdlePublishing_Topic topic, BOOL bChanged);
+
+//Record that 'msg' has been published on 'topic'
+extern void Ros_IdlePublishing_CountPublished(IdlePublishing_Topic topic, const rosidl_message_type_support_t* typeSupport, const void* msg);
+
+#endif  // MOTOROS2_IDLE_PUBLISHING_H
@@ -0,0 +1,336 @@
+//JointStateCapture.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+JointStateCapture_Publishers g_publishers_JointStateCapture;
+JointStateCapture_Messages g_messages_JointStateCapture;
+
+//Single producer (IncMoveTask), single consumer (publisher task). The counters only
+//ever increase; each is written by one task only, so no lock is needed.
+static JointStateCapture_Sample jointStateCapture_ring[JOINT_STATE_CAPTURE_RING_SIZE];
+static volatile UINT32 jointStateCapture_writeCount = 0;
+static volatile UINT32 jointStateCapture_readCount = 0;
+static volatile UINT32 jointStateCapture_droppedCount = 0;
+static volatile BOOL jointStateCapture_bEnabled = FALSE;
+static BOOL jointStateCapture_bSpeedTorque = FALSE;
+
+//last published feedback position, to derive the velocity of the next sample if the speed
+//isn't read (publisher task only)
+static double jointStateCapture_prevPositions[MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM];
+static ULONG jointStateCapture_prevTick = 0;
+static BOOL jointStateCapture_bHavePrev = FALSE;
+
+static int jointStateCapture_tid = INVALID_TASK;
+
+static micro_ros_utilities_memory_conf_t jointStateCapture_statesAllocCfg = { 0 };
+static micro_ros_utilities_memory_conf_t jointStateCapture_commandsAllocCfg = { 0 };
+
+static void Ros_JointStateCapture_PublisherTask();
+
+void Ros_JointStateCapture_Initialize()
+{
+    int batchSize = g_nodeConfigSettings.joint_states_batch_size;
+    int maxAxes = g_Ros_Controller.totalAxesCount;
+    rcl_ret_t ret;
+
+    jointStateCapture_bEnabled = FALSE;
+    jointStateCapture_bSpeedTorque = g_nodeConfigSettings.joint_states_batch_speed_torque;
+
+    if (batchSize == 0)
+        return;
+
+    MOTOROS2_MEM_TRACE_START(js_capture_init);
+
+    Ros_Debug_BroadcastMsg("Initializing joint state capture (%d samples per message)", batchSize);
+
+    //==================================
+    //Batches are too large to fit in a single best-effort packet, so these always use reliable QoS
+    ret = rclc_publisher_init(
+        &g_publishers_JointStateCapture.jointStatesBatch,
+        &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, JointTrajectory),
+        TOPIC_NAME_JOINT_STATES_BATCH,
+        &rmw_qos_profile_default);
+    motoRosAssert_withMsg(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_JOINT_STATES_BATCH, "Failed to init publisher (%d)", (int)ret);
+
+    ret = rclc_publisher_init(
+        &g_publishers_JointStateCapture.jointCommandsBatch,
+        &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, JointTrajectory),
+        TOPIC_NAME_JOINT_COMMANDS_BATCH,
+        &rmw_qos_profile_default);
+    motoRosAssert_withMsg(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_JOINT_STATES_BATCH, "Failed to init publisher (%d)", (int)ret);
+
+    //==================================
+    //feedback: position, velocity and (if the torque is read) effort. command: position only.
+    //(the rules must outlive this function, as the configs are used again in Cleanup)
+    static micro_ros_utilities_memory_rule_t statesRules[7];
+    static micro_ros_utilities_memory_rule_t commandsRules[7];
+    const char* const ruleNames[7] = { "joint_names", "joint_names.data", "points",
+        "points.positions", "points.velocities", "points.accelerations", "points.effort" };
+    const size_t statesSizes[7] = { maxAxes, MAX_JOINT_NAME_LENGTH, batchSize, maxAxes, maxAxes, 0, jointStateCapture_bSpeedTorque ? maxAxes : 0 };
+    const size_t commandsSizes[7] = { maxAxes, MAX_JOINT_NAME_LENGTH, batchSize, maxAxes, 0, 0, 0 };
+
+    for (int i = 0; i < 7; i += 1)
+    {
+        statesRules[i].rule = commandsRules[i].rule = ruleNames[i];
+        statesRules[i].size = statesSizes[i];
+        commandsRules[i].size = commandsSizes[i];
+    }
+
+    jointStateCapture_statesAllocCfg.allocator = &g_motoros2_Allocator;
+    jointStateCapture_statesAllocCfg.max_string_capacity = MAX_JOINT_NAME_LENGTH;
+    jointStateCapture_statesAllocCfg.max_ros2_type_sequence_capacity = maxAxes;
+    jointStateCapture_statesAllocCfg.max_basic_type_sequence_capacity = maxAxes;
+    jointStateCapture_statesAllocCfg.rules = statesRules;
+    jointStateCapture_statesAllocCfg.n_rules = sizeof(statesRules) / sizeof(statesRules[0]);
+
+    jointStateCapture_commandsAllocCfg = jointStateCapture_statesAllocCfg;
+    jointStateCapture_commandsAllocCfg.rules = commandsRules;
+
+    bool bOk = micro_ros_utilities_create_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, JointTrajectory),
+        &g_messages_JointStateCapture.jointStatesBatch,
+        jointStateCapture_statesAllocCfg);
+    motoRosAssert_withMsg(bOk, SUBCODE_FAIL_ALLOCATE_JOINT_STATES_BATCH, "Failed to allocate batch message");
+
+    bOk = micro_ros_utilities_create_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, JointTrajectory),
+        &g_messages_JointStateCapture.jointCommandsBatch,
+        jointStateCapture_commandsAllocCfg);
+    motoRosAssert_withMsg(bOk, SUBCODE_FAIL_ALLOCATE_JOINT_STATES_BATCH, "Failed to allocate batch message");
+
+    //copy the joint names from the /joint_states message
+    int numJoints = g_messages_PositionMonitor.jointStateAllGroups->name.size;
+    g_messages_JointStateCapture.jointStatesBatch.joint_names.size = numJoints;
+    g_messages_JointStateCapture.jointCommandsBatch.joint_names.size = numJoints;
+    for (int i = 0; i < numJoints; i += 1)
+    {
+        rosidl_runtime_c__String__assign(&g_messages_JointStateCapture.jointStatesBatch.joint_names.data[i],
+            g_messages_PositionMonitor.jointStateAllGroups->name.data[i].data);
+        rosidl_runtime_c__String__assign(&g_messages_JointStateCapture.jointCommandsBatch.joint_names.data[i],
+            g_messages_PositionMonitor.jointStateAllGroups->name.data[i].data);
+    }
+
+    //==================================
+    jointStateCapture_writeCount = 0;
+    jointStateCapture_readCount = 0;
+    jointStateCapture_droppedCount = 0;
+    jointStateCapture_bHavePrev = FALSE;
+    jointStateCapture_bEnabled = TRUE;
+
+    jointStateCapture_tid = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE,
+                                        (FUNCPTR)Ros_JointStateCapture_PublisherTask,
+                                        0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    if (jointStateCapture_tid == ERROR)
+    {
+        jointStateCapture_tid = INVALID_TASK;
+        jointStateCapture_bEnabled = FALSE;
+        mpSetAlarm(ALARM_TASK_CREATE_FAIL, APPLICATION_NAME " FAILED TO CREATE TASK", SUBCODE_JOINT_STATE_CAPTURE);
+    }
+
+    MOTOROS2_MEM_TRACE_REPORT(js_capture_init);
+}
+
+void Ros_JointStateCapture_Cleanup()
+{
+    rcl_ret_t ret;
+
+    if (g_nodeConfigSettings.joint_states_batch_size == 0)
+        return;
+
+    MOTOROS2_MEM_TRACE_START(js_capture_fini);
+
+    //the ring is static, so the IncMoveTask may keep running while this is cleaned up
+    jointStateCapture_bEnabled = FALSE;
+
+    if (jointStateCapture_tid != INVALID_TASK)
+    {
+        mpDeleteTask(jointStateCapture_tid);
+        jointStateCapture_tid = INVALID_TASK;
+    }
+
+    Ros_Debug_BroadcastMsg("Cleanup joint state capture publishers (%d samples dropped)", jointStateCapture_droppedCount);
+    ret = rcl_publisher_fini(&g_publishers_JointStateCapture.jointStatesBatch, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up " TOPIC_NAME_JOINT_STATES_BATCH " publisher: %d", ret);
+    ret = rcl_publisher_fini(&g_publishers_JointStateCapture.jointCommandsBatch, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up " TOPIC_NAME_JOINT_COMMANDS_BATCH " publisher: %d", ret);
+
+    micro_ros_utilities_destroy_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, JointTrajectory),
+        &g_messages_JointStateCapture.jointStatesBatch,
+        jointStateCapture_statesAllocCfg);
+    micro_ros_utilities_destroy_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, JointTrajectory),
+        &g_messages_JointStateCapture.jointCommandsBatch,
+        jointStateCapture_commandsAllocCfg);
+
+    MOTOROS2_MEM_TRACE_REPORT(js_capture_fini);
+}
+
+void Ros_JointStateCapture_Sample()
+{
+    if (!jointStateCapture_bEnabled)
+        return;
+
+    if ((jointStateCapture_writeCount - jointStateCapture_readCount) >= JOINT_STATE_CAPTURE_RING_SIZE)
+    {
+        //publisher is not keeping up
+        jointStateCapture_droppedCount += 1;
+        return;
+    }
+
+    JointStateCapture_Sample* sample = &jointStateCapture_ring[jointStateCapture_writeCount & (JOINT_STATE_CAPTURE_RING_SIZE - 1)];
+
+    sample->tick = tickGet();
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+
+        Ros_CtrlGroup_GetFBPulsePos(group, sample->fbPulsePos[groupIndex]);
+        Ros_CtrlGroup_GetPulsePosCmd(group, sample->cmdPulsePos[groupIndex]);
+    }
+
+    //one mpReadIO and one mpSvsGetVelTrqFb call for all groups
+    if (jointStateCapture_bSpeedTorque)
+    {
+        Ros_ControllerSnapshot_ReadSpeed(sample->bFbPulseSpeedValid, sample->fbPulseSpeed);
+        Ros_ControllerSnapshot_ReadTorque(sample->torque);
+    }
+
+    //publish the sample only after it has been completely written
+    jointStateCapture_writeCount += 1;
+}
+
+//Convert 'batchSize' samples, starting at the read position of the ring, and publish them
+static void Ros_JointStateCapture_PublishBatch(int batchSize)
+{
+    trajectory_msgs__msg__JointTrajectory* states = &g_messages_JointStateCapture.jointStatesBatch;
+    trajectory_msgs__msg__JointTrajectory* commands = &g_messages_JointStateCapture.jointCommandsBatch;
+    ULONG firstTick = jointStateCapture_ring[jointStateCapture_readCount & (JOINT_STATE_CAPTURE_RING_SIZE - 1)].tick;
+    INT64 nsPerTick = (INT64)(mpGetRtc() * 1000000.0);
+    rcl_ret_t ret;
+
+    //the time of the first sample, from how many ticks ago it was recorded
+    ULONG tickNow = tickGet();
+    INT64 firstTimestamp = Ros_ClockSync_Now() - ((INT64)(ULONG)(tickNow - firstTick) * nsPerTick);
+
+    Ros_Nanos_To_Time_Msg(firstTimestamp, &states->header.stamp);
+    Ros_Nanos_To_Time_Msg(firstTimestamp, &commands->header.stamp);
+
+    for (int pointIndex = 0; pointIndex < batchSize; pointIndex += 1)
+    {
+        JointStateCapture_Sample const* sample = &jointStateCapture_ring[(jointStateCapture_readCount + pointIndex) & (JOINT_STATE_CAPTURE_RING_SIZE - 1)];
+        trajectory_msgs__msg__JointTrajectoryPoint* statePoint = &states->points.data[pointIndex];
+        trajectory_msgs__msg__JointTrajectoryPoint* commandPoint = &commands->points.data[pointIndex];
+        int iteratorAllAxes = 0;
+
+        //each sample is stamped relative to the header
+        Ros_Nanos_To_Duration_Msg((INT64)(ULONG)(sample->tick - firstTick) * nsPerTick, &statePoint->time_from_start);
+        commandPoint->time_from_start = statePoint->time_from_start;
+
+        for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+        {
+            CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+            double converted[MAX_PULSE_AXES];
+
+            Ros_CtrlGroup_ConvertToRosPos(group, sample->fbPulsePos[groupIndex], converted);
+            memcpy(&statePoint->positions.data[iteratorAllAxes], converted, sizeof(double) * group->numAxes);
+
+            Ros_CtrlGroup_ConvertToRosPos(group, sample->cmdPulsePos[groupIndex], converted);
+            memcpy(&commandPoint->positions.data[iteratorAllAxes], converted, sizeof(double) * group->numAxes);
+
+            iteratorAllAxes += group->numAxes;
+        }
+
+        //velocity from the change of the feedback position since the previous sample, for
+        //the groups of which the speed isn't read
+        double dt = (double)((INT64)(ULONG)(sample->tick - jointStateCapture_prevTick) * nsPerTick) * 1.0e-9;
+        for (int axis = 0; axis < g_Ros_Controller.totalAxesCount; axis += 1)
+        {
+            if (jointStateCapture_bHavePrev && dt > 0.0)
+                statePoint->velocities.data[axis] = (statePoint->positions.data[axis] - jointStateCapture_prevPositions[axis]) / dt;
+            else
+                statePoint->velocities.data[axis] = 0.0;
+            jointStateCapture_prevPositions[axis] = statePoint->positions.data[axis];
+        }
+        jointStateCapture_prevTick = sample->tick;
+        jointStateCapture_bHavePrev = TRUE;
+
+        if (jointStateCapture_bSpeedTorque)
+        {
+            iteratorAllAxes = 0;
+            for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+            {
+                CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+                double converted[MAX_PULSE_AXES];
+
+                if (sample->bFbPulseSpeedValid[groupIndex])
+                {
+                    Ros_CtrlGroup_ConvertToRosPos(group, sample->fbPulseSpeed[groupIndex], converted);
+                    memcpy(&statePoint->velocities.data[iteratorAllAxes], converted, sizeof(double) * group->numAxes);
+                }
+
+                Ros_CtrlGroup_ConvertToRosTorque(group, sample->torque[groupIndex], converted);
+                memcpy(&statePoint->effort.data[iteratorAllAxes], converted, sizeof(double) * group->numAxes);
+
+                iteratorAllAxes += group->numAxes;
+            }
+        }
+
+        statePoint->positions.size =
+            statePoint->velocities.size =
+            commandPoint->positions.size = g_Ros_Controller.totalAxesCount;
+        statePoint->effort.size = jointStateCapture_bSpeedTorque ? g_Ros_Controller.totalAxesCount : 0;
+    }
+    states->points.size = commands->points.size = batchSize;
+
+    //the samples have been copied, so the IncMoveTask can reuse their slots
+    jointStateCapture_readCount += batchSize;
+
+    ret = rcl_publish(&g_publishers_JointStateCapture.jointStatesBatch, states, NULL);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed publishing " TOPIC_NAME_JOINT_STATES_BATCH ": %d", ret);
+
+    ret = rcl_publish(&g_publishers_JointStateCapture.jointCommandsBatch, commands, NULL);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed publishing " TOPIC_NAME_JOINT_COMMANDS_BATCH ": %d", ret);
+}
+
+//-----------------------------------------------------------------------
+// Task that publishes the captured samples as soon as a complete batch
+// is available. Runs at normal priority, so publishing never delays the
+// IncMoveTask.
+//-----------------------------------------------------------------------
+static void Ros_JointStateCapture_PublisherTask()
+{
+    int batchSize = g_nodeConfigSettings.joint_states_batch_size;
+    UINT32 reportedDropCount = 0;
+
+    //check twice per batch, so a batch is never delayed by more than half its duration
+    int checkPeriod_ms = (int)(g_Ros_Controller.interpolPeriod * batchSize) / 2;
+    if (checkPeriod_ms < 1)
+        checkPeriod_ms = 1;
+
+    FOREVER
+    {
+        Ros_Sleep(checkPeriod_ms);
+
+        while ((jointStateCapture_writeCount - jointStateCapture_readCount) >= (UINT32)batchSize)
+            Ros_JointStateCapture_PublishBatch(batchSize);
+
+        if (jointStateCapture_droppedCount != reportedDropCount)
+        {
+            Ros_Debug_BroadcastMsg("Joint state capture: %d samples dropped (publisher too slow)",
+                jointStateCapture_droppedCount - reportedDropCount);
+            reportedDropCount = jointStateCapture_droppedCount;
+        }
+    }
+}
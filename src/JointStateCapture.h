@@ -0,0 +1,49 @@
+//JointStateCapture.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_JOINT_STATE_CAPTURE_H
+#define MOTOROS2_JOINT_STATE_CAPTURE_H
+
+//Must be a power of two, and at least twice MAX_JOINT_STATES_BATCH_SIZE
+#define JOINT_STATE_CAPTURE_RING_SIZE       64
+
+//Feedback and command data of all groups, sampled at the start of an interpolation cycle.
+//The timestamp is calculated by the publisher task, from the tick. The speed and torque are
+//only read if 'joint_states_batch_speed_torque' is set.
+typedef struct
+{
+    ULONG tick;
+    long fbPulsePos[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+    long cmdPulsePos[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+    BOOL bFbPulseSpeedValid[MAX_CONTROLLABLE_GROUPS];
+    long fbPulseSpeed[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+    double torque[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];        // moto units (Nm or N)
+} JointStateCapture_Sample;
+
+typedef struct
+{
+    rcl_publisher_t jointStatesBatch;
+    rcl_publisher_t jointCommandsBatch;
+} JointStateCapture_Publishers;
+extern JointStateCapture_Publishers g_publishers_JointStateCapture;
+
+typedef struct
+{
+    trajectory_msgs__msg__JointTrajectory jointStatesBatch;
+    trajectory_msgs__msg__JointTrajectory jointCommandsBatch;
+} JointStateCapture_Messages;
+extern JointStateCapture_Messages g_messages_JointStateCapture;
+
+//Does nothing if 'joint_states_batch_size' is not configured
+extern void Ros_JointStateCapture_Initialize();
+extern void Ros_JointStateCapture_Cleanup();
+
+//Record the state of all groups in the capture ring. Called by the IncMoveTask
+//once per interpolation cycle. Never blocks: if the ring is full, the sample is dropped.
+extern void Ros_JointStateCapture_Sample();
+
+#endif  // MOTOROS2_JOINT_STATE_CAPTURE_H
@@ -0,0 +1,114 @@
+//LogLevel.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_subscription_t g_subscriberLogLevel;
+
+SubscriberLogLevel_Messages g_messages_LogLevel;
+
+void Ros_LogLevel_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(sub_log_level_init);
+
+    //--------------
+    const rosidl_message_type_support_t* type_support = ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, String);
+
+    rcl_ret_t ret;
+    ret = rclc_subscription_init_default(&g_subscriberLogLevel, &g_microRosNodeInfo.node, type_support, TOPIC_NAME_SET_LOG_LEVEL);
+    motoRosAssert_withMsg(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_SUBSCRIBER_LOG_LEVEL, "Failed to init subscriber (%d)", (int)ret);
+
+    //--------------
+    micro_ros_utilities_memory_conf_t log_level_msg_alloc_cfg = { 0 };
+    log_level_msg_alloc_cfg.max_string_capacity = LOG_LEVEL_MAX_COMMAND_LENGTH;
+
+    bool bOk = micro_ros_utilities_create_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, String),
+        &g_messages_LogLevel.command,
+        log_level_msg_alloc_cfg);
+    motoRosAssert_withMsg(bOk, SUBCODE_FAIL_ALLOCATE_LOG_LEVEL, "Failed to allocate log level message");
+
+    //--------------
+    MOTOROS2_MEM_TRACE_REPORT(sub_log_level_init);
+}
+
+void Ros_LogLevel_Cleanup()
+{
+    rcl_ret_t ret;
+    MOTOROS2_MEM_TRACE_START(sub_log_level_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup log level subscriber");
+
+    ret = rcl_subscription_fini(&g_subscriberLogLevel, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up " TOPIC_NAME_SET_LOG_LEVEL " subscriber: %d", ret);
+
+    micro_ros_utilities_memory_conf_t log_level_msg_alloc_cfg = { 0 };
+    log_level_msg_alloc_cfg.max_string_capacity = LOG_LEVEL_MAX_COMMAND_LENGTH;
+
+    micro_ros_utilities_destroy_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, String),
+        &g_messages_LogLevel.command,
+        log_level_msg_alloc_cfg);
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_log_level_fini);
+}
+
+//Returns NUM_DEBUG_LEVELS if 'name' is not a level
+static Debug_Level Ros_LogLevel_ParseLevel(char const* name)
+{
+    for (int i = 0; i < NUM_DEBUG_LEVELS; i += 1)
+    {
+        if (strcmp(name, Ros_Debug_LevelToString((Debug_Level)i)) == 0)
+            return (Debug_Level)i;
+    }
+    return NUM_DEBUG_LEVELS;
+}
+
+//Returns -1 if the first 'len' characters of 'name' are not a module
+static int Ros_LogLevel_ParseModule(char const* name, size_t len)
+{
+    for (int i = 0; i < NUM_DEBUG_MODULES; i += 1)
+    {
+        char const* moduleName = Ros_Debug_ModuleToString((Debug_Module)i);
+        if (strlen(moduleName) == len && strncmp(name, moduleName, len) == 0)
+            return i;
+    }
+    return -1;
+}
+
+void Ros_LogLevel_CommandReceived(const void* msg)
+{
+    std_msgs__msg__String const* commandMsg = (std_msgs__msg__String const*)msg;
+    char const* command = commandMsg->data.data;
+    char const* levelName = command;
+    int module = NUM_DEBUG_MODULES; //all modules
+    Debug_Level level;
+
+    if (command == NULL)
+        return;
+
+    char const* separator = strchr(command, '=');
+    if (separator != NULL)
+    {
+        module = Ros_LogLevel_ParseModule(command, separator - command);
+        levelName = separator + 1;
+    }
+    level = Ros_LogLevel_ParseLevel(levelName);
+
+    if (module < 0 || level == NUM_DEBUG_LEVELS)
+    {
+        Ros_Debug_BroadcastWarningMsg("Ignoring invalid log level command: '%s'", command);
+        return;
+    }
+
+    //logged before the change, so it's also seen when the level is raised above 'info'
+    Ros_Debug_BroadcastMsg("Setting log level of %s to '%s'",
+        (module == NUM_DEBUG_MODULES) ? "all modules" : Ros_Debug_ModuleToString((Debug_Module)module),
+        Ros_Debug_LevelToString(level));
+    Ros_Debug_SetLevel((Debug_Module)module, level);
+}
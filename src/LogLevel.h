@@ -0,0 +1,29 @@
+//LogLevel.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_LOG_LEVEL_H
+#define MOTOROS2_LOG_LEVEL_H
+
+#define LOG_LEVEL_MAX_COMMAND_LENGTH            64
+
+//Changes the debug log thresholds at runtime (see Ros_Debug_SetLevel). The command is
+//either '<level>', for all modules, or '<module>=<level>', fi: 'motion=debug'. Levels
+//and modules are named as in the 'logging' section of the configuration file.
+extern rcl_subscription_t g_subscriberLogLevel;
+
+typedef struct
+{
+    std_msgs__msg__String command;
+} SubscriberLogLevel_Messages;
+extern SubscriberLogLevel_Messages g_messages_LogLevel;
+
+extern void Ros_LogLevel_Initialize();
+extern void Ros_LogLevel_Cleanup();
+
+extern void Ros_LogLevel_CommandReceived(const void* msg);
+
+#endif  // MOTOROS2_LOG_LEVEL_H
@@ -21,42 +21,70 @@
 Init_Trajectory_Status Ros_MotionControl_ConvertTrajectoryToJointMotionData(trajectory_msgs__msg__JointTrajectoryPoint__Sequence* in_jointTrajData, 
     int incomingAxisIndex, CtrlGroup* ctrlGroup, int ctrlGroupAxisIndex, JointMotionData* out_jointMotionData);
 
+static BOOL Ros_MotionControl_IsScheduledStartPending();
+static Init_Trajectory_Status Ros_MotionControl_InitCartesianTrajectory(trajectory_msgs__msg__MultiDOFJointTrajectory* trajectory,
+    INT64 scheduledStartTime_ns);
+static BOOL Ros_MotionControl_AddCartesianSegmentToIncQueue(CtrlGroup* ctrlGroup);
+static void Ros_MotionControl_UpdateCommandState(MP_PULSE_POS_RSP_DATA const cmdPulsePosData[MAX_CONTROLLABLE_GROUPS]);
+static void Ros_MotionControl_UpdateInMotion(BOOL hasUnprocessedData);
+
 BOOL Ros_MotionControl_AllGroupsInitComplete = FALSE;
 
 MOTION_MODE Ros_MotionControl_ActiveMotionMode = MOTION_MODE_INACTIVE;
 
 BOOL Ros_MotionControl_MustInitializePointQueue = TRUE; //first point of streaming trajectory must match current-position
 
-Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence* sequenceGoalJointNames, trajectory_msgs__msg__JointTrajectoryPoint__Sequence* sequenceOfPoints)
+// Scheduled start of a trajectory (synchronized time, ns). The increment queues are filled,
+// but the IncMoveTask doesn't send anything to the controller until this time is reached.
+// 0 means no start is pending.
+INT64 Ros_MotionControl_ScheduledStartTime_ns = 0;
+
+// Outcome of the most recent scheduled start
+BOOL Ros_MotionControl_ScheduledStartDone = FALSE;
+INT64 Ros_MotionControl_ScheduledStartActualTime_ns = 0;
+INT64 Ros_MotionControl_ScheduledStartError_ns = 0;
+
+// Trajectory that has been converted and validated while another one was still executing
+// (see Ros_MotionControl_StageTrajectory). The data is stored in the 'trajectoryToStage'
+// buffer of each CtrlGroup.
+BOOL Ros_MotionControl_HasStagedTrajectoryData = FALSE;
+int Ros_MotionControl_StagedNumberOfPoints = 0;
+BOOL Ros_MotionControl_StagedGroupIsUsed[MAX_CONTROLLABLE_GROUPS];
+INT64 Ros_MotionControl_StagedRequestedStartTime_ns = 0;
+
+// Whether the robot is moving. Written by the IncMoveTask once per interpolation cycle
+// (see Ros_MotionControl_UpdateInMotion), read by all other tasks.
+volatile BOOL Ros_MotionControl_bInMotion = TRUE;
+
+// Command position of all groups. Written by the IncMoveTask once per interpolation cycle
+// (see Ros_MotionControl_UpdateCommandState). The sequence number is odd while the state is
+// being written, so readers can detect (and retry) a copy that was interrupted by an update,
+// without the IncMoveTask ever having to wait for them.
+static MotionControl_CommandState Ros_MotionControl_CommandState;
+static volatile UINT32 Ros_MotionControl_CommandStateSeq = 0;
+static volatile BOOL Ros_MotionControl_bCommandStateValid = FALSE;
+
+//-----------------------------------------------------------------------
+// Convert and validate all points of a trajectory, storing the result in either the
+// active ('trajectoryToProcess') or the staging ('trajectoryToStage') buffer of each group.
+// This does not check the start position, as that can only be done once the trajectory
+// is about to be executed.
+//-----------------------------------------------------------------------
+static Init_Trajectory_Status Ros_MotionControl_ConvertTrajectory(rosidl_runtime_c__String__Sequence* sequenceGoalJointNames, trajectory_msgs__msg__JointTrajectoryPoint__Sequence* sequenceOfPoints,
+    BOOL bToStagingBuffer, BOOL bGroupIsUsed[MAX_CONTROLLABLE_GROUPS])
 {
-    long pulsePos[MAX_PULSE_AXES];
-    long curPos[MAX_PULSE_AXES];
     int grpIndex, jointIndexInTraj, pointIndex, checkForDupIndex;
 
-    //Verify we're not already running a trajectory
-    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
-    {
-        if (g_Ros_Controller.ctrlGroups[grpIndex]->hasDataToProcess)
-        {
-            Ros_Debug_BroadcastMsg("Already processing trajectory data - Rejecting new trajectory (Group #%d)",
-                g_Ros_Controller.ctrlGroups[grpIndex]->groupNo);
-            return INIT_TRAJ_ALREADY_IN_MOTION;
-        }
-    }
-
-    Ros_MotionControl_AllGroupsInitComplete = FALSE;
-
     //Init internal storage for each group
     for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
     {
-        g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryIterator = NULL;
-        bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(JointMotionData) * MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        bzero(bToStagingBuffer ? ctrlGroup->trajectoryToStage : ctrlGroup->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
     }
 
     //------------------------------------------------------------
     //The trajectory contains information for all groups. Determine which groups are used by looking at the 'joint names'.
-    BOOL bGroupIsUsed[MAX_CONTROLLABLE_GROUPS];
-    bzero(bGroupIsUsed, sizeof(bGroupIsUsed));
+    bzero(bGroupIsUsed, sizeof(BOOL) * MAX_CONTROLLABLE_GROUPS);
     
     if (g_Ros_Controller.totalAxesCount != sequenceGoalJointNames->size)
     {
@@ -149,13 +177,50 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
         }
 
         //this processes all points in the trajectory array FOR A SINGLE AXIS at a time
-        Init_Trajectory_Status convertStatus = Ros_MotionControl_ConvertTrajectoryToJointMotionData(sequenceOfPoints, jointIndexInTraj, ctrlGroup, jointIndexInCtrlGroup, ctrlGroup->trajectoryToProcess);
+        Init_Trajectory_Status convertStatus = Ros_MotionControl_ConvertTrajectoryToJointMotionData(sequenceOfPoints, jointIndexInTraj, ctrlGroup, jointIndexInCtrlGroup,
+            bToStagingBuffer ? ctrlGroup->trajectoryToStage : ctrlGroup->trajectoryToProcess);
         if (convertStatus != INIT_TRAJ_OK)
             return convertStatus;
 
         bGroupIsUsed[grpIndex] = TRUE;
     } //for each joint in a single trajectory point
 
+    //---------------
+    // For MPL80/100 robot type (SLU-BT): Controller automatically moves the B-axis
+    // to maintain orientation as other axes are moved.
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        JointMotionData* trajectory = bToStagingBuffer ? ctrlGroup->trajectoryToStage : ctrlGroup->trajectoryToProcess;
+
+        if (!bGroupIsUsed[grpIndex] || !ctrlGroup->bIsBaxisSlave)
+            continue;
+
+        for (int i = 0; i < sequenceOfPoints->size; i += 1)
+        {
+            //This is radians in MOTO joint order
+            trajectory[i].pos[4] += -trajectory[i].pos[1] + trajectory[i].pos[2];
+            trajectory[i].vel[4] += -trajectory[i].vel[1] + trajectory[i].vel[2];
+        }
+    }
+
+    return INIT_TRAJ_OK;
+}
+
+//-----------------------------------------------------------------------
+// Verify the start of the converted trajectory in the 'trajectoryToProcess' buffers
+// against the current position and release it to the AddToIncQueue tasks.
+//-----------------------------------------------------------------------
+static Init_Trajectory_Status Ros_MotionControl_ActivateTrajectory(int numberOfPoints, BOOL const bGroupIsUsed[MAX_CONTROLLABLE_GROUPS],
+    INT64 scheduledStartTime_ns)
+{
+    long pulsePos[MAX_PULSE_AXES];
+    long curPos[MAX_PULSE_AXES];
+    int grpIndex;
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        g_Ros_Controller.ctrlGroups[grpIndex]->bCartesianTrajectory = FALSE;
+
     for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
     {
         if (!bGroupIsUsed[grpIndex])
@@ -164,19 +229,6 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
         CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
         Ros_Debug_BroadcastMsg("Initializing trajectory for group #%d", ctrlGroup->groupNo);
 
-        //---------------
-        // For MPL80/100 robot type (SLU-BT): Controller automatically moves the B-axis
-        // to maintain orientation as other axes are moved.
-        if (ctrlGroup->bIsBaxisSlave)
-        {
-            for (int i = 0; i < sequenceOfPoints->size; i += 1)
-            {
-                //This is radians in MOTO joint order
-                ctrlGroup->trajectoryToProcess[i].pos[4] += -ctrlGroup->trajectoryToProcess[i].pos[1] + ctrlGroup->trajectoryToProcess[i].pos[2];
-                ctrlGroup->trajectoryToProcess[i].vel[4] += -ctrlGroup->trajectoryToProcess[i].vel[1] + ctrlGroup->trajectoryToProcess[i].vel[2];
-            }
-        }
-
         ctrlGroup->prevTrajectoryIterator = ctrlGroup->trajectoryToProcess; //reset iterator
 
         // Assign start position
@@ -197,7 +249,7 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
             // Check if position matches current command position
             if (abs(pulsePos[i] - curPos[i]) > START_MAX_PULSE_DEVIATION)
             {
-                Ros_Debug_BroadcastMsg("ERROR: Trajectory start position doesn't match current position (MOTO joint order).");
+                Ros_Debug_BroadcastErrorMsg("Trajectory start position doesn't match current position (MOTO joint order).");
                 Ros_Debug_BroadcastMsg(" - Requested start: %ld, %ld, %ld, %ld, %ld, %ld, %ld, %ld",
                     pulsePos[0], pulsePos[1], pulsePos[2],
                     pulsePos[3], pulsePos[4], pulsePos[5],
@@ -215,7 +267,7 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
                 {
                     g_Ros_Controller.ctrlGroups[grpIndex]->hasDataToProcess = FALSE;
                     g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryIterator = NULL;
-                    bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(JointMotionData) * MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+                    bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
                 }
 
                 return INIT_TRAJ_INVALID_STARTING_POS;
@@ -224,13 +276,13 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
             // Check maximum velocity limit
             if (abs(ctrlGroup->prevTrajectoryIterator->vel[i]) > ctrlGroup->maxSpeed[i])
             {
-                Ros_Debug_BroadcastMsg("ERROR: Command of (%.4f) exceeds the speed limit of (%.4f) for axis %d", ctrlGroup->prevTrajectoryIterator->vel[i], ctrlGroup->maxSpeed[i], i);
+                Ros_Debug_BroadcastErrorMsg("Command of (%.4f) exceeds the speed limit of (%.4f) for axis %d", ctrlGroup->prevTrajectoryIterator->vel[i], ctrlGroup->maxSpeed[i], i);
 
                 for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
                 {
                     g_Ros_Controller.ctrlGroups[grpIndex]->hasDataToProcess = FALSE;
                     g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryIterator = NULL;
-                    bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(JointMotionData) * MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+                    bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
                 }
 
                 // excessive speed
@@ -241,7 +293,7 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
         //Although there are additional groups to process, we'll set this flag to indicate that the point is ready for processing.
         //The Ros_MotionControl_AllGroupsInitComplete flag has not been set yet. That will prevent the AddToIncQueueProcess loop
         //from processing increments before all groups are synchronized.
-        for (int i = 0; i < sequenceOfPoints->size; i += 1)
+        for (int i = 0; i < numberOfPoints; i += 1)
         {
             ctrlGroup->trajectoryToProcess[i].valid = TRUE;
         }
@@ -252,20 +304,632 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
 
     } //for each group in the controller
 
+    //Must be set before the AddToIncQueue tasks are released, otherwise the
+    //IncMoveTask could start sending increments immediately
+    Ros_MotionControl_ScheduledStartDone = FALSE;
+    Ros_MotionControl_ScheduledStartTime_ns = scheduledStartTime_ns;
+
     Ros_MotionControl_AllGroupsInitComplete = TRUE;
 
     return INIT_TRAJ_OK;
 }
 
+Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence* sequenceGoalJointNames, trajectory_msgs__msg__JointTrajectoryPoint__Sequence* sequenceOfPoints,
+    INT64 scheduledStartTime_ns)
+{
+    int grpIndex;
+    BOOL bGroupIsUsed[MAX_CONTROLLABLE_GROUPS];
+
+    //Verify we're not already running a trajectory
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        if (g_Ros_Controller.ctrlGroups[grpIndex]->hasDataToProcess)
+        {
+            Ros_Debug_BroadcastMsg("Already processing trajectory data - Rejecting new trajectory (Group #%d)",
+                g_Ros_Controller.ctrlGroups[grpIndex]->groupNo);
+            return INIT_TRAJ_ALREADY_IN_MOTION;
+        }
+    }
+
+    Ros_MotionControl_AllGroupsInitComplete = FALSE;
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryIterator = NULL;
+
+    Init_Trajectory_Status status = Ros_MotionControl_ConvertTrajectory(sequenceGoalJointNames, sequenceOfPoints,
+        /* bToStagingBuffer = */ FALSE, bGroupIsUsed);
+    if (status != INIT_TRAJ_OK)
+        return status;
+
+    return Ros_MotionControl_ActivateTrajectory(sequenceOfPoints->size, bGroupIsUsed, scheduledStartTime_ns);
+}
+
+//-----------------------------------------------------------------------
+// Check the time in the header of a trajectory when the goal is received.
+// A start time can only be requested if the clock is synchronized with the
+// Agent, and may not be further away than 'scheduled_start_horizon'.
+//-----------------------------------------------------------------------
+static Init_Trajectory_Status Ros_MotionControl_ValidateRequestedStartTime(INT64 requestedStartTime_ns)
+{
+    if (requestedStartTime_ns == 0)
+        return INIT_TRAJ_OK;
+
+    if (!g_nodeConfigSettings.sync_timeclock_with_agent)
+    {
+        Ros_Debug_BroadcastMsg("A start time was requested, but the clock is not synchronized with the Agent - Rejecting trajectory");
+        return INIT_TRAJ_START_TIME_NOT_SYNCED;
+    }
+
+    INT64 delay_ns = requestedStartTime_ns - Ros_ClockSync_Now();
+    if (delay_ns > (INT64)g_nodeConfigSettings.scheduled_start_horizon * 1000000LL)
+    {
+        Ros_Debug_BroadcastMsg("Requested start time is %lld ms in the future (max: %d ms) - Rejecting trajectory",
+            delay_ns / 1000000LL, g_nodeConfigSettings.scheduled_start_horizon);
+        return INIT_TRAJ_START_TIME_TOO_FAR;
+    }
+
+    return INIT_TRAJ_OK;
+}
+
+//-----------------------------------------------------------------------
+// Convert the time in the header of a trajectory into a start time for the
+// IncMoveTask. Returns 0 if the trajectory should start immediately.
+//-----------------------------------------------------------------------
+static INT64 Ros_MotionControl_GetScheduledStartTime(INT64 requestedStartTime_ns)
+{
+    //A non-zero stamp in the header requests execution to start at that (synchronized) time.
+    //The trajectory is converted and the increment queues are filled right away, so
+    //motion can start on the interpolation cycle closest to the requested time.
+    if (requestedStartTime_ns == 0)
+        return 0;
+
+    INT64 now_ns = Ros_ClockSync_Now();
+    if (requestedStartTime_ns <= now_ns)
+    {
+        Ros_Debug_BroadcastMsg("Requested start time is %lld ns in the past. Starting immediately.", now_ns - requestedStartTime_ns);
+        return 0;
+    }
+
+    Ros_Debug_BroadcastMsg("Trajectory execution scheduled to start in %lld ns", requestedStartTime_ns - now_ns);
+    return requestedStartTime_ns;
+}
+
 //-----------------------------------------------------------------------
 // Setup the first point of a trajectory
 //-----------------------------------------------------------------------
 Init_Trajectory_Status Ros_MotionControl_InitTrajectory(control_msgs__action__FollowJointTrajectory_SendGoal_Request* pending_ros_goal_request)
+{
+    if (pending_ros_goal_request == NULL)
+        return INIT_TRAJ_TOO_SMALL;
+
+    if (Ros_MotionControl_IsCartesianGoal(pending_ros_goal_request))
+    {
+        trajectory_msgs__msg__MultiDOFJointTrajectory* trajectory = &pending_ros_goal_request->goal.multi_dof_trajectory;
+        if (trajectory->points.size < MIN_NUMBER_OF_POINTS_PER_TRAJECTORY)
+            return INIT_TRAJ_TOO_SMALL;
+
+        Init_Trajectory_Status status = Ros_MotionControl_ValidateRequestedStartTime(Ros_Time_Msg_To_Nanos(&trajectory->header.stamp));
+        if (status != INIT_TRAJ_OK)
+            return status;
+
+        //joint tolerances can't be checked for a TCP, so don't pretend they are
+        if (pending_ros_goal_request->goal.goal_tolerance.size != 0 || pending_ros_goal_request->goal.path_tolerance.size != 0)
+        {
+            Ros_Debug_BroadcastMsg("Cartesian trajectories can't be checked against goal_tolerance or path_tolerance. Leave these empty.");
+            return INIT_TRAJ_UNSUPPORTED_TOLERANCE;
+        }
+
+        return Ros_MotionControl_InitCartesianTrajectory(trajectory,
+            Ros_MotionControl_GetScheduledStartTime(Ros_Time_Msg_To_Nanos(&trajectory->header.stamp)));
+    }
+
+    if (pending_ros_goal_request->goal.trajectory.points.size < MIN_NUMBER_OF_POINTS_PER_TRAJECTORY)
+        return INIT_TRAJ_TOO_SMALL;
+
+    Init_Trajectory_Status status = Ros_MotionControl_ValidateRequestedStartTime(
+        Ros_Time_Msg_To_Nanos(&pending_ros_goal_request->goal.trajectory.header.stamp));
+    if (status != INIT_TRAJ_OK)
+        return status;
+
+    INT64 scheduledStartTime_ns = Ros_MotionControl_GetScheduledStartTime(
+        Ros_Time_Msg_To_Nanos(&pending_ros_goal_request->goal.trajectory.header.stamp));
+
+    return Ros_MotionControl_Init(&pending_ros_goal_request->goal.trajectory.joint_names, &pending_ros_goal_request->goal.trajectory.points,
+        scheduledStartTime_ns);
+}
+
+//-----------------------------------------------------------------------
+// Convert and validate a trajectory while another one is still being executed.
+// The converted data is kept in the staging buffers until
+// Ros_MotionControl_ActivateStagedTrajectory is called.
+//-----------------------------------------------------------------------
+Init_Trajectory_Status Ros_MotionControl_StageTrajectory(control_msgs__action__FollowJointTrajectory_SendGoal_Request* pending_ros_goal_request)
 {
     if (pending_ros_goal_request == NULL || pending_ros_goal_request->goal.trajectory.points.size < MIN_NUMBER_OF_POINTS_PER_TRAJECTORY)
         return INIT_TRAJ_TOO_SMALL;
 
-    return Ros_MotionControl_Init(&pending_ros_goal_request->goal.trajectory.joint_names, &pending_ros_goal_request->goal.trajectory.points);
+    if (Ros_MotionControl_HasStagedTrajectoryData)
+    {
+        Ros_Debug_BroadcastMsg("A trajectory is already waiting to be executed - Rejecting new trajectory");
+        return INIT_TRAJ_ALREADY_IN_MOTION;
+    }
+
+    if (Ros_MotionControl_IsCartesianGoal(pending_ros_goal_request))
+    {
+        Ros_Debug_BroadcastMsg("Cartesian trajectories can't be staged - Rejecting new trajectory");
+        return INIT_TRAJ_ALREADY_IN_MOTION;
+    }
+
+    //the horizon is checked against the time the goal is received, not when it will be activated
+    Init_Trajectory_Status status = Ros_MotionControl_ValidateRequestedStartTime(
+        Ros_Time_Msg_To_Nanos(&pending_ros_goal_request->goal.trajectory.header.stamp));
+    if (status != INIT_TRAJ_OK)
+        return status;
+
+    status = Ros_MotionControl_ConvertTrajectory(&pending_ros_goal_request->goal.trajectory.joint_names,
+        &pending_ros_goal_request->goal.trajectory.points, /* bToStagingBuffer = */ TRUE, Ros_MotionControl_StagedGroupIsUsed);
+    if (status != INIT_TRAJ_OK)
+        return status;
+
+    Ros_MotionControl_StagedNumberOfPoints = pending_ros_goal_request->goal.trajectory.points.size;
+    Ros_MotionControl_StagedRequestedStartTime_ns = Ros_Time_Msg_To_Nanos(&pending_ros_goal_request->goal.trajectory.header.stamp);
+    Ros_MotionControl_HasStagedTrajectoryData = TRUE;
+
+    Ros_Debug_BroadcastMsg("Trajectory with %d points staged for execution", Ros_MotionControl_StagedNumberOfPoints);
+
+    return INIT_TRAJ_OK;
+}
+
+BOOL Ros_MotionControl_IsCartesianGoal(control_msgs__action__FollowJointTrajectory_SendGoal_Request const* ros_goal_request)
+{
+    return (ros_goal_request->goal.trajectory.points.size == 0) && (ros_goal_request->goal.multi_dof_trajectory.points.size > 0);
+}
+
+BOOL Ros_MotionControl_HasStagedTrajectory()
+{
+    return Ros_MotionControl_HasStagedTrajectoryData;
+}
+
+void Ros_MotionControl_DiscardStagedTrajectory()
+{
+    Ros_MotionControl_HasStagedTrajectoryData = FALSE;
+}
+
+//-----------------------------------------------------------------------
+// Hand over the staged trajectory to the AddToIncQueue tasks. The previous
+// trajectory must have been completed. The staging and active buffers are
+// swapped, no data is copied.
+//-----------------------------------------------------------------------
+Init_Trajectory_Status Ros_MotionControl_ActivateStagedTrajectory()
+{
+    int grpIndex;
+
+    if (!Ros_MotionControl_HasStagedTrajectoryData)
+        return INIT_TRAJ_TOO_SMALL;
+
+    if (Ros_MotionControl_HasDataToProcess())
+    {
+        Ros_Debug_BroadcastMsg("Previous trajectory still being processed - Can't activate staged trajectory");
+        return INIT_TRAJ_ALREADY_IN_MOTION;
+    }
+
+    Ros_MotionControl_AllGroupsInitComplete = FALSE;
+    Ros_MotionControl_HasStagedTrajectoryData = FALSE;
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        JointMotionData* completedTrajectory = ctrlGroup->trajectoryToProcess;
+
+        ctrlGroup->trajectoryIterator = NULL;
+        ctrlGroup->trajectoryToProcess = ctrlGroup->trajectoryToStage;
+        ctrlGroup->trajectoryToStage = completedTrajectory;
+    }
+
+    return Ros_MotionControl_ActivateTrajectory(Ros_MotionControl_StagedNumberOfPoints, Ros_MotionControl_StagedGroupIsUsed,
+        Ros_MotionControl_GetScheduledStartTime(Ros_MotionControl_StagedRequestedStartTime_ns));
+}
+
+//-----------------------------------------------------------------------
+// Cartesian trajectories
+//
+// A FollowJointTrajectory goal which has no joint trajectory points, but does have
+// 'multi_dof_trajectory' points, is executed in cartesian space. Each 'joint' in the
+// multi-dof trajectory is the TCP frame of a robot (as published on /tf), and each
+// transform is the pose of that TCP relative to the robot base frame (RF).
+// The AddToIncQueue task interpolates between these poses and sends cartesian (RF)
+// increments to the controller, which takes care of the inverse kinematics.
+//-----------------------------------------------------------------------
+
+//Cubic interpolation of one segment of a cartesian trajectory. Position uses the same cubic
+//interpolation as the joint trajectories. Orientation rotates about the fixed axis between
+//the two quaternions, with the angle following a cubic based on the angular velocities
+//(projected on that axis). Index 3 of the arrays is the rotation angle.
+typedef struct
+{
+    double axis[3];                     // rotation axis (RF) from start to end orientation
+    double startPos[4];                 // x, y, z, angle
+    double startVel[4];
+    double endPos[4];
+    double accCoef1[4];
+    double accCoef2[4];
+    double interval;                    // seconds
+} MotionControl_CartesianSegment;
+
+static void Ros_MotionControl_InitCartesianSegment(JointMotionData const* startTrajData, JointMotionData const* endTrajData,
+    MotionControl_CartesianSegment* segment)
+{
+    double angle = 0.0;
+    double startAngleVel = 0.0, endAngleVel = 0.0;
+    int i;
+
+    bzero(segment, sizeof(MotionControl_CartesianSegment));
+
+    //-------------------------------------
+    //rotation from start to end: q_delta = q_end * conj(q_start)
+    double const* qs = &startTrajData->pos[CARTESIAN_IDX_QX];
+    double qe[4];
+    memcpy(qe, &endTrajData->pos[CARTESIAN_IDX_QX], sizeof(qe));
+    if ((qs[0] * qe[0] + qs[1] * qe[1] + qs[2] * qe[2] + qs[3] * qe[3]) < 0.0)
+    {
+        //take the shortest path
+        for (i = 0; i < 4; i += 1)
+            qe[i] = -qe[i];
+    }
+
+    // (x, y, z, w) order
+    double qdx = qe[3] * -qs[0] + qe[0] * qs[3] + qe[1] * -qs[2] - qe[2] * -qs[1];
+    double qdy = qe[3] * -qs[1] - qe[0] * -qs[2] + qe[1] * qs[3] + qe[2] * -qs[0];
+    double qdz = qe[3] * -qs[2] + qe[0] * -qs[1] - qe[1] * -qs[0] + qe[2] * qs[3];
+    double qdw = qe[3] * qs[3] - qe[0] * -qs[0] - qe[1] * -qs[1] - qe[2] * -qs[2];
+
+    double sinHalfAngle = sqrt(qdx * qdx + qdy * qdy + qdz * qdz);
+    if (sinHalfAngle > 1.0e-12)
+    {
+        angle = 2.0 * atan2(sinHalfAngle, qdw);
+        segment->axis[0] = qdx / sinHalfAngle;
+        segment->axis[1] = qdy / sinHalfAngle;
+        segment->axis[2] = qdz / sinHalfAngle;
+
+        startAngleVel = startTrajData->vel[CARTESIAN_IDX_RX] * segment->axis[0] + startTrajData->vel[CARTESIAN_IDX_RY] * segment->axis[1] + startTrajData->vel[CARTESIAN_IDX_RZ] * segment->axis[2];
+        endAngleVel = endTrajData->vel[CARTESIAN_IDX_RX] * segment->axis[0] + endTrajData->vel[CARTESIAN_IDX_RY] * segment->axis[1] + endTrajData->vel[CARTESIAN_IDX_RZ] * segment->axis[2];
+    }
+
+    //-------------------------------------
+    // Calculate the acceleration coefficients
+    double endVel[4] = { endTrajData->vel[CARTESIAN_IDX_X], endTrajData->vel[CARTESIAN_IDX_Y], endTrajData->vel[CARTESIAN_IDX_Z], endAngleVel };
+    for (i = 0; i < 3; i++)
+    {
+        segment->startPos[i] = startTrajData->pos[CARTESIAN_IDX_X + i];
+        segment->startVel[i] = startTrajData->vel[CARTESIAN_IDX_X + i];
+        segment->endPos[i] = endTrajData->pos[CARTESIAN_IDX_X + i];
+    }
+    segment->startPos[3] = 0.0;
+    segment->startVel[3] = startAngleVel;
+    segment->endPos[3] = angle;
+
+    segment->interval = (endTrajData->time - startTrajData->time) / 1000.0;  // time difference in sec
+    if (segment->interval > 0.0)
+    {
+        double interval = segment->interval;
+        for (i = 0; i < 4; i++)
+        {
+            segment->accCoef1[i] = (6 * (segment->endPos[i] - segment->startPos[i]) / (interval * interval))
+                - (2 * (endVel[i] + 2 * segment->startVel[i]) / interval);
+            segment->accCoef2[i] = (-12 * (segment->endPos[i] - segment->startPos[i]) / (interval * interval * interval))
+                + (6 * (endVel[i] + segment->startVel[i]) / (interval * interval));
+        }
+    }
+}
+
+//Position (x, y, z) and rotation angle 'interpolTime' seconds into the segment
+static void Ros_MotionControl_InterpolateCartesianSegment(MotionControl_CartesianSegment const* segment, double interpolTime,
+    double interpolated[4])
+{
+    for (int i = 0; i < 4; i++)
+    {
+        interpolated[i] = segment->startPos[i]
+            + segment->startVel[i] * interpolTime
+            + segment->accCoef1[i] * interpolTime * interpolTime / 2
+            + segment->accCoef2[i] * interpolTime * interpolTime * interpolTime / 6;
+    }
+}
+
+//Reject trajectories which would move the TCP faster than 'max_cartesian_linear_speed' or
+//'max_cartesian_angular_speed'. Every segment is sampled at the interpolation period, which
+//gives the same increments as the ones which will be queued.
+static Init_Trajectory_Status Ros_MotionControl_CheckCartesianSpeed(JointMotionData const* trajectory, int numberOfPoints, int groupNo)
+{
+    double maxLinearSpeed = g_nodeConfigSettings.max_cartesian_linear_speed / 1000.0;          // m/s
+    double maxAngularSpeed = g_nodeConfigSettings.max_cartesian_angular_speed * RAD_PER_DEGREE; // rad/s
+    double period = g_Ros_Controller.interpolPeriod / 1000.0;                                   // s
+    MotionControl_CartesianSegment segment;
+
+    for (int pointIndex = 1; pointIndex < numberOfPoints; pointIndex += 1)
+    {
+        double prevInterpolated[4];
+        double prevTime = 0.0;
+
+        Ros_MotionControl_InitCartesianSegment(&trajectory[pointIndex - 1], &trajectory[pointIndex], &segment);
+        memcpy(prevInterpolated, segment.startPos, sizeof(prevInterpolated));
+
+        while (prevTime < segment.interval)
+        {
+            double interpolTime = (prevTime + period < segment.interval) ? (prevTime + period) : segment.interval;
+            double interpolated[4];
+
+            Ros_MotionControl_InterpolateCartesianSegment(&segment, interpolTime, interpolated);
+
+            double linearSpeed = sqrt(
+                pow(interpolated[0] - prevInterpolated[0], 2) +
+                pow(interpolated[1] - prevInterpolated[1], 2) +
+                pow(interpolated[2] - prevInterpolated[2], 2)) / (interpolTime - prevTime);
+            double angularSpeed = fabs(interpolated[3] - prevInterpolated[3]) / (interpolTime - prevTime);
+
+            if (linearSpeed > maxLinearSpeed || angularSpeed > maxAngularSpeed)
+            {
+                Ros_Debug_BroadcastMsg("Cartesian trajectory exceeds the maximum TCP speed (Group #%d, pt: %d).", groupNo, pointIndex);
+                Ros_Debug_BroadcastMsg(" - Speed: %.1f mm/s, %.1f deg/s (max: %d mm/s, %d deg/s)",
+                    linearSpeed * 1000.0, angularSpeed * DEGREES_PER_RAD,
+                    g_nodeConfigSettings.max_cartesian_linear_speed, g_nodeConfigSettings.max_cartesian_angular_speed);
+                return INIT_TRAJ_INVALID_VELOCITY;
+            }
+
+            memcpy(prevInterpolated, interpolated, sizeof(prevInterpolated));
+            prevTime = interpolTime;
+        }
+    }
+
+    return INIT_TRAJ_OK;
+}
+
+static void Ros_MotionControl_GetCurrentCartesianPose(CtrlGroup* ctrlGroup, double pose[MP_GRP_AXES_NUM])
+{
+    long pulsePos[MAX_PULSE_AXES];
+    long anglePos[MAX_PULSE_AXES];
+    BITSTRING figure;
+    MP_COORD coord;
+    Quaternion q;
+
+    Ros_CtrlGroup_GetPulsePosCmd(ctrlGroup, pulsePos);
+    mpConvPulseToAngle(ctrlGroup->groupNo, pulsePos, anglePos);
+    mpConvAxesToCartPos(ctrlGroup->groupNo, anglePos, ctrlGroup->tool, &figure, &coord);
+
+    QuatConversion_MpCoordOrient_To_GeomMsgsQuaternion(coord.rx, coord.ry, coord.rz, &q);
+
+    bzero(pose, sizeof(double) * MP_GRP_AXES_NUM);
+    pose[CARTESIAN_IDX_X] = MICROMETERS_TO_METERS((double)coord.x);
+    pose[CARTESIAN_IDX_Y] = MICROMETERS_TO_METERS((double)coord.y);
+    pose[CARTESIAN_IDX_Z] = MICROMETERS_TO_METERS((double)coord.z);
+    pose[CARTESIAN_IDX_QX] = q.x;
+    pose[CARTESIAN_IDX_QY] = q.y;
+    pose[CARTESIAN_IDX_QZ] = q.z;
+    pose[CARTESIAN_IDX_QW] = q.w;
+}
+
+static Init_Trajectory_Status Ros_MotionControl_ConvertCartesianTrajectory(trajectory_msgs__msg__MultiDOFJointTrajectory* trajectory,
+    BOOL bGroupIsUsed[MAX_CONTROLLABLE_GROUPS])
+{
+    char formatBuffer[MAX_TF_FRAME_NAME_LENGTH];
+    const char* frame_prefix = g_nodeConfigSettings.tf_frame_prefix;
+    int grpIndex, jointIndexInTraj, pointIndex;
+
+    bzero(bGroupIsUsed, sizeof(BOOL) * MAX_CONTROLLABLE_GROUPS);
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
+
+    for (jointIndexInTraj = 0; jointIndexInTraj < trajectory->joint_names.size; jointIndexInTraj += 1)
+    {
+        CtrlGroup* ctrlGroup = NULL;
+
+        //find the robot this TCP frame belongs to
+        for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        {
+            if (!Ros_CtrlGroup_IsRobot(g_Ros_Controller.ctrlGroups[grpIndex]))
+                continue;
+
+            snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tcp_%d", frame_prefix, grpIndex + 1, g_Ros_Controller.ctrlGroups[grpIndex]->tool);
+            if (strncmp(formatBuffer, trajectory->joint_names.data[jointIndexInTraj].data, MAX_TF_FRAME_NAME_LENGTH) == 0)
+            {
+                ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+                break;
+            }
+        }
+
+        if (ctrlGroup == NULL)
+        {
+            Ros_Debug_BroadcastMsg("Cartesian joint name [%s] is not valid. Valid names (TCP of the selected tool):", trajectory->joint_names.data[jointIndexInTraj].data);
+            for (int i = 0; i < g_Ros_Controller.numGroup; i += 1)
+            {
+                if (Ros_CtrlGroup_IsRobot(g_Ros_Controller.ctrlGroups[i]))
+                    Ros_Debug_BroadcastMsg(" - %sr%d/tcp_%d", frame_prefix, i + 1, g_Ros_Controller.ctrlGroups[i]->tool);
+            }
+            return INIT_TRAJ_INVALID_CARTESIAN_FRAME;
+        }
+
+        if (bGroupIsUsed[grpIndex])
+        {
+            Ros_Debug_BroadcastMsg("Cartesian joint name [%s] is used multiple times in the trajectory.", trajectory->joint_names.data[jointIndexInTraj].data);
+            return INIT_TRAJ_DUPLICATE_JOINT_NAME;
+        }
+
+        //poses must be relative to the base frame of the robot. An empty frame is taken to mean the same.
+        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/base", frame_prefix, grpIndex + 1);
+        if (trajectory->header.frame_id.size != 0 && strncmp(formatBuffer, trajectory->header.frame_id.data, MAX_TF_FRAME_NAME_LENGTH) != 0)
+        {
+            Ros_Debug_BroadcastMsg("Cartesian trajectory for [%s] must be relative to [%s] (not [%s]).",
+                trajectory->joint_names.data[jointIndexInTraj].data, formatBuffer, trajectory->header.frame_id.data);
+            return INIT_TRAJ_INVALID_CARTESIAN_FRAME;
+        }
+
+        JointMotionData* out = ctrlGroup->trajectoryToProcess;
+        for (pointIndex = 0; pointIndex < trajectory->points.size; pointIndex += 1)
+        {
+            trajectory_msgs__msg__MultiDOFJointTrajectoryPoint* point = &trajectory->points.data[pointIndex];
+
+            if (point->transforms.size != trajectory->joint_names.size ||
+                (point->velocities.size != 0 && point->velocities.size != trajectory->joint_names.size))
+            {
+                Ros_Debug_BroadcastMsg("Each point in the cartesian trajectory must have a transform (and optionally a velocity) for each TCP (pt: %d).", pointIndex);
+                return INIT_TRAJ_WRONG_NUMBER_OF_TRANSFORMS;
+            }
+
+            INT64 millis = Ros_Duration_Msg_To_Millis(&point->time_from_start);
+            if (millis < 0 || (millis == 0 && pointIndex != 0))
+            {
+                Ros_Debug_BroadcastMsg("The trajectory [time_from_start] may not be negative, and only be '0' for the first point (pt: %d).", pointIndex);
+                return INIT_TRAJ_INVALID_TIME;
+            }
+            if (pointIndex != 0 && millis <= out[pointIndex - 1].time)
+            {
+                Ros_Debug_BroadcastMsg("Each point in the trajectory must have a [time_from_start] greater than the previous (pt: %d).", pointIndex);
+                return INIT_TRAJ_BACKWARD_TIME;
+            }
+            out[pointIndex].time = millis;
+
+            geometry_msgs__msg__Transform* transform = &point->transforms.data[jointIndexInTraj];
+            double qNorm = sqrt(transform->rotation.x * transform->rotation.x + transform->rotation.y * transform->rotation.y +
+                transform->rotation.z * transform->rotation.z + transform->rotation.w * transform->rotation.w);
+            if (qNorm < EPSILON_TOLERANCE_DOUBLE)
+            {
+                Ros_Debug_BroadcastMsg("The orientation of each transform must be a valid quaternion (pt: %d).", pointIndex);
+                return INIT_TRAJ_INVALID_ORIENTATION;
+            }
+
+            out[pointIndex].pos[CARTESIAN_IDX_X] = transform->translation.x;
+            out[pointIndex].pos[CARTESIAN_IDX_Y] = transform->translation.y;
+            out[pointIndex].pos[CARTESIAN_IDX_Z] = transform->translation.z;
+            out[pointIndex].pos[CARTESIAN_IDX_QX] = transform->rotation.x / qNorm;
+            out[pointIndex].pos[CARTESIAN_IDX_QY] = transform->rotation.y / qNorm;
+            out[pointIndex].pos[CARTESIAN_IDX_QZ] = transform->rotation.z / qNorm;
+            out[pointIndex].pos[CARTESIAN_IDX_QW] = transform->rotation.w / qNorm;
+
+            if (point->velocities.size != 0)
+            {
+                geometry_msgs__msg__Twist* twist = &point->velocities.data[jointIndexInTraj];
+                out[pointIndex].vel[CARTESIAN_IDX_X] = twist->linear.x;
+                out[pointIndex].vel[CARTESIAN_IDX_Y] = twist->linear.y;
+                out[pointIndex].vel[CARTESIAN_IDX_Z] = twist->linear.z;
+                out[pointIndex].vel[CARTESIAN_IDX_RX] = twist->angular.x;
+                out[pointIndex].vel[CARTESIAN_IDX_RY] = twist->angular.y;
+                out[pointIndex].vel[CARTESIAN_IDX_RZ] = twist->angular.z;
+            }
+        }
+
+        //verify that the robot is commanded to stop at the end of the trajectory
+        JointMotionData* last = &out[trajectory->points.size - 1];
+        for (int i = 0; i < MP_GRP_AXES_NUM; i += 1)
+        {
+            if (fabs(last->vel[i]) > EPSILON_TOLERANCE_DOUBLE) // float version of "!=0"
+            {
+                Ros_Debug_BroadcastMsg("The final point in a trajectory must specify a target velocity of '0'.");
+                return INIT_TRAJ_INVALID_ENDING_VELOCITY;
+            }
+        }
+
+        Init_Trajectory_Status status = Ros_MotionControl_CheckCartesianSpeed(out, trajectory->points.size, ctrlGroup->groupNo);
+        if (status != INIT_TRAJ_OK)
+            return status;
+
+        bGroupIsUsed[grpIndex] = TRUE;
+    }
+
+    return INIT_TRAJ_OK;
+}
+
+static Init_Trajectory_Status Ros_MotionControl_InitCartesianTrajectory(trajectory_msgs__msg__MultiDOFJointTrajectory* trajectory,
+    INT64 scheduledStartTime_ns)
+{
+    int grpIndex;
+    BOOL bGroupIsUsed[MAX_CONTROLLABLE_GROUPS];
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        if (g_Ros_Controller.ctrlGroups[grpIndex]->hasDataToProcess)
+        {
+            Ros_Debug_BroadcastMsg("Already processing trajectory data - Rejecting new trajectory (Group #%d)",
+                g_Ros_Controller.ctrlGroups[grpIndex]->groupNo);
+            return INIT_TRAJ_ALREADY_IN_MOTION;
+        }
+    }
+
+    Ros_MotionControl_AllGroupsInitComplete = FALSE;
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryIterator = NULL;
+        g_Ros_Controller.ctrlGroups[grpIndex]->bCartesianTrajectory = FALSE;
+    }
+
+    Init_Trajectory_Status status = Ros_MotionControl_ConvertCartesianTrajectory(trajectory, bGroupIsUsed);
+    if (status != INIT_TRAJ_OK)
+        return status;
+
+    //the first pose must match the current TCP pose
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        if (!bGroupIsUsed[grpIndex])
+            continue;
+
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        double* start = ctrlGroup->trajectoryToProcess[0].pos;
+        double current[MP_GRP_AXES_NUM];
+        Ros_MotionControl_GetCurrentCartesianPose(ctrlGroup, current);
+
+        double posDeviation = sqrt(
+            pow(start[CARTESIAN_IDX_X] - current[CARTESIAN_IDX_X], 2) +
+            pow(start[CARTESIAN_IDX_Y] - current[CARTESIAN_IDX_Y], 2) +
+            pow(start[CARTESIAN_IDX_Z] - current[CARTESIAN_IDX_Z], 2));
+
+        double dot = fabs(start[CARTESIAN_IDX_QX] * current[CARTESIAN_IDX_QX] + start[CARTESIAN_IDX_QY] * current[CARTESIAN_IDX_QY] +
+            start[CARTESIAN_IDX_QZ] * current[CARTESIAN_IDX_QZ] + start[CARTESIAN_IDX_QW] * current[CARTESIAN_IDX_QW]);
+        double rotDeviation = 2.0 * acos(dot > 1.0 ? 1.0 : dot);
+
+        if (posDeviation > START_MAX_CARTESIAN_POS_DEVIATION || rotDeviation > START_MAX_CARTESIAN_ROT_DEVIATION)
+        {
+            Ros_Debug_BroadcastErrorMsg("Cartesian trajectory start pose doesn't match current TCP pose (Group #%d).", ctrlGroup->groupNo);
+            Ros_Debug_BroadcastMsg(" - Requested start: %.6f, %.6f, %.6f, %.6f, %.6f, %.6f, %.6f",
+                start[0], start[1], start[2], start[3], start[4], start[5], start[6]);
+            Ros_Debug_BroadcastMsg(" - Current pose: %.6f, %.6f, %.6f, %.6f, %.6f, %.6f, %.6f",
+                current[0], current[1], current[2], current[3], current[4], current[5], current[6]);
+            Ros_Debug_BroadcastMsg(" - Deviation: %.6f m, %.6f rad", posDeviation, rotDeviation);
+
+            for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+                bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
+            return INIT_TRAJ_INVALID_STARTING_POS;
+        }
+    }
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        if (!bGroupIsUsed[grpIndex])
+            continue;
+
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        Ros_Debug_BroadcastMsg("Initializing cartesian trajectory for group #%d", ctrlGroup->groupNo);
+
+        ctrlGroup->bCartesianTrajectory = TRUE;
+        bzero(ctrlGroup->cartesianIncRemainder, sizeof(ctrlGroup->cartesianIncRemainder));
+
+        ctrlGroup->prevTrajectoryIterator = ctrlGroup->trajectoryToProcess;
+        ctrlGroup->timeLeftover_ms = 0;
+        ctrlGroup->q_time = ctrlGroup->prevTrajectoryIterator->time;
+        Ros_CtrlGroup_GetPulsePosCmd(ctrlGroup, ctrlGroup->prevPulsePos);
+
+        for (int i = 0; i < trajectory->points.size; i += 1)
+            ctrlGroup->trajectoryToProcess[i].valid = TRUE;
+
+        ctrlGroup->trajectoryIterator = &ctrlGroup->trajectoryToProcess[1];
+        ctrlGroup->hasDataToProcess = TRUE;
+    }
+
+    Ros_MotionControl_ScheduledStartDone = FALSE;
+    Ros_MotionControl_ScheduledStartTime_ns = scheduledStartTime_ns;
+
+    Ros_MotionControl_AllGroupsInitComplete = TRUE;
+
+    return INIT_TRAJ_OK;
 }
 
 Init_Trajectory_Status Ros_MotionControl_InitPointQueue(motoros2_interfaces__srv__QueueTrajPoint_Request* request)
@@ -281,7 +945,7 @@ Init_Trajectory_Status Ros_MotionControl_InitPointQueue(motoros2_interfaces__srv
     pointSequence.size = 1;
     pointSequence.data = &request->point; //no additional memory is allocated this way
 
-    status = Ros_MotionControl_Init(&request->joint_names, &pointSequence);
+    status = Ros_MotionControl_Init(&request->joint_names, &pointSequence, /* scheduledStartTime_ns = */ 0);
 
     if (status == INIT_TRAJ_OK)
         Ros_MotionControl_MustInitializePointQueue = FALSE;
@@ -354,6 +1018,110 @@ Init_Trajectory_Status Ros_MotionControl_ConvertTrajectoryToJointMotionData(traj
     return INIT_TRAJ_OK;
 }
 
+//-----------------------------------------------------------------------
+// Interpolate the cartesian segment between prevTrajectoryIterator and trajectoryIterator
+// (see Ros_MotionControl_InitCartesianSegment) and add the resulting RF increments to the
+// queue. Increments are sent in micrometers and 0.0001 degrees. The fraction that is lost
+// by rounding is carried over to the next increment, so the commanded pose doesn't drift.
+//-----------------------------------------------------------------------
+static BOOL Ros_MotionControl_AddCartesianSegmentToIncQueue(CtrlGroup* ctrlGroup)
+{
+    JointMotionData* curTrajData = ctrlGroup->prevTrajectoryIterator;
+    JointMotionData* endTrajData = ctrlGroup->trajectoryIterator;
+    JointMotionData startTrajData;
+    MotionControl_CartesianSegment segment;
+    double prevInterpolated[4];         // x, y, z, angle of the previous interpolation cycle
+    UINT64 timeInc_ms;
+    UINT64 calculationTime_ms;
+    Incremental_data incData;
+    int i;
+
+    memcpy(&startTrajData, curTrajData, sizeof(JointMotionData));
+
+    bzero(&incData, sizeof(incData));
+    incData.frame = MP_INC_RF_DTYPE;
+    incData.tool = ctrlGroup->tool;
+
+    Ros_MotionControl_InitCartesianSegment(&startTrajData, endTrajData, &segment);
+    if (segment.interval <= 0.0)
+    {
+        Ros_Debug_BroadcastWarningMsg("Group %d - Time difference between endTrajData (%lld) and startTrajData (%lld) is 0 or less.\n", ctrlGroup->groupNo, endTrajData->time, startTrajData.time);
+    }
+
+    memcpy(prevInterpolated, segment.startPos, sizeof(prevInterpolated));
+
+    calculationTime_ms = startTrajData.time;
+    if (ctrlGroup->timeLeftover_ms == 0)
+        timeInc_ms = g_Ros_Controller.interpolPeriod;
+    else
+        timeInc_ms = ctrlGroup->timeLeftover_ms;
+
+    int iterationCounter = 0;
+    while ((curTrajData->time < endTrajData->time) && Ros_Controller_IsMotionReady())
+    {
+        double interpolated[4];
+
+        iterationCounter += 1;
+        //Relinquish CPU control after some number of iterations. Prevent starvation of other tasks.
+        if (iterationCounter >= 15) //15 is an arbitrary number
+        {
+            Ros_Sleep(g_Ros_Controller.interpolPeriod);
+            iterationCounter = 0;
+        }
+
+        calculationTime_ms += timeInc_ms;
+        double interpolTime = (calculationTime_ms - startTrajData.time) / 1000.0;
+
+        if (calculationTime_ms < endTrajData->time)  // Make calculation for full interpolation clock
+        {
+            curTrajData->time = calculationTime_ms;
+
+            Ros_MotionControl_InterpolateCartesianSegment(&segment, interpolTime, interpolated);
+
+            if (timeInc_ms < g_Ros_Controller.interpolPeriod)
+            {
+                timeInc_ms = g_Ros_Controller.interpolPeriod;
+                ctrlGroup->timeLeftover_ms = 0;
+            }
+        }
+        else  // Make calculation for partial interpolation cycle
+        {
+            curTrajData->time = endTrajData->time;
+            memcpy(interpolated, segment.endPos, sizeof(interpolated));
+
+            if (calculationTime_ms > endTrajData->time)
+                ctrlGroup->timeLeftover_ms = calculationTime_ms - endTrajData->time;
+        }
+
+        //-------------------------------------
+        // Increments in RF: translation in micrometers, rotation (about the RF axes) in 0.0001 degrees
+        double inc[MP_GRP_AXES_NUM];
+        bzero(inc, sizeof(inc));
+        for (i = 0; i < 3; i++)
+            inc[i] = METERS_TO_MICROMETERS(interpolated[i] - prevInterpolated[i]);
+        for (i = 0; i < 3; i++)
+            inc[3 + i] = RAD_TO_DEG_0001(segment.axis[i] * (interpolated[3] - prevInterpolated[3]));
+
+        incData.time = curTrajData->time;
+        for (i = 0; i < 6; i++)
+        {
+            inc[i] += ctrlGroup->cartesianIncRemainder[i];
+            incData.inc[i] = (LONG)((inc[i] >= 0.0) ? (inc[i] + 0.5) : (inc[i] - 0.5));
+            ctrlGroup->cartesianIncRemainder[i] = inc[i] - incData.inc[i];
+        }
+
+        if (!Ros_MotionControl_AddPulseIncPointToQ(ctrlGroup, &incData))
+            return FALSE;
+
+        memcpy(prevInterpolated, interpolated, sizeof(prevInterpolated));
+    }
+
+    //the end of this segment is the start of the next one
+    memcpy(curTrajData, endTrajData, sizeof(JointMotionData));
+
+    return TRUE;
+}
+
 //-----------------------------------------------------------------------
 // Task that handles in the background messages that may have long processing
 // time so that they don't block other message from being processed.
@@ -371,16 +1139,34 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
             {
                 if (g_Ros_Controller.bStopMotion)
                 {
-                    bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                    bzero(ctrlGroup->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
                     ctrlGroup->hasDataToProcess = FALSE;
                     continue;
                 }
 
-                Ros_Debug_BroadcastMsg("Processing next point in trajectory [Group #%d - T=%.3f: (%7.4f, %7.4f, %7.4f, %7.4f, %7.4f, %7.4f)]",
+                Ros_Debug_BroadcastDebugMsg("Processing next point in trajectory [Group #%d - T=%.3f: (%7.4f, %7.4f, %7.4f, %7.4f, %7.4f, %7.4f)]",
                     ctrlGroup->groupNo, (double)ctrlGroup->trajectoryIterator->time * 0.001,
                     ctrlGroup->trajectoryIterator->pos[0], ctrlGroup->trajectoryIterator->pos[1], ctrlGroup->trajectoryIterator->pos[2],
                     ctrlGroup->trajectoryIterator->pos[3], ctrlGroup->trajectoryIterator->pos[4], ctrlGroup->trajectoryIterator->pos[5]);
 
+                if (ctrlGroup->bCartesianTrajectory)
+                {
+                    BOOL bSegmentOk = Ros_MotionControl_AddCartesianSegmentToIncQueue(ctrlGroup);
+                    ctrlGroup->prevTrajectoryIterator->valid = FALSE;
+
+                    if (!bSegmentOk || ctrlGroup->trajectoryIterator == &ctrlGroup->trajectoryToProcess[MAX_NUMBER_OF_POINTS_PER_TRAJECTORY])
+                    {
+                        bzero(ctrlGroup->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
+                        ctrlGroup->hasDataToProcess = FALSE;
+                    }
+                    else
+                    {
+                        ctrlGroup->prevTrajectoryIterator += 1;
+                        ctrlGroup->trajectoryIterator += 1;
+                    }
+                    continue;
+                }
+
                 //-------------------------------------
                 // Check that incoming data is valid
                 for (i = 0; i < ctrlGroup->numAxes; i++)
@@ -389,10 +1175,10 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
                     if (abs(ctrlGroup->trajectoryIterator->vel[i]) > ctrlGroup->maxSpeed[i])
                     {
                         // excessive speed
-                        Ros_Debug_BroadcastMsg("ERROR: Invalid speed in message TrajPointFull data: \n  axis: %d, speed: %f, limit: %f\n",
+                        Ros_Debug_BroadcastErrorMsg("Invalid speed in message TrajPointFull data: \n  axis: %d, speed: %f, limit: %f\n",
                             i, ctrlGroup->trajectoryIterator->vel[i], ctrlGroup->maxSpeed[i]);
 
-                        bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                        bzero(ctrlGroup->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
                         ctrlGroup->hasDataToProcess = FALSE;
                         continue;
                     }
@@ -450,7 +1236,7 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
                 }
                 else
                 {
-                    Ros_Debug_BroadcastMsg("Warning: Group %d - Time difference between endTrajData (%lld) and startTrajData (%lld) is 0 or less.\n", ctrlGroup->groupNo, endTrajData->time, startTrajData->time);
+                    Ros_Debug_BroadcastWarningMsg("Group %d - Time difference between endTrajData (%lld) and startTrajData (%lld) is 0 or less.\n", ctrlGroup->groupNo, endTrajData->time, startTrajData->time);
                 }
 
                 // Initialize calculation variable before entering while loop
@@ -460,6 +1246,8 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
                 else
                     timeInc_ms = ctrlGroup->timeLeftover_ms;
 
+                MOTOROS2_TASK_TRACE_BEGIN(TASK_TRACE_TASK_ADD_TO_INC_QUEUE + ctrlGroup->groupNo, TASK_TRACE_POINT_INTERPOLATE_POINT);
+
                 int iterationCounter = 0;
                 // While interpolation time is smaller than new ROS point time
                 while ((curTrajData->time < endTrajData->time) && Ros_Controller_IsMotionReady())
@@ -468,7 +1256,9 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
                     //Relinquish CPU control after some number of iterations. Prevent starvation of other tasks.
                     if (iterationCounter >= 15) //15 is an arbitrary number
                     {
+                        MOTOROS2_TASK_TRACE_BEGIN(TASK_TRACE_TASK_ADD_TO_INC_QUEUE + ctrlGroup->groupNo, TASK_TRACE_POINT_INTERPOLATE_YIELD);
                         Ros_Sleep(g_Ros_Controller.interpolPeriod);
+                        MOTOROS2_TASK_TRACE_END(TASK_TRACE_TASK_ADD_TO_INC_QUEUE + ctrlGroup->groupNo, TASK_TRACE_POINT_INTERPOLATE_YIELD);
                         iterationCounter = 0;
                     }
 
@@ -532,7 +1322,7 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
                     // Add the increment to the queue
                     if (!Ros_MotionControl_AddPulseIncPointToQ(ctrlGroup, &incData))
                     {
-                        bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                        bzero(ctrlGroup->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
                         ctrlGroup->hasDataToProcess = FALSE;
                         continue;
                     }
@@ -541,13 +1331,15 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
                     memcpy(ctrlGroup->prevPulsePos, newPulsePos, sizeof(ctrlGroup->prevPulsePos));
                 }
 
+                MOTOROS2_TASK_TRACE_END(TASK_TRACE_TASK_ADD_TO_INC_QUEUE + ctrlGroup->groupNo, TASK_TRACE_POINT_INTERPOLATE_POINT);
+
                 curTrajData->valid = FALSE;
 
                 if (Ros_MotionControl_IsMotionMode_Trajectory())
                 {
                     if (ctrlGroup->trajectoryIterator == &ctrlGroup->trajectoryToProcess[MAX_NUMBER_OF_POINTS_PER_TRAJECTORY]) //pointing to last possible entry in the array; don't increment iterator
                     {
-                        bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                        bzero(ctrlGroup->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
                         ctrlGroup->hasDataToProcess = FALSE;
                         Ros_Debug_BroadcastMsg("Done processing final point in trajectory (Group #%d)", ctrlGroup->groupNo);
                     }
@@ -568,7 +1360,7 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
             {
                 if (Ros_MotionControl_IsMotionMode_Trajectory())
                 {
-                    bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                    bzero(ctrlGroup->trajectoryToProcess, SIZEOF_TRAJECTORY_BUFFER);
                     ctrlGroup->hasDataToProcess = FALSE;
                 }
             }
@@ -578,6 +1370,11 @@ void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
     } // WHILE (TRUE)
 }
 
+void Ros_MotionControl_ResetPointQueue()
+{
+    Ros_MotionControl_MustInitializePointQueue = TRUE;
+}
+
 //-------------------------------------------------------------------
 // Adds pulse increments for one interpolation period to the inc move queue
 //-------------------------------------------------------------------
@@ -613,7 +1410,7 @@ BOOL Ros_MotionControl_AddPulseIncPointToQ(CtrlGroup* ctrlGroup, Incremental_dat
     }
     else
     {
-        Ros_Debug_BroadcastMsg("ERROR: Unable to add point to queue.  Queue is locked up! (Group #%d)", ctrlGroup->groupNo);
+        Ros_Debug_BroadcastErrorMsg("Unable to add point to queue.  Queue is locked up! (Group #%d)", ctrlGroup->groupNo);
         return FALSE;
     }
 
@@ -622,6 +1419,12 @@ BOOL Ros_MotionControl_AddPulseIncPointToQ(CtrlGroup* ctrlGroup, Incremental_dat
 
 UINT8 Ros_MotionControl_ProcessQueuedTrajectoryPoint(motoros2_interfaces__srv__QueueTrajPoint_Request* request)
 {
+    if (Ros_TwistServo_IsActive())
+    {
+        Ros_Debug_BroadcastMsg("Robot is being moved by twist commands");
+        return motoros2_interfaces__msg__QueueResultEnum__BUSY;
+    }
+
     if (Ros_MotionControl_MustInitializePointQueue)
     {
         Ros_Debug_BroadcastMsg("Initial point in trajectory queue");
@@ -783,6 +1586,14 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
     BOOL queueRead[MAX_CONTROLLABLE_GROUPS];                            // Flag indicating that new increment data was retrieve from the queue on this cycle.
     BOOL isMissingPulse;                                                // Flag that there are pulses send in last cycle that are missing from the command (pulses were not processed)
     BOOL hasUnprocessedData;                                            // Flag that at least one axis (any group) still has unprecessed data. (Used to continue sending data after the queue is empty.)
+    BOOL prevCycleCartesian[MAX_CONTROLLABLE_GROUPS];                   // Flag that cartesian increments were sent for the group on the previous cycle
+
+    // --- Execution statistics (reported at the end of each FJT goal) ---
+    BOOL bQueueUnderrun;                                                // Flag that a group's queue ran dry while its trajectory was still being processed
+    BOOL bFsuLimited;                                                   // Flag that pulses sent in the last cycle were not (all) processed for at least one group
+    LONG peakBacklogPulses;                                             // Largest absolute 'toProcessPulses' (any axis, any group) for this cycle
+    int numQueuedIncrements;                                            // Increments left in the queues of all groups after reading this cycle's (telemetry only)
+    UINT16 queueReadMask;                                               // Groups which got increments from their queue this cycle (telemetry only)
 
     bzero(newPulseInc, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
     bzero(toProcessPulses, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
@@ -793,12 +1604,17 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
     bzero(maxSpeedRemain, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
     bzero(skipReadingQ, sizeof(BOOL) * MAX_CONTROLLABLE_GROUPS);
     bzero(queueRead, sizeof(BOOL) * MAX_CONTROLLABLE_GROUPS);
+    bzero(prevCycleCartesian, sizeof(BOOL) * MAX_CONTROLLABLE_GROUPS);
 
     isMissingPulse = FALSE;
     hasUnprocessedData = FALSE;
 
     Ros_Debug_BroadcastMsg("IncMoveTask Started");
 
+    //until determined otherwise in the first cycles
+    Ros_MotionControl_bInMotion = TRUE;
+    Ros_MotionControl_bCommandStateValid = FALSE;
+
     bzero(&moveData, sizeof(moveData));
 
     for (i = 0; i < g_Ros_Controller.numGroup; i++)
@@ -814,10 +1630,21 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
     {
         mpClkAnnounce(MP_INTERPOLATION_CLK);
 
+        MOTOROS2_TASK_TRACE_BEGIN(TASK_TRACE_TASK_INCMOVE, TASK_TRACE_POINT_INCMOVE_CYCLE);
+
+        Ros_JointStateCapture_Sample();
+
         if (Ros_Controller_IsMotionReady()
             && (Ros_MotionControl_HasDataInQueue() || hasUnprocessedData)
-            && !g_Ros_Controller.bStopMotion)
+            && !g_Ros_Controller.bStopMotion
+            && !Ros_MotionControl_IsScheduledStartPending())
         {
+            bQueueUnderrun = FALSE;
+            bFsuLimited = FALSE;
+            peakBacklogPulses = 0;
+            numQueuedIncrements = 0;
+            queueReadMask = 0;
+
             // For each control group, retrieve the new pulse increments for this cycle
             for (i = 0; i < g_Ros_Controller.numGroup; i++)
             {
@@ -892,19 +1719,28 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
                         }
                         else
                         {
-                            // Queue is empty, initialize to 0 pulse increment
+                            // Queue is empty. If the trajectory for this group isn't finished yet,
+                            // the AddToIncQueue task didn't keep up.
+                            if (g_Ros_Controller.ctrlGroups[i]->hasDataToProcess)
+                                bQueueUnderrun = TRUE;
+
+                            // Initialize to 0 pulse increment
                             moveData.grp_pos_info[i].pos_tag.data[2] = 0;
                             moveData.grp_pos_info[i].pos_tag.data[3] = MP_INC_PULSE_DTYPE;
                             moveData.grp_pos_info[i].pos_tag.data[4] = 0;
                             bzero(&moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
                         }
 
+                        numQueuedIncrements += q->cnt;
+                        if (queueRead[i])
+                            queueReadMask |= (0x01 << i);
+
                         // Unlock the q
                         mpSemGive(q->q_lock);
                     }
                     else
                     {
-                        Ros_Debug_BroadcastMsg("ERROR: Can't get data from queue. Queue is locked up (Group #%d)", g_Ros_Controller.ctrlGroups[i]->groupNo);
+                        Ros_Debug_BroadcastErrorMsg("Can't get data from queue. Queue is locked up (Group #%d)", g_Ros_Controller.ctrlGroups[i]->groupNo);
                         bzero(&moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
                         continue;
                     }
@@ -916,6 +1752,25 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
             {
                 memcpy(newPulseInc[i], moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
 
+                // Cartesian increments can't be compared with the pulse feedback, so the FSU
+                // tracking below doesn't apply to them. Resynchronize the feedback position
+                // instead (also on the first cycle after cartesian increments were sent).
+                BOOL bCartesianInc = (moveData.grp_pos_info[i].pos_tag.data[3] != MP_INC_PULSE_DTYPE);
+                if (bCartesianInc || prevCycleCartesian[i])
+                {
+                    prevCycleCartesian[i] = bCartesianInc;
+
+                    ctrlGrpData.sCtrlGrp = g_Ros_Controller.ctrlGroups[i]->groupId;
+                    mpGetPulsePos(&ctrlGrpData, &prevPulsePosData[i]);
+                    bzero(toProcessPulses[i], sizeof(LONG) * MP_GRP_AXES_NUM);
+                    bzero(prevMaxSpeed[i], sizeof(LONG) * MP_GRP_AXES_NUM);
+                    bzero(prevMaxSpeedRemain[i], sizeof(LONG) * MP_GRP_AXES_NUM);
+                    skipReadingQ[i] = FALSE;
+
+                    if (bCartesianInc)
+                        continue;
+                }
+
                 // record the speed associate with the next amount of pulses
                 if (queueRead[i])
                 {
@@ -950,6 +1805,9 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
 
                     if (toProcessPulses[i][axis] != 0)
                         hasUnprocessedData = TRUE;
+
+                    if (abs(toProcessPulses[i][axis]) > peakBacklogPulses)
+                        peakBacklogPulses = abs(toProcessPulses[i][axis]);
                 }
 
                 // Check if pulses are missing which means that the FSU speed limit is enabled
@@ -957,6 +1815,8 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
                 {
                     UINT64 max_inc;
 
+                    bFsuLimited = TRUE;
+
                     // Prevent going faster than original requested speed once speed limit turns off
                     // Check if the speed (inc) of previous interation should be considered by checking 
                     // if the unprocessed pulses from that speed setting still remains.
@@ -1011,7 +1871,7 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
                                 max_inc = g_Ros_Controller.ctrlGroups[i]->maxInc.maxIncrement[axis];
 
                             if(max_inc > 1)
-                                Ros_Debug_BroadcastMsg("Warning undefined speed: Axis %d Defaulting Max Inc: %d (prevSpeed: %d curSpeed %d)",
+                                Ros_Debug_BroadcastWarningMsg("Undefined speed: Axis %d Defaulting Max Inc: %d (prevSpeed: %d curSpeed %d)",
                                 axis, max_inc, prevMaxSpeed[i][axis], maxSpeed[i][axis]);
 
                         }
@@ -1048,13 +1908,18 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
             if (!g_Ros_Controller.bStopMotion && (g_Ros_Communication_AgentIsConnected || !g_nodeConfigSettings.stop_motion_on_disconnect))
             {
                 // Send pulse increment to the controller command position
+                MOTOROS2_TASK_TRACE_BEGIN(TASK_TRACE_TASK_INCMOVE, TASK_TRACE_POINT_INCMOVE_SEND);
                 ret = mpExRcsIncrementMove(&moveData);
+                MOTOROS2_TASK_TRACE_END(TASK_TRACE_TASK_INCMOVE, TASK_TRACE_POINT_INCMOVE_SEND);
 
-                Ros_ActionServer_FJT_UpdateProgressTracker(&moveData);
+                Ros_ActionServer_FJT_UpdateExecutionStats(bQueueUnderrun, bFsuLimited, peakBacklogPulses);
             }
             else
                 ret = 0;
 
+            Ros_Telemetry_Record(TELEMETRY_EVENT_INCMOVE_CYCLE, queueReadMask, numQueuedIncrements, peakBacklogPulses, ret,
+                (bQueueUnderrun ? 0x01 : 0) | (bFsuLimited ? 0x02 : 0));
+
             if (ret != 0)
             {
                 // Failure: command rejected by controller.
@@ -1120,9 +1985,198 @@ void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
                 mpGetPulsePos(&ctrlGrpData, &prevPulsePosData[i]);
             }
         }
+
+        //prevPulsePosData now holds the command position of all groups for this cycle
+        Ros_MotionControl_UpdateCommandState(prevPulsePosData);
+        Ros_MotionControl_UpdateInMotion(hasUnprocessedData);
+
+        //the increment for this cycle was taken from the queue, so it can be refilled
+        Ros_TwistServo_NotifyInterpolationCycle();
+
+        MOTOROS2_TASK_TRACE_END(TASK_TRACE_TASK_INCMOVE, TASK_TRACE_POINT_INCMOVE_CYCLE);
+    }
+}
+
+//-------------------------------------------------------------------
+// Record the command position the IncMoveTask read in this cycle, and
+// derive the command velocity from the change since the previous cycle.
+// Called from the IncMoveTask once per interpolation cycle.
+//-------------------------------------------------------------------
+static void Ros_MotionControl_UpdateCommandState(MP_PULSE_POS_RSP_DATA const cmdPulsePosData[MAX_CONTROLLABLE_GROUPS])
+{
+    MotionControl_CommandState* const state = &Ros_MotionControl_CommandState;
+    long cmdPulsePos[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+    INT64 timestamp = Ros_ClockSync_Now();
+    double cyclesPerSecond = 1000.0 / g_Ros_Controller.interpolPeriod;
+    BOOL bHasPrevious = Ros_MotionControl_bCommandStateValid;
+
+    for (int groupNo = 0; groupNo < g_Ros_Controller.numGroup; groupNo += 1)
+    {
+        for (int axis = 0; axis < MAX_PULSE_AXES; axis += 1)
+            cmdPulsePos[groupNo][axis] = cmdPulsePosData[groupNo].lPos[axis];
+        Ros_CtrlGroup_CompensateBaxisCmd(g_Ros_Controller.ctrlGroups[groupNo], cmdPulsePos[groupNo]);
+    }
+
+    Ros_MotionControl_CommandStateSeq += 1; //odd: update in progress
+
+    for (int groupNo = 0; groupNo < g_Ros_Controller.numGroup; groupNo += 1)
+    {
+        for (int axis = 0; axis < MAX_PULSE_AXES; axis += 1)
+        {
+            state->pulseSpeed[groupNo][axis] = bHasPrevious ?
+                (long)((cmdPulsePos[groupNo][axis] - state->pulsePos[groupNo][axis]) * cyclesPerSecond) : 0;
+            state->pulsePos[groupNo][axis] = cmdPulsePos[groupNo][axis];
+        }
+    }
+    state->timestamp = timestamp;
+
+    Ros_MotionControl_CommandStateSeq += 1; //even: update complete
+    Ros_MotionControl_bCommandStateValid = TRUE;
+}
+
+//-------------------------------------------------------------------
+// Copy the command position of all groups, as last recorded by the
+// IncMoveTask. Returns FALSE if no command position is available (yet).
+//-------------------------------------------------------------------
+BOOL Ros_MotionControl_GetCommandState(MotionControl_CommandState* const state)
+{
+    UINT32 seq;
+
+    if (!Ros_MotionControl_bCommandStateValid)
+        return FALSE;
+
+    //The IncMoveTask has a higher priority, so it can update the state while it is being
+    //copied. Retry until a copy was made without an update in between.
+    do
+    {
+        seq = Ros_MotionControl_CommandStateSeq;
+        memcpy(state, &Ros_MotionControl_CommandState, sizeof(MotionControl_CommandState));
+    } while ((seq & 1) || (seq != Ros_MotionControl_CommandStateSeq));
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Determine whether the robot is moving, using the command position
+// recorded in this cycle (see Ros_MotionControl_UpdateCommandState).
+// Called from the IncMoveTask once per interpolation cycle.
+// The robot is moving while there are increments queued or still to be
+// processed, or while the command position changes (also for motion not
+// commanded by MotoROS2). Once the command position is stationary, the
+// feedback position is read until it has caught up with the command
+// position. This is the only time the controller is accessed, so a robot
+// which is standing still costs no more than a few comparisons.
+// Motion is reported immediately, but the robot is only reported as
+// stationary after IN_MOTION_CLEAR_CYCLES cycles without motion, so the
+// state doesn't toggle while it settles. If the feedback position can't
+// be read, the state is ERROR until it can.
+//-------------------------------------------------------------------
+static void Ros_MotionControl_UpdateInMotion(BOOL hasUnprocessedData)
+{
+    static int cyclesWithoutMotion = 0;
+    BOOL bMotion = hasUnprocessedData;
+
+    for (int groupNo = 0; !bMotion && groupNo < g_Ros_Controller.numGroup; groupNo += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupNo];
+        long const* cmdPulseSpeed = Ros_MotionControl_CommandState.pulseSpeed[groupNo];
+
+        //The count is read without taking the lock: a concurrent change is seen one cycle later at worst
+        if (ctrlGroup->inc_q.cnt > 0)
+        {
+            bMotion = TRUE;
+            break;
+        }
+
+        for (int i = 0; i < ctrlGroup->numValidAxes; i += 1)
+        {
+            if (cmdPulseSpeed[ctrlGroup->validAxes[i]] != 0)
+                bMotion = TRUE;
+        }
+    }
+
+    //Nothing is commanded anymore. Wait for the feedback position to settle, unless that
+    //has been confirmed already.
+    for (int groupNo = 0; !bMotion && Ros_MotionControl_bInMotion != FALSE && groupNo < g_Ros_Controller.numGroup; groupNo += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupNo];
+        long const* cmdPulsePos = Ros_MotionControl_CommandState.pulsePos[groupNo];
+        long fbPulsePos[MAX_PULSE_AXES];
+
+        if (!Ros_CtrlGroup_GetFBPulsePos(ctrlGroup, fbPulsePos))
+        {
+            cyclesWithoutMotion = 0;
+            Ros_MotionControl_bInMotion = ERROR;
+            return;
+        }
+
+        //Check if the feeback position has caught up to the command position
+        for (int i = 0; i < ctrlGroup->numValidAxes; i += 1)
+        {
+            int axis = ctrlGroup->validAxes[i];
+            if (abs(fbPulsePos[axis] - cmdPulsePos[axis]) > START_MAX_PULSE_DEVIATION)
+                bMotion = TRUE;
+        }
+    }
+
+    if (bMotion)
+    {
+        cyclesWithoutMotion = 0;
+        Ros_MotionControl_bInMotion = TRUE;
+    }
+    else if (cyclesWithoutMotion < IN_MOTION_CLEAR_CYCLES)
+    {
+        cyclesWithoutMotion += 1;
+        if (cyclesWithoutMotion == IN_MOTION_CLEAR_CYCLES)
+            Ros_MotionControl_bInMotion = FALSE;
     }
 }
 
+//-------------------------------------------------------------------
+// Whether the robot is moving (see Ros_MotionControl_UpdateInMotion).
+// Returns ERROR if this could not be determined.
+//-------------------------------------------------------------------
+BOOL Ros_MotionControl_IsInMotion()
+{
+    return Ros_MotionControl_bInMotion;
+}
+
+//-------------------------------------------------------------------
+// Check whether the IncMoveTask must keep holding the data in the queue
+// because the scheduled start time has not been reached yet.
+// Called from the IncMoveTask once per interpolation cycle.
+//-------------------------------------------------------------------
+static BOOL Ros_MotionControl_IsScheduledStartPending()
+{
+    INT64 scheduledStartTime_ns = Ros_MotionControl_ScheduledStartTime_ns;
+
+    if (scheduledStartTime_ns == 0)
+        return FALSE;
+
+    // Start on the interpolation cycle closest to the requested time
+    INT64 now_ns = Ros_ClockSync_Now();
+    INT64 halfInterpolPeriod_ns = (INT64)g_Ros_Controller.interpolPeriod * 500000LL;
+    if (now_ns + halfInterpolPeriod_ns < scheduledStartTime_ns)
+        return TRUE;
+
+    Ros_MotionControl_ScheduledStartActualTime_ns = now_ns;
+    Ros_MotionControl_ScheduledStartError_ns = now_ns - scheduledStartTime_ns;
+    Ros_MotionControl_ScheduledStartDone = TRUE;
+    Ros_MotionControl_ScheduledStartTime_ns = 0;
+
+    return FALSE;
+}
+
+BOOL Ros_MotionControl_GetScheduledStartResult(INT64* actualStartTime_ns, INT64* startError_ns)
+{
+    if (!Ros_MotionControl_ScheduledStartDone)
+        return FALSE;
+
+    *actualStartTime_ns = Ros_MotionControl_ScheduledStartActualTime_ns;
+    *startError_ns = Ros_MotionControl_ScheduledStartError_ns;
+    return TRUE;
+}
+
 //-------------------------------------------------------------------
 // Check the number of inc_move currently in the specified queue
 //-------------------------------------------------------------------
@@ -1148,7 +2202,7 @@ int Ros_MotionControl_GetQueueCnt(int groupNo)
         return count;
     }
 
-    Ros_Debug_BroadcastMsg("ERROR: Unable to access queue count.  Queue is locked up! (Group #%d)", groupNo);
+    Ros_Debug_BroadcastErrorMsg("Unable to access queue count.  Queue is locked up! (Group #%d)", groupNo);
     return ERROR;
 }
 
@@ -1259,12 +2313,12 @@ BOOL Ros_MotionControl_StopMotion(BOOL bKeepJobRunning)
         mpStartJob(&startJobData, &stdRspData);
         if (stdRspData.err_no != 0)
         {
-            Ros_Debug_BroadcastMsg("WARNING: mpStartJob error: %d", stdRspData.err_no);
+            Ros_Debug_BroadcastWarningMsg("mpStartJob error: %d", stdRspData.err_no);
         }
     }
 
     if (checkCnt >= MOTION_STOP_TIMEOUT)
-        Ros_Debug_BroadcastMsg("WARNING: Message processing not stopped before clearing queue");
+        Ros_Debug_BroadcastWarningMsg("Message processing not stopped before clearing queue");
 
     return(bStopped && bRet);
 }
@@ -1276,6 +2330,9 @@ BOOL Ros_MotionControl_ClearQ_All()
 {
     BOOL bRet = TRUE;
 
+    // Drop any pending scheduled start along with the queued data
+    Ros_MotionControl_ScheduledStartTime_ns = 0;
+
     for (int groupNo = 0; groupNo < g_Ros_Controller.numGroup; groupNo++)
     {
         // Stop addtional items from being added to the queue
@@ -1367,8 +2424,14 @@ BOOL Ros_MotionControl_StartMotionMode(MOTION_MODE mode)
 
     Ros_Debug_BroadcastMsg("%s: enter", __func__);
 
-    if (Ros_MotionControl_ActiveMotionMode != MOTION_MODE_INACTIVE &&
-        Ros_MotionControl_ActiveMotionMode != mode)
+    //The motion mode lock is only held while the mode and the queues are accessed, not while
+    //waiting for the controller, so the callbacks which depend on the mode aren't blocked
+    Ros_Communication_LockMotionMode();
+    BOOL bOtherModeActive = (Ros_MotionControl_ActiveMotionMode != MOTION_MODE_INACTIVE &&
+        Ros_MotionControl_ActiveMotionMode != mode);
+    Ros_Communication_UnlockMotionMode();
+
+    if (bOtherModeActive)
     {
         Ros_Debug_BroadcastMsg("Another trajectory mode (%d) is already active.", mode);
         return FALSE;
@@ -1511,6 +2574,8 @@ BOOL Ros_MotionControl_StartMotionMode(MOTION_MODE mode)
     }
 #endif
 
+    Ros_Communication_LockMotionMode();
+
     // make sure that there is no data in the queues
     if (Ros_MotionControl_HasDataInQueue())
     {
@@ -1530,6 +2595,8 @@ BOOL Ros_MotionControl_StartMotionMode(MOTION_MODE mode)
         }
     }
 
+    Ros_Communication_UnlockMotionMode();
+
     // Start Job
     bzero(&rData, sizeof(rData));
     bzero(&sStartData, sizeof(sStartData));
@@ -1566,7 +2633,10 @@ updateStatus:
     //Required to allow motion api to work (Potential race condition)
     Ros_Sleep(200);
 
-    if (Ros_Controller_IsMotionReady())
+    BOOL bActivated = FALSE;
+    Ros_Communication_LockMotionMode();
+    if (Ros_Controller_IsMotionReady() &&
+        (Ros_MotionControl_ActiveMotionMode == MOTION_MODE_INACTIVE || Ros_MotionControl_ActiveMotionMode == mode))
     {
         //set an indicator of which motion mode is now active
         Ros_MotionControl_ActiveMotionMode = mode;
@@ -1577,10 +2647,11 @@ updateStatus:
         if (Ros_MotionControl_IsMotionMode_PointQueue())
             Ros_MotionControl_MustInitializePointQueue = TRUE;
 
-        return TRUE;
+        bActivated = TRUE;
     }
-    else
-        return FALSE;
+    Ros_Communication_UnlockMotionMode();
+
+    return bActivated;
 }
 
 void Ros_MotionControl_StopTrajMode()
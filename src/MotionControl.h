@@ -9,10 +9,35 @@
 #define MOTOROS2_MOTION_CONTROL_H
 
 #define START_MAX_PULSE_DEVIATION           30
+#define START_MAX_CARTESIAN_POS_DEVIATION   (0.001)  // meters
+#define START_MAX_CARTESIAN_ROT_DEVIATION   (0.0035) // radians (~0.2 degrees)
+
+//Layout of a TCP pose in JointMotionData.pos for cartesian trajectories. Position in
+//meters, orientation as a quaternion, both relative to the robot base frame (RF).
+//JointMotionData.vel holds the linear (m/s) and angular (rad/s) velocity, also in RF.
+#define CARTESIAN_IDX_X                     0
+#define CARTESIAN_IDX_Y                     1
+#define CARTESIAN_IDX_Z                     2
+#define CARTESIAN_IDX_QX                    3
+#define CARTESIAN_IDX_QY                    4
+#define CARTESIAN_IDX_QZ                    5
+#define CARTESIAN_IDX_QW                    6
+#define CARTESIAN_IDX_RX                    3   // vel only
+#define CARTESIAN_IDX_RY                    4   // vel only
+#define CARTESIAN_IDX_RZ                    5   // vel only
 
 #define MOTION_START_TIMEOUT                5000  // in milliseconds
 #define MOTION_START_CHECK_PERIOD           50  // in millisecond
 #define MOTION_STOP_TIMEOUT                 20
+#define IN_MOTION_CLEAR_CYCLES              5   // interpolation cycles without motion before the robot is reported as stationary
+
+//Command position of all groups, as tracked by the IncMoveTask
+typedef struct
+{
+    INT64 timestamp;                                            // synchronized time of the interpolation cycle the command was read in (ns)
+    long pulsePos[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];     // command position (pulse)
+    long pulseSpeed[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];   // change of the command position (pulse/s)
+} MotionControl_CommandState;
 
 typedef enum
 {
@@ -22,13 +47,34 @@ typedef enum
 } MOTION_MODE;
 
 extern Init_Trajectory_Status Ros_MotionControl_InitTrajectory(control_msgs__action__FollowJointTrajectory_SendGoal_Request* pending_ros_goal_request);
+
+//Goals without joint trajectory points, but with multi_dof_trajectory points, are executed
+//as cartesian (TCP) trajectories
+extern BOOL Ros_MotionControl_IsCartesianGoal(control_msgs__action__FollowJointTrajectory_SendGoal_Request const* ros_goal_request);
+
+//Convert and validate the next trajectory while the current one is still executing.
+//Only one trajectory can be staged at a time. The start position is verified when
+//the staged trajectory is activated, after the current one has completed.
+extern Init_Trajectory_Status Ros_MotionControl_StageTrajectory(control_msgs__action__FollowJointTrajectory_SendGoal_Request* pending_ros_goal_request);
+extern Init_Trajectory_Status Ros_MotionControl_ActivateStagedTrajectory();
+extern BOOL Ros_MotionControl_HasStagedTrajectory();
+extern void Ros_MotionControl_DiscardStagedTrajectory();
 extern void Ros_MotionControl_IncMoveLoopStart();
 extern void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup);
 extern UINT8 Ros_MotionControl_ProcessQueuedTrajectoryPoint(motoros2_interfaces__srv__QueueTrajPoint_Request* request);
+//The next queued point must start at the current position again (fi: because the
+//robot was moved by something other than the queued points)
+extern void Ros_MotionControl_ResetPointQueue();
 extern BOOL Ros_MotionControl_AddPulseIncPointToQ(CtrlGroup* ctrlGroup, Incremental_data const* dataToEnQ);
 extern BOOL Ros_MotionControl_HasDataInQueue();
 extern BOOL Ros_MotionControl_HasDataToProcess();
 extern BOOL Ros_MotionControl_IsRosControllingMotion();
+//Whether the robot is moving. Maintained by the IncMoveTask, so this does not access the controller.
+//Returns ERROR if the state could not be determined (the feedback position could not be read).
+extern BOOL Ros_MotionControl_IsInMotion();
+//Copy the command position of all groups, as recorded by the IncMoveTask in the most recent
+//interpolation cycle. This does not access the controller. Returns FALSE if none is available yet.
+extern BOOL Ros_MotionControl_GetCommandState(MotionControl_CommandState* const state);
 extern int Ros_MotionControl_GetQueueCnt(int groupNo);
 extern BOOL Ros_MotionControl_StopMotion(BOOL bKeepJobRunning);
 extern BOOL Ros_MotionControl_ClearQ_All();
@@ -41,4 +87,10 @@ extern BOOL Ros_MotionControl_IsMotionMode_RawStreaming();
 
 extern void Ros_MotionControl_ValidateMotionModeIsOk();
 
+//Retrieve the outcome of the scheduled start of the most recent trajectory.
+//Returns FALSE if the trajectory was not scheduled, or hasn't started yet.
+//  actualStartTime_ns: synchronized time at which the first increment was sent
+//  startError_ns: difference between the actual and the requested start time
+extern BOOL Ros_MotionControl_GetScheduledStartResult(INT64* actualStartTime_ns, INT64* startError_ns);
+
 #endif  // MOTOROS2_MOTION_CONTROL_H
@@ -43,6 +43,9 @@
 #include <rmw_microros/init_options.h>
 #include <rmw_microros/timing.h>
 
+#include <rosidl_typesupport_microxrcedds_c/identifier.h>
+#include <rosidl_typesupport_microxrcedds_c/message_type_support.h>
+
 #include <libyaml_vendor/yaml.h>
 
 //============================================
@@ -50,9 +53,12 @@
 //============================================
 #include <std_srvs/srv/trigger.h>
 #include <sensor_msgs/msg/joint_state.h>
+#include <std_msgs/msg/int32_multi_array.h>
+#include <std_msgs/msg/string.h>
 #include <geometry_msgs/msg/pose.h>
 #include <geometry_msgs/msg/transform_stamped.h>
 #include <geometry_msgs/msg/quaternion.h>
+#include <geometry_msgs/msg/twist_stamped.h>
 #include <tf2_msgs/msg/tf_message.h>
 #include <industrial_msgs/msg/robot_status.h>
 #include <trajectory_msgs/msg/joint_trajectory.h>
@@ -76,8 +82,10 @@
 //============================================
 #include "MotoPlusExterns.h"
 #include "Debug.h"
+#include "Telemetry.h"
 #include "FileUtilityFunctions.h"
 #include "CommunicationExecutor.h"
+#include "ClockSync.h"
 #include "Quaternion_Conversion.h"
 #include "ErrorHandling.h"
 #include "MemoryAllocation.h"
@@ -86,6 +94,9 @@
 #include "ActionServer_FJT.h"
 #include "CtrlGroup.h"
 #include "ControllerStatusIO.h"
+#include "TaskTracing.h"
+#include "ControllerSnapshot.h"
+#include "IdlePublishing.h"
 #include "PositionMonitor.h"
 #include "ServiceQueueTrajPoint.h"
 #include "ServiceReadWriteIO.h"
@@ -94,6 +105,11 @@
 #include "ServiceStartPointQueueMode.h"
 #include "ServiceStopTrajMode.h"
 #include "ServiceSelectMotionTool.h"
+#include "TwistServo.h"
+#include "LogLevel.h"
+#include "JointStateCapture.h"
+#include "CompactJointState.h"
+#include "PublishScheduler.h"
 #include "MotionControl.h"
 #include "ConfigFile.h"
 #include "RosApiNameConstants.h"
@@ -10,10 +10,70 @@
 PositionMonitor_Publishers g_publishers_PositionMonitor;
 PositionMonitor_Messages g_messages_PositionMonitor;
 
+//Rotation between the Yaskawa flange ("tool0") and the ROS flange. These never change,
+//so they are calculated once during initialization.
+static MP_FRAME positionMonitor_frameTool0ToFlange;
+static MP_FRAME positionMonitor_frameFlangeToTool0;
+static MP_COORD positionMonitor_coordFlangeToTool0;
+
+//Transforms derived from the tool data of the tool selected for a group. Recalculated only
+//when the selected tool changes, or when the tool file is found to have been edited.
+typedef struct
+{
+    int tool;                           // tool the cached data was calculated for (-1: invalid)
+    UINT32 invalidateCount;             // value of positionMonitor_toolInvalidateCount when calculated
+    int cyclesSinceRefresh;             // number of cycles since the tool file was last read
+    MP_TOOL_RSP_DATA toolData;          // tool file data the cached transforms were calculated from
+    MP_FRAME frameTcpToTool0;
+    MP_COORD coordFlangeToTcp;
+} PositionMonitor_ToolCache;
+
+static PositionMonitor_ToolCache positionMonitor_toolCache[MAX_CONTROLLABLE_GROUPS];
+static volatile UINT32 positionMonitor_toolInvalidateCount[MAX_CONTROLLABLE_GROUPS];
+
+#ifdef MOTOROS2_TF_TIMING_ENABLE
+//Time spent calculating the transforms of all groups, for updates which used the cached
+//tool transforms [0] and updates which recalculated them [1]
+typedef struct
+{
+    BOOL bUncachedCycle;
+    INT64 cycle_ns;
+    INT64 total_ns[2];
+    UINT32 numCycles[2];
+} PositionMonitor_TfTiming;
+
+static PositionMonitor_TfTiming positionMonitor_tfTiming;
+#endif
+
+//world -> base only changes when the base track of a robot moves
+typedef struct
+{
+    BOOL bValid;
+    long trackPulsePos[MAX_PULSE_AXES];     // base track position the transform was calculated for
+} PositionMonitor_WorldToBaseCache;
+
+static PositionMonitor_WorldToBaseCache positionMonitor_worldToBaseCache[MAX_CONTROLLABLE_GROUPS];
+
+//TRUE if any of the transforms in the static TF message changed since it was last published
+static BOOL positionMonitor_bStaticTransformsChanged;
+
+//Position of all groups when a topic was last published (see Ros_IdlePublishing_ShouldPublish(..)).
+//Each topic has its own, as the topics can be published in different cycles (see PublishScheduler).
+typedef struct
+{
+    BOOL bValid;
+    long pulsePos[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+} PositionMonitor_PublishedPosition;
+
+//feedback position, except for joint_command_states (command position)
+static PositionMonitor_PublishedPosition positionMonitor_publishedPos[IDLE_PUBLISHING_NUM_TOPICS];
+
 
 static void Ros_PositionMonitor_Initialize_GlobalJointStatePublisher(rmw_qos_profile_t const* const qos_profile);
 static void Ros_PositionMonitor_Initialize_PerGroupJointStatePublisher(rmw_qos_profile_t const* const qos_profile, CtrlGroup* const ctrlGroup, int grpIndex);
+static void Ros_PositionMonitor_Initialize_JointCommandStatePublisher(rmw_qos_profile_t const* const qos_profile);
 static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const* const qos_profile, int totalRobots);
+static void Ros_PositionMonitor_Initialize_ConstantFrames();
 
 
 void Ros_PositionMonitor_Initialize()
@@ -22,6 +82,8 @@ void Ros_PositionMonitor_Initialize()
 
     Ros_Debug_BroadcastMsg("Initializing PositionMonitor publishers");
 
+    Ros_PositionMonitor_Initialize_ConstantFrames();
+
     //==================================
     //create the global (ie: aggregrate) JointState publisher
     const rmw_qos_profile_t* qos_profile_js = Ros_ConfigFile_To_Rmw_Qos_Profile(g_nodeConfigSettings.qos_joint_states);
@@ -38,6 +100,11 @@ void Ros_PositionMonitor_Initialize()
             totalRobots += 1;
     }
 
+    //==================================
+    //create the JointState publisher for the command position of all groups
+    if (g_nodeConfigSettings.publish_joint_command_states)
+        Ros_PositionMonitor_Initialize_JointCommandStatePublisher(qos_profile_js);
+
     //==================================
     //Create publisher for cartesian transform
     //Rviz2 expects the QoS to be RELIABLE, but user could have configured something else
@@ -153,23 +220,73 @@ static void Ros_PositionMonitor_Initialize_PerGroupJointStatePublisher(rmw_qos_p
     rosidl_runtime_c__float64__Sequence__init(&ctrlGroup->msgJointState->effort, ctrlGroup->numAxes);
 }
 
+static void Ros_PositionMonitor_Initialize_JointCommandStatePublisher(rmw_qos_profile_t const* const qos_profile)
+{
+    rcl_ret_t ret = rclc_publisher_init(
+        &g_publishers_PositionMonitor.jointCommandStates,
+        &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, JointState),
+        TOPIC_NAME_JOINT_COMMAND_STATES,
+        qos_profile);
+    motoRosAssert(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_JOINT_COMMAND_STATES);
+
+    //same joints (in the same order) as the aggregate joint_states message
+    g_messages_PositionMonitor.jointCommandStates = sensor_msgs__msg__JointState__create();
+    rosidl_runtime_c__String__Sequence__init(&g_messages_PositionMonitor.jointCommandStates->name, g_Ros_Controller.totalAxesCount);
+    for (int i = 0; i < g_Ros_Controller.totalAxesCount; i += 1)
+    {
+        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.jointCommandStates->name.data[i],
+            g_messages_PositionMonitor.jointStateAllGroups->name.data[i].data);
+    }
+
+    //position and velocity only: there is no commanded effort
+    rosidl_runtime_c__float64__Sequence__init(&g_messages_PositionMonitor.jointCommandStates->position, g_Ros_Controller.totalAxesCount);
+    rosidl_runtime_c__float64__Sequence__init(&g_messages_PositionMonitor.jointCommandStates->velocity, g_Ros_Controller.totalAxesCount);
+
+    positionMonitor_publishedPos[IDLE_PUBLISHING_TOPIC_JOINT_COMMAND_STATES].bValid = FALSE;
+}
+
+static void Ros_PositionMonitor_Initialize_ConstantFrames()
+{
+    MP_XYZ vectorOrg, vectorX, vectorY; //for mpMakeFrame
+
+    //Make rotational frames
+    vectorOrg.x = 0;    vectorOrg.y = 0;    vectorOrg.z = 0;
+    vectorX.x = 0;      vectorX.y = 0;      vectorX.z = 1;
+    vectorY.x = 0;      vectorY.y = -1;     vectorY.z = 0;
+    mpMakeFrame(&vectorOrg, &vectorX, &vectorY, &positionMonitor_frameTool0ToFlange);
+    mpInvFrame(&positionMonitor_frameTool0ToFlange, &positionMonitor_frameFlangeToTool0);
+    mpFrameToZYXeuler(&positionMonitor_frameFlangeToTool0, &positionMonitor_coordFlangeToTool0);
+
+    for (int groupIndex = 0; groupIndex < MAX_CONTROLLABLE_GROUPS; groupIndex += 1)
+    {
+        positionMonitor_toolCache[groupIndex].tool = -1;
+        positionMonitor_toolInvalidateCount[groupIndex] = 0;
+        positionMonitor_worldToBaseCache[groupIndex].bValid = FALSE;
+    }
+}
+
 static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const* const qos_profile, int totalRobots)
 {
     char formatBuffer[MAX_TF_FRAME_NAME_LENGTH];
+    char formatBufferStatic[MAX_TF_FRAME_NAME_LENGTH];
 
-    // default TF topic name
+    // default TF topic names
     bzero(formatBuffer, MAX_TF_FRAME_NAME_LENGTH);
     snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%s", TOPIC_NAME_TF);
+    bzero(formatBufferStatic, MAX_TF_FRAME_NAME_LENGTH);
+    snprintf(formatBufferStatic, MAX_TF_FRAME_NAME_LENGTH, "%s", TOPIC_NAME_TF_STATIC);
 
-    //check whether we should make the topic name absolute (so it can't/won't
+    //check whether we should make the topic names absolute (so they can't/won't
     //be namespaced any further)
     if (g_nodeConfigSettings.namespace_tf == FALSE)
     {
         Ros_Debug_BroadcastMsg("PositionMonitor: TF topic absolute");
         snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "/%s", TOPIC_NAME_TF);
+        snprintf(formatBufferStatic, MAX_TF_FRAME_NAME_LENGTH, "/%s", TOPIC_NAME_TF_STATIC);
     }
 
-    Ros_Debug_BroadcastMsg("PositionMonitor: publishing TF to '%s'", formatBuffer);
+    Ros_Debug_BroadcastMsg("PositionMonitor: publishing TF to '%s' and '%s'", formatBuffer, formatBufferStatic);
 
     //-------------
     //create TF publisher (non-static)
@@ -181,38 +298,68 @@ static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const*
         qos_profile);
     motoRosAssert(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_TRANSFORM);
 
+    //-------------
+    //create TF publisher (static)
+    //This always uses the QoS expected by tf2 for static transforms (reliable, transient local),
+    //so late-joining listeners receive the last published message.
+    rmw_qos_profile_t qos_profile_static = rmw_qos_profile_default;
+    qos_profile_static.depth = 1;
+    qos_profile_static.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos_profile_static.durability = RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+
+    ret = rclc_publisher_init(
+        &g_publishers_PositionMonitor.transformStatic,
+        &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(tf2_msgs, msg, TFMessage),
+        formatBufferStatic,
+        &qos_profile_static);
+    motoRosAssert(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_PUBLISHER_TRANSFORM_STATIC);
+
     //--------------
-    //create message for cartesian transform
+    //create messages for cartesian transforms
     g_messages_PositionMonitor.transform = tf2_msgs__msg__TFMessage__create();
 
-    motoRosAssert(geometry_msgs__msg__TransformStamped__Sequence__init(&g_messages_PositionMonitor.transform->transforms, totalRobots * NUMBER_TRANSFORM_LINKS_PER_ROBOT),
+    motoRosAssert(geometry_msgs__msg__TransformStamped__Sequence__init(&g_messages_PositionMonitor.transform->transforms, totalRobots * NUMBER_DYNAMIC_TRANSFORM_LINKS_PER_ROBOT),
                   SUBCODE_FAIL_ALLOCATE_TRANSFORM);
 
+    g_messages_PositionMonitor.transformStatic = tf2_msgs__msg__TFMessage__create();
+
+    motoRosAssert(geometry_msgs__msg__TransformStamped__Sequence__init(&g_messages_PositionMonitor.transformStatic->transforms, totalRobots * NUMBER_STATIC_TRANSFORM_LINKS_PER_ROBOT),
+                  SUBCODE_FAIL_ALLOCATE_TRANSFORM_STATIC);
+
     bzero(formatBuffer, MAX_TF_FRAME_NAME_LENGTH);
-    int robotIterator = 0;
     const char* frame_prefix = g_nodeConfigSettings.tf_frame_prefix;
-    for (int i = 0; i < (totalRobots * NUMBER_TRANSFORM_LINKS_PER_ROBOT); i += NUMBER_TRANSFORM_LINKS_PER_ROBOT)
+    for (int robotIterator = 0; robotIterator < totalRobots; robotIterator += 1)
     {
+        geometry_msgs__msg__TransformStamped* dynamicLinks = &g_messages_PositionMonitor.transform->transforms.data[robotIterator * NUMBER_DYNAMIC_TRANSFORM_LINKS_PER_ROBOT];
+        geometry_msgs__msg__TransformStamped* staticLinks = &g_messages_PositionMonitor.transformStatic->transforms.data[robotIterator * NUMBER_STATIC_TRANSFORM_LINKS_PER_ROBOT];
+
         snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sworld", frame_prefix);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_WorldToBase].header.frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&staticLinks[tfLink_WorldToBase].header.frame_id, formatBuffer);
 
         snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/base", frame_prefix, robotIterator + 1);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_WorldToBase].child_frame_id, formatBuffer);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_BaseToFlange].header.frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&staticLinks[tfLink_WorldToBase].child_frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&dynamicLinks[tfLink_BaseToFlange].header.frame_id, formatBuffer);
 
         snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/flange", frame_prefix, robotIterator + 1);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_BaseToFlange].child_frame_id, formatBuffer);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_FlangeToTool0].header.frame_id, formatBuffer);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_FlangeToTcp].header.frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&dynamicLinks[tfLink_BaseToFlange].child_frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&staticLinks[tfLink_FlangeToTool0].header.frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&staticLinks[tfLink_FlangeToTcp].header.frame_id, formatBuffer);
 
         snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tool0", frame_prefix, robotIterator + 1);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_FlangeToTool0].child_frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&staticLinks[tfLink_FlangeToTool0].child_frame_id, formatBuffer);
 
         snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tcp_%d", frame_prefix, robotIterator + 1, g_Ros_Controller.ctrlGroups[robotIterator]->tool);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_FlangeToTcp].child_frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&staticLinks[tfLink_FlangeToTcp].child_frame_id, formatBuffer);
 
-        robotIterator += 1;
+        //flange -> tool0 is constant, so it does not need to be updated in Ros_PositionMonitor_CalculateTransforms(..)
+        Ros_MpCoord_To_GeomMsgsTransform(&positionMonitor_coordFlangeToTool0, &staticLinks[tfLink_FlangeToTool0].transform);
     }
+
+    positionMonitor_bStaticTransformsChanged = TRUE;
+    positionMonitor_publishedPos[IDLE_PUBLISHING_TOPIC_JOINT_STATES].bValid = FALSE;
+    positionMonitor_publishedPos[IDLE_PUBLISHING_TOPIC_TF].bValid = FALSE;
+    positionMonitor_publishedPos[IDLE_PUBLISHING_TOPIC_ROBOT_STATUS].bValid = FALSE;
 }
 
 void Ros_PositionMonitor_Cleanup()
@@ -241,47 +388,147 @@ void Ros_PositionMonitor_Cleanup()
         Ros_Debug_BroadcastMsg("Failed cleaning up global jointstate publisher: %d", ret);
     sensor_msgs__msg__JointState__destroy(g_messages_PositionMonitor.jointStateAllGroups);
 
+    if (g_nodeConfigSettings.publish_joint_command_states)
+    {
+        Ros_Debug_BroadcastMsg("Cleanup publisher joint command state");
+        ret = rcl_publisher_fini(&g_publishers_PositionMonitor.jointCommandStates, &g_microRosNodeInfo.node);
+        if (ret != RCL_RET_OK)
+            Ros_Debug_BroadcastMsg("Failed cleaning up joint command state publisher: %d", ret);
+        sensor_msgs__msg__JointState__destroy(g_messages_PositionMonitor.jointCommandStates);
+    }
+
     Ros_Debug_BroadcastMsg("Cleanup TF publisher");
     ret = rcl_publisher_fini(&g_publishers_PositionMonitor.transform, &g_microRosNodeInfo.node);
     if (ret != RCL_RET_OK)
         Ros_Debug_BroadcastMsg("Failed cleaning up TF publisher: %d", ret);
     tf2_msgs__msg__TFMessage__destroy(g_messages_PositionMonitor.transform);
 
+    Ros_Debug_BroadcastMsg("Cleanup static TF publisher");
+    ret = rcl_publisher_fini(&g_publishers_PositionMonitor.transformStatic, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up static TF publisher: %d", ret);
+    tf2_msgs__msg__TFMessage__destroy(g_messages_PositionMonitor.transformStatic);
+
     MOTOROS2_MEM_TRACE_REPORT(pos_mon_fini);
 }
 
-void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto, long* pulsePos_moto_track, INT64 timestamp)
+void Ros_PositionMonitor_InvalidateToolCache(int groupIndex)
 {
-    double track_pos_meters[MAX_PULSE_AXES];
-    BITSTRING figure;
-    MP_COORD cartesian_moto;
-    char alarm_msg_buf[ERROR_MSG_MAX_SIZE] = { 0 };
+    if (groupIndex >= 0 && groupIndex < MAX_CONTROLLABLE_GROUPS)
+        positionMonitor_toolInvalidateCount[groupIndex] += 1;
+}
 
+//Make sure the cached tool transforms of a group correspond to its selected tool
+static void Ros_PositionMonitor_UpdateToolCache(int groupIndex)
+{
     CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+    PositionMonitor_ToolCache* cache = &positionMonitor_toolCache[groupIndex];
+    UINT32 invalidateCount = positionMonitor_toolInvalidateCount[groupIndex];
+    MP_TOOL_RSP_DATA retToolData;
+    MP_COORD coordToolData;
+    MP_FRAME frameTool0ToTcp, frameFlangeToTcp;
 
-    //some things (like external axes) cannot be converted to cartesian
-    if (!Ros_CtrlGroup_IsRobot(group))
+    BOOL bMustRecalculate = (cache->tool != group->tool) || (cache->invalidateCount != invalidateCount);
+
+    //The tool file can be edited on the teach pendant without notifying MotoROS2, so it
+    //is read periodically. The transforms are only recalculated if its contents changed.
+    cache->cyclesSinceRefresh += 1;
+    if (!bMustRecalculate && cache->cyclesSinceRefresh < TOOL_DATA_REFRESH_CYCLES)
         return;
+    cache->cyclesSinceRefresh = 0;
 
-    //this CtrlGroup's pose can be converted, so update ROS transforms
+    //Get TCP definition
+    bzero(&retToolData, sizeof(retToolData));
+    mpGetToolData(group->tool, &retToolData);
+
+    if (!bMustRecalculate && memcmp(&retToolData, &cache->toolData, sizeof(MP_TOOL_RSP_DATA)) == 0)
+        return;
+
+    coordToolData.x = retToolData.x; coordToolData.y = retToolData.y; coordToolData.z = retToolData.z;
+    coordToolData.rx = retToolData.rx; coordToolData.ry = retToolData.ry; coordToolData.rz = retToolData.rz;
 
-    //first update stamp of this group's transforms
-    for (int i = 0; i < NUMBER_TRANSFORM_LINKS_PER_ROBOT; i += 1)
+    mpZYXeulerToFrame(&coordToolData, &frameTool0ToTcp);
+    mpInvFrame(&frameTool0ToTcp, &cache->frameTcpToTool0);
+
+    mpMulFrame(&positionMonitor_frameFlangeToTool0, &frameTool0ToTcp, &frameFlangeToTcp);
+    mpFrameToZYXeuler(&frameFlangeToTcp, &cache->coordFlangeToTcp);
+
+    memcpy(&cache->toolData, &retToolData, sizeof(MP_TOOL_RSP_DATA));
+    cache->tool = group->tool;
+    cache->invalidateCount = invalidateCount;
+
+    //only converted when it changes, as it is not pose dependent
+    Ros_MpCoord_To_GeomMsgsTransform(&cache->coordFlangeToTcp,
+        &g_messages_PositionMonitor.transformStatic->transforms.data[(groupIndex * NUMBER_STATIC_TRANSFORM_LINKS_PER_ROBOT) + tfLink_FlangeToTcp].transform);
+    positionMonitor_bStaticTransformsChanged = TRUE;
+}
+
+#ifdef MOTOROS2_TF_TIMING_ENABLE
+static void Ros_PositionMonitor_TfTimingStartCycle()
+{
+    positionMonitor_tfTiming.bUncachedCycle = !positionMonitor_tfTiming.bUncachedCycle;
+    positionMonitor_tfTiming.cycle_ns = 0;
+
+    if (positionMonitor_tfTiming.bUncachedCycle)
     {
-        Ros_Nanos_To_Time_Msg(timestamp, &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + i].header.stamp);
+        for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+            Ros_PositionMonitor_InvalidateToolCache(groupIndex);
     }
+}
 
-    //=======================
-    // Calculate World
-    //=======================
-    //---------------------------------------------------------
-    //NOTE: the term 'base' is a ROS term. This is actually RF.
-    //---------------------------------------------------------
+static void Ros_PositionMonitor_TfTimingEndCycle()
+{
+    PositionMonitor_TfTiming* timing = &positionMonitor_tfTiming;
+    int kind = timing->bUncachedCycle ? 1 : 0;
+
+    timing->total_ns[kind] += timing->cycle_ns;
+    timing->numCycles[kind] += 1;
+
+    if ((timing->numCycles[0] + timing->numCycles[1]) < TF_TIMING_REPORT_CYCLES)
+        return;
+
+    //Ros_ClockSync_Now() is interpolated within a tick, so the average is meaningful even
+    //though a single update takes much less than a tick
+    Ros_Debug_BroadcastMsg("TF timing (%d groups): cached %lld us, uncached %lld us (average per update, %d + %d updates)",
+        g_Ros_Controller.numGroup,
+        (timing->total_ns[0] / (timing->numCycles[0] > 0 ? timing->numCycles[0] : 1)) / 1000,
+        (timing->total_ns[1] / (timing->numCycles[1] > 0 ? timing->numCycles[1] : 1)) / 1000,
+        (int)timing->numCycles[0], (int)timing->numCycles[1]);
+
+    bzero(timing, sizeof(PositionMonitor_TfTiming));
+}
+#endif
+
+//Update world -> base in the static TF message. This only changes if the robot is
+//mounted on a base track, and then only if the track moved since the last update.
+static void Ros_PositionMonitor_UpdateWorldToBase(int groupIndex, long const* pulsePos_moto_track)
+{
+    double track_pos_meters[MAX_PULSE_AXES];
+    char alarm_msg_buf[ERROR_MSG_MAX_SIZE] = { 0 };
     MP_COORD coordWorldToBase;
 
+    CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+    PositionMonitor_WorldToBaseCache* cache = &positionMonitor_worldToBaseCache[groupIndex];
+    BOOL bHasBaseTrack = Ros_CtrlGroup_HasBaseTrack(group);
+
+    if (cache->bValid)
+    {
+        BOOL bTrackMoved = FALSE;
+
+        //ignore servo jitter, so the static transforms are not republished while the track is stationary
+        for (int i = 0; bHasBaseTrack && i < MAX_PULSE_AXES; i += 1)
+        {
+            if (abs(pulsePos_moto_track[i] - cache->trackPulsePos[i]) > BASE_TRACK_MOVED_THRESHOLD_PULSES)
+                bTrackMoved = TRUE;
+        }
+
+        if (!bTrackMoved)
+            return;
+    }
+
     memcpy(&coordWorldToBase, &group->robotCalibrationToBaseFrame, sizeof(MP_COORD));
 
-    if (Ros_CtrlGroup_HasBaseTrack(group)) //add in the offset of the base track motion and mounting offset
+    if (bHasBaseTrack) //add in the offset of the base track motion and mounting offset
     {
         MP_COORD coordTrackTravel;
         MP_FRAME frameTrackTravel, frameTrackToRobot, frameWorldToTrack;
@@ -325,9 +572,42 @@ void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto
         mpFrameToZYXeuler(&frameWorldToRobot, &coordWorldToBase);
     }
 
-    geometry_msgs__msg__Transform* transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + tfLink_WorldToBase].transform;
+    geometry_msgs__msg__Transform* transform = &g_messages_PositionMonitor.transformStatic->transforms.data[(groupIndex * NUMBER_STATIC_TRANSFORM_LINKS_PER_ROBOT) + tfLink_WorldToBase].transform;
     Ros_MpCoord_To_GeomMsgsTransform(&coordWorldToBase, transform);
 
+    if (bHasBaseTrack)
+        memcpy(cache->trackPulsePos, pulsePos_moto_track, sizeof(cache->trackPulsePos));
+    cache->bValid = TRUE;
+    positionMonitor_bStaticTransformsChanged = TRUE;
+}
+
+void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long const* pulsePos_moto, long const* pulsePos_moto_track, INT64 timestamp)
+{
+    BITSTRING figure;
+    MP_COORD cartesian_moto;
+
+    CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+
+    //some things (like external axes) cannot be converted to cartesian
+    if (!Ros_CtrlGroup_IsRobot(group))
+        return;
+
+    //this CtrlGroup's pose can be converted, so update ROS transforms
+
+    //first update stamp of this group's (dynamic) transforms
+    for (int i = 0; i < NUMBER_DYNAMIC_TRANSFORM_LINKS_PER_ROBOT; i += 1)
+    {
+        Ros_Nanos_To_Time_Msg(timestamp, &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_DYNAMIC_TRANSFORM_LINKS_PER_ROBOT) + i].header.stamp);
+    }
+
+    //=======================
+    // Calculate World
+    //=======================
+    //---------------------------------------------------------
+    //NOTE: the term 'base' is a ROS term. This is actually RF.
+    //---------------------------------------------------------
+    Ros_PositionMonitor_UpdateWorldToBase(groupIndex, pulsePos_moto_track);
+
     //============================
     // Calculate Flange and Tool0
     //============================
@@ -342,91 +622,107 @@ void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto
     //---------------------------------------------------------
     // <image url="$(ProjectDir)image_comments\tf_diagram.png" />
     //
-    MP_FRAME frameBaseToTcp, frameBaseToTool0, frameBaseToFlange, frameTool0ToTcp, frameTcpToTool0;
-    MP_FRAME frameTool0ToFlange, frameFlangeToTool0, frameFlangeToTcp;
-    MP_TOOL_RSP_DATA retToolData;
-    MP_COORD coordToolData, coordBaseToFlange, coordFlangeToTool0;
-    MP_XYZ vectorOrg, vectorX, vectorY; //for mpMakeFrame
+    // Only the pose dependent part is calculated here. The flange -> tool0 rotation is
+    // constant and the tool transforms are cached (see Ros_PositionMonitor_UpdateToolCache).
+    //
+    MP_FRAME frameBaseToTcp, frameBaseToTool0, frameBaseToFlange;
+    MP_COORD coordBaseToFlange;
+
+    Ros_PositionMonitor_UpdateToolCache(groupIndex);
 
     long anglePos_moto[MAX_PULSE_AXES];
-    mpConvPulseToAngle(groupIndex, pulsePos_moto, anglePos_moto);
+    mpConvPulseToAngle(groupIndex, (long*)pulsePos_moto, anglePos_moto);
     mpConvAxesToCartPos(groupIndex, anglePos_moto, group->tool, &figure, &cartesian_moto);
 
     //Get current position of TCP
     mpZYXeulerToFrame(&cartesian_moto, &frameBaseToTcp);
 
-    //Get TCP definition
-    mpGetToolData(group->tool, &retToolData);
-    coordToolData.x = retToolData.x; coordToolData.y = retToolData.y; coordToolData.z = retToolData.z;
-    coordToolData.rx = retToolData.rx; coordToolData.ry = retToolData.ry; coordToolData.rz = retToolData.rz;
+    mpMulFrame(&frameBaseToTcp, &positionMonitor_toolCache[groupIndex].frameTcpToTool0, &frameBaseToTool0);
 
-    mpZYXeulerToFrame(&coordToolData, &frameTool0ToTcp);
-    mpInvFrame(&frameTool0ToTcp, &frameTcpToTool0);
+    mpMulFrame(&frameBaseToTool0, &positionMonitor_frameTool0ToFlange, &frameBaseToFlange);
+    mpFrameToZYXeuler(&frameBaseToFlange, &coordBaseToFlange);
 
+    //=======================
 
-    mpMulFrame(&frameBaseToTcp, &frameTcpToTool0, &frameBaseToTool0);
+    geometry_msgs__msg__Transform* transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_DYNAMIC_TRANSFORM_LINKS_PER_ROBOT) + tfLink_BaseToFlange].transform;
+    Ros_MpCoord_To_GeomMsgsTransform(&coordBaseToFlange, transform);
+}
 
-    //Make rotational frames
-    vectorOrg.x = 0;    vectorOrg.y = 0;    vectorOrg.z = 0;
-    vectorX.x = 0;      vectorX.y = 0;      vectorX.z = 1;
-    vectorY.x = 0;      vectorY.y = -1;     vectorY.z = 0;
-    mpMakeFrame(&vectorOrg, &vectorX, &vectorY, &frameTool0ToFlange);
-    mpInvFrame(&frameTool0ToFlange, &frameFlangeToTool0);
-    mpFrameToZYXeuler(&frameFlangeToTool0, &coordFlangeToTool0);
+//Whether the position of any axis changed by more than 'idle_change_threshold' since
+//it was last published on 'topic'
+static BOOL Ros_PositionMonitor_HasPositionChanged(IdlePublishing_Topic topic, long const pulsePos_moto[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES])
+{
+    PositionMonitor_PublishedPosition const* published = &positionMonitor_publishedPos[topic];
 
-    mpMulFrame(&frameBaseToTool0, &frameTool0ToFlange, &frameBaseToFlange);
-    mpFrameToZYXeuler(&frameBaseToFlange, &coordBaseToFlange);
+    if (!published->bValid)
+        return TRUE;
 
-    mpMulFrame(&frameFlangeToTool0, &frameTool0ToTcp, &frameFlangeToTcp);
-    mpFrameToZYXeuler(&frameFlangeToTcp, &coordToolData);
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
 
-    //=======================
+        for (int axis = 0; axis < MAX_PULSE_AXES; axis += 1)
+        {
+            if (Ros_CtrlGroup_IsInvalidAxis(group, axis))
+                continue;
 
-    transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + tfLink_BaseToFlange].transform;
-    Ros_MpCoord_To_GeomMsgsTransform(&coordBaseToFlange, transform);
+            if (abs(pulsePos_moto[groupIndex][axis] - published->pulsePos[groupIndex][axis]) > g_nodeConfigSettings.idle_change_threshold)
+                return TRUE;
+        }
+    }
 
-    transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + tfLink_FlangeToTool0].transform;
-    Ros_MpCoord_To_GeomMsgsTransform(&coordFlangeToTool0, transform);
+    return FALSE;
+}
+
+static void Ros_PositionMonitor_SetPublished(IdlePublishing_Topic topic, long const pulsePos_moto[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES])
+{
+    memcpy(positionMonitor_publishedPos[topic].pulsePos, pulsePos_moto, sizeof(positionMonitor_publishedPos[topic].pulsePos));
+    positionMonitor_publishedPos[topic].bValid = TRUE;
+}
+
+BOOL Ros_PositionMonitor_HasPositionChangedSincePublished(IdlePublishing_Topic topic, ControllerSnapshot const* snapshot)
+{
+    return Ros_PositionMonitor_HasPositionChanged(topic, snapshot->fbPulsePos);
+}
 
-    transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + tfLink_FlangeToTcp].transform;
-    Ros_MpCoord_To_GeomMsgsTransform(&coordToolData, transform);
+void Ros_PositionMonitor_SetPublishedPosition(IdlePublishing_Topic topic, ControllerSnapshot const* snapshot)
+{
+    Ros_PositionMonitor_SetPublished(topic, snapshot->fbPulsePos);
 }
 
-void Ros_PositionMonitor_UpdateLocation()
+void Ros_PositionMonitor_UpdateLocation(ControllerSnapshot const* snapshot, BOOL bJointStatesDue, BOOL bGroupJointStatesDue, BOOL bTfDue)
 {
-    long pulsePos_moto[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
-    long pulsePos_moto_track[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
-    long pulseSpeed_moto[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
-    double torque[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
     rcl_ret_t ret;
 
-    //Timestamp
-    INT64 theTime = rmw_uros_epoch_nanos();
+    //Timestamp: all feedback data of the snapshot was read at the same time
+    INT64 theTime = snapshot->timestamp;
 
     Ros_Nanos_To_Time_Msg(theTime, &g_messages_PositionMonitor.jointStateAllGroups->header.stamp);
 
-    //Read feedback data for all groups prior to the conversion/formatting routines. This
-    //ensures the timestamp is more accurate for all groups.
-    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
-    {
-        CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+    //While the robot is stationary, only publish if the position changed or the
+    //keep-alive period expired. Skip the conversions as well if nothing will be published.
+    BOOL bJointStatesChanged = Ros_PositionMonitor_HasPositionChanged(IDLE_PUBLISHING_TOPIC_JOINT_STATES, snapshot->fbPulsePos);
+    BOOL bTfChanged = Ros_PositionMonitor_HasPositionChanged(IDLE_PUBLISHING_TOPIC_TF, snapshot->fbPulsePos);
+    BOOL bMoving = bJointStatesChanged || bTfChanged || (g_messages_RobotStatus.msgRobotStatus->in_motion.val == industrial_msgs__msg__TriState__TRUE);
+    Ros_IdlePublishing_SetMoving(bMoving);
 
-        //----------------------------
-        BOOL bRet = Ros_CtrlGroup_GetFBPulsePos(group, pulsePos_moto[groupIndex]);
-        if (bRet != TRUE)
-            continue;
-        //if this is attached to a base track, get it's position too
-        if (Ros_CtrlGroup_HasBaseTrack(group))
-            Ros_CtrlGroup_GetFBPulsePos(g_Ros_Controller.ctrlGroups[group->baseTrackGroupIndex], pulsePos_moto_track[groupIndex]);
+    BOOL bPublishJointStates = FALSE;
+    BOOL bPublishGroupJointStates = FALSE;
+    if (bJointStatesDue || bGroupJointStatesDue)
+    {
+        BOOL bShouldPublish = Ros_IdlePublishing_ShouldPublish(IDLE_PUBLISHING_TOPIC_JOINT_STATES, bJointStatesChanged);
+        bPublishJointStates = bJointStatesDue && bShouldPublish;
+        bPublishGroupJointStates = bGroupJointStatesDue && bShouldPublish;
+    }
+    BOOL bPublishTf = bTfDue && g_nodeConfigSettings.publish_tf && Ros_IdlePublishing_ShouldPublish(IDLE_PUBLISHING_TOPIC_TF, bTfChanged);
 
-        //----------------------------
-        bRet = Ros_CtrlGroup_GetFBServoSpeed(group, pulseSpeed_moto[groupIndex]);
-        if (bRet != TRUE)
-            continue;
+    if (!bPublishJointStates && !bPublishGroupJointStates && !bPublishTf)
+        return;
 
-        //----------------------------
-        Ros_CtrlGroup_GetTorque(group, torque[groupIndex]);
-    }
+#ifdef MOTOROS2_TF_TIMING_ENABLE
+    if (bPublishTf)
+        Ros_PositionMonitor_TfTimingStartCycle();
+#endif
 
     //for each group
     int iteratorAllAxes = 0;
@@ -445,23 +741,33 @@ void Ros_PositionMonitor_UpdateLocation()
         //----------------------------
         //POSITION
         // joints
-        Ros_CtrlGroup_ConvertToRosPos(group, pulsePos_moto[groupIndex], radPos_ros);
+        Ros_CtrlGroup_ConvertToRosPos(group, snapshot->fbPulsePos[groupIndex], radPos_ros);
         memcpy(group->msgJointState->position.data, radPos_ros, sizeof(double) * group->numAxes);
         memcpy(&g_messages_PositionMonitor.jointStateAllGroups->position.data[iteratorAllAxes], radPos_ros, sizeof(double) * group->numAxes);
 
         // cartesian
-        if (g_nodeConfigSettings.publish_tf)
-            Ros_PositionMonitor_CalculateTransforms(groupIndex, pulsePos_moto[groupIndex], pulsePos_moto_track[groupIndex], theTime);
+        //(the position of a base track is part of the snapshot as well, as it is a group itself)
+        if (bPublishTf)
+        {
+            long const* pulsePos_moto_track = Ros_CtrlGroup_HasBaseTrack(group) ? snapshot->fbPulsePos[group->baseTrackGroupIndex] : NULL;
+#ifdef MOTOROS2_TF_TIMING_ENABLE
+            INT64 tfStart_ns = Ros_ClockSync_Now();
+#endif
+            Ros_PositionMonitor_CalculateTransforms(groupIndex, snapshot->fbPulsePos[groupIndex], pulsePos_moto_track, theTime);
+#ifdef MOTOROS2_TF_TIMING_ENABLE
+            positionMonitor_tfTiming.cycle_ns += Ros_ClockSync_Now() - tfStart_ns;
+#endif
+        }
 
         //----------------------------
         //VELOCITY
-        Ros_CtrlGroup_ConvertToRosPos(group, pulseSpeed_moto[groupIndex], radSpeed_ros);
+        Ros_CtrlGroup_ConvertToRosPos(group, snapshot->fbPulseSpeed[groupIndex], radSpeed_ros);
         memcpy(group->msgJointState->velocity.data, radSpeed_ros, sizeof(double) * group->numAxes);
         memcpy(&g_messages_PositionMonitor.jointStateAllGroups->velocity.data[iteratorAllAxes], radSpeed_ros, sizeof(double) * group->numAxes);
 
         //----------------------------
         //TORQUE
-        Ros_CtrlGroup_ConvertToRosTorque(group, torque[groupIndex], torque_ros);
+        Ros_CtrlGroup_ConvertToRosTorque(group, snapshot->torque[groupIndex], torque_ros);
         memcpy(group->msgJointState->effort.data, torque_ros, sizeof(double) * group->numAxes);
         memcpy(&g_messages_PositionMonitor.jointStateAllGroups->effort.data[iteratorAllAxes], torque_ros, sizeof(double) * group->numAxes);
 
@@ -478,24 +784,103 @@ void Ros_PositionMonitor_UpdateLocation()
     g_messages_PositionMonitor.jointStateAllGroups->position.size =
         g_messages_PositionMonitor.jointStateAllGroups->velocity.size =
         g_messages_PositionMonitor.jointStateAllGroups->effort.size = g_Ros_Controller.totalAxesCount;
+
+#ifdef MOTOROS2_TF_TIMING_ENABLE
+    if (bPublishTf)
+        Ros_PositionMonitor_TfTimingEndCycle();
+#endif
     
 
 
     //**********************************
     //Publish feedback topics
-    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    const rosidl_message_type_support_t* typeSupportJointState = ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, JointState);
+
+    if (bPublishGroupJointStates)
     {
-        ret = rcl_publish(&g_Ros_Controller.ctrlGroups[groupIndex]->publisherJointState, g_Ros_Controller.ctrlGroups[groupIndex]->msgJointState, NULL);
-        // publishing can fail, but we choose to ignore those errors in this implementation
-        RCL_UNUSED(ret);
+        for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+        {
+            ret = rcl_publish(&g_Ros_Controller.ctrlGroups[groupIndex]->publisherJointState, g_Ros_Controller.ctrlGroups[groupIndex]->msgJointState, NULL);
+            // publishing can fail, but we choose to ignore those errors in this implementation
+            RCL_UNUSED(ret);
+            Ros_IdlePublishing_CountPublished(IDLE_PUBLISHING_TOPIC_JOINT_STATES, typeSupportJointState, g_Ros_Controller.ctrlGroups[groupIndex]->msgJointState);
+        }
     }
 
-    ret = rcl_publish(&g_publishers_PositionMonitor.jointStateAllGroups, g_messages_PositionMonitor.jointStateAllGroups, NULL);
-    RCL_UNUSED(ret);
+    if (bPublishJointStates)
+    {
+        //the compact format replaces the JointState message (see CompactJointState.h)
+        if (g_nodeConfigSettings.publish_compact_joint_states)
+            Ros_CompactJointState_Publish(g_messages_PositionMonitor.jointStateAllGroups);
+        else
+        {
+            ret = rcl_publish(&g_publishers_PositionMonitor.jointStateAllGroups, g_messages_PositionMonitor.jointStateAllGroups, NULL);
+            RCL_UNUSED(ret);
+            Ros_IdlePublishing_CountPublished(IDLE_PUBLISHING_TOPIC_JOINT_STATES, typeSupportJointState, g_messages_PositionMonitor.jointStateAllGroups);
+        }
+
+        Ros_PositionMonitor_SetPublished(IDLE_PUBLISHING_TOPIC_JOINT_STATES, snapshot->fbPulsePos);
+    }
 
-    if (g_nodeConfigSettings.publish_tf)
+    if (bPublishTf)
     {
         ret = rcl_publish(&g_publishers_PositionMonitor.transform, g_messages_PositionMonitor.transform, NULL);
         RCL_UNUSED(ret);
+        Ros_IdlePublishing_CountPublished(IDLE_PUBLISHING_TOPIC_TF, ROSIDL_GET_MSG_TYPE_SUPPORT(tf2_msgs, msg, TFMessage), g_messages_PositionMonitor.transform);
+        Ros_PositionMonitor_SetPublished(IDLE_PUBLISHING_TOPIC_TF, snapshot->fbPulsePos);
+
+        //static transforms are only (re)published when one of them changed
+        if (positionMonitor_bStaticTransformsChanged)
+        {
+            for (int i = 0; i < g_messages_PositionMonitor.transformStatic->transforms.size; i += 1)
+                Ros_Nanos_To_Time_Msg(theTime, &g_messages_PositionMonitor.transformStatic->transforms.data[i].header.stamp);
+
+            ret = rcl_publish(&g_publishers_PositionMonitor.transformStatic, g_messages_PositionMonitor.transformStatic, NULL);
+            if (ret == RCL_RET_OK)
+            {
+                positionMonitor_bStaticTransformsChanged = FALSE;
+                Ros_IdlePublishing_CountPublished(IDLE_PUBLISHING_TOPIC_TF, ROSIDL_GET_MSG_TYPE_SUPPORT(tf2_msgs, msg, TFMessage), g_messages_PositionMonitor.transformStatic);
+            }
+        }
     }
 }
+
+void Ros_PositionMonitor_PublishJointCommandStates()
+{
+    MotionControl_CommandState commandState;
+    sensor_msgs__msg__JointState* msg = g_messages_PositionMonitor.jointCommandStates;
+
+    if (!Ros_MotionControl_GetCommandState(&commandState))
+        return;
+
+    //While the robot is stationary, only publish if the command changed or the keep-alive period expired
+    BOOL bChanged = Ros_PositionMonitor_HasPositionChanged(IDLE_PUBLISHING_TOPIC_JOINT_COMMAND_STATES, (long const (*)[MAX_PULSE_AXES])commandState.pulsePos);
+    if (!Ros_IdlePublishing_ShouldPublish(IDLE_PUBLISHING_TOPIC_JOINT_COMMAND_STATES, bChanged))
+        return;
+
+    //stamped with the interpolation cycle in which the command was read, not the time of publishing
+    Ros_Nanos_To_Time_Msg(commandState.timestamp, &msg->header.stamp);
+
+    int iteratorAllAxes = 0;
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        double radPos_ros[MAX_PULSE_AXES];
+        double radSpeed_ros[MAX_PULSE_AXES];
+        CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+
+        Ros_CtrlGroup_ConvertToRosPos(group, commandState.pulsePos[groupIndex], radPos_ros);
+        memcpy(&msg->position.data[iteratorAllAxes], radPos_ros, sizeof(double) * group->numAxes);
+
+        Ros_CtrlGroup_ConvertToRosPos(group, commandState.pulseSpeed[groupIndex], radSpeed_ros);
+        memcpy(&msg->velocity.data[iteratorAllAxes], radSpeed_ros, sizeof(double) * group->numAxes);
+
+        iteratorAllAxes += group->numAxes;
+    }
+    msg->position.size = msg->velocity.size = g_Ros_Controller.totalAxesCount;
+
+    rcl_ret_t ret = rcl_publish(&g_publishers_PositionMonitor.jointCommandStates, msg, NULL);
+    RCL_UNUSED(ret);
+    Ros_IdlePublishing_CountPublished(IDLE_PUBLISHING_TOPIC_JOINT_COMMAND_STATES, ROSIDL_GET_MSG_TYPE_SUPPORT(sensor_msgs, msg, JointState), msg);
+
+    Ros_PositionMonitor_SetPublished(IDLE_PUBLISHING_TOPIC_JOINT_COMMAND_STATES, (long const (*)[MAX_PULSE_AXES])commandState.pulsePos);
+}
@@ -8,33 +8,74 @@
 #ifndef MOTOROS2_POSITION_MONITOR_H
 #define MOTOROS2_POSITION_MONITOR_H
 
+//Number of TF updates after which the tool file
+//is read again, to detect changes made to it on the teach pendant
+#define TOOL_DATA_REFRESH_CYCLES    50
+
+//To measure the time spent in Ros_PositionMonitor_CalculateTransforms(..) with and without
+//the cached tool transforms, add -DMOTOROS2_TF_TIMING_ENABLE to the *CompilerArguments.mps
+//of the controller. The tool transforms of all groups are then recalculated in every other
+//TF update, and the average time of both kinds of updates is reported on the debug log.
+#define TF_TIMING_REPORT_CYCLES     1000    // TF updates between reports
+
+//Minimum change in position of a base track axis before world -> base is recalculated
+//and /tf_static is published again
+#define BASE_TRACK_MOVED_THRESHOLD_PULSES   2
+
+//Links published on /tf_static. These only change when the selected tool
+//changes, or when the base track of a robot moves.
 typedef enum
 {
     tfLink_WorldToBase = 0,
-    tfLink_BaseToFlange,
     tfLink_FlangeToTool0,
     tfLink_FlangeToTcp,
 
-    NUMBER_TRANSFORM_LINKS_PER_ROBOT
-} TransformLinkIndex;
+    NUMBER_STATIC_TRANSFORM_LINKS_PER_ROBOT
+} StaticTransformLinkIndex;
+
+//Links published on /tf every cycle
+typedef enum
+{
+    tfLink_BaseToFlange = 0,
+
+    NUMBER_DYNAMIC_TRANSFORM_LINKS_PER_ROBOT
+} DynamicTransformLinkIndex;
 
 typedef struct
 {
     rcl_publisher_t jointStateAllGroups;
+    rcl_publisher_t jointCommandStates;
     rcl_publisher_t transform;
+    rcl_publisher_t transformStatic;
 } PositionMonitor_Publishers;
 extern PositionMonitor_Publishers g_publishers_PositionMonitor;
 
 typedef struct
 {
     sensor_msgs__msg__JointState* jointStateAllGroups;
+    sensor_msgs__msg__JointState* jointCommandStates;
     tf2_msgs__msg__TFMessage* transform;
+    tf2_msgs__msg__TFMessage* transformStatic;
 } PositionMonitor_Messages;
 extern PositionMonitor_Messages g_messages_PositionMonitor;
 
 extern void Ros_PositionMonitor_Initialize();
 extern void Ros_PositionMonitor_Cleanup();
 
-extern void Ros_PositionMonitor_UpdateLocation();
+//Convert the feedback of all groups in 'snapshot', and publish the topics which are due (see PublishScheduler)
+extern void Ros_PositionMonitor_UpdateLocation(ControllerSnapshot const* snapshot, BOOL bJointStatesDue, BOOL bGroupJointStatesDue, BOOL bTfDue);
+
+//Whether the feedback position in 'snapshot' changed by more than 'idle_change_threshold'
+//since 'topic' was last published, and record the position published on 'topic'. For topics
+//published outside of Ros_PositionMonitor_UpdateLocation (fi: robot_status).
+extern BOOL Ros_PositionMonitor_HasPositionChangedSincePublished(IdlePublishing_Topic topic, ControllerSnapshot const* snapshot);
+extern void Ros_PositionMonitor_SetPublishedPosition(IdlePublishing_Topic topic, ControllerSnapshot const* snapshot);
+
+//Publish the command position of all groups, as tracked by the IncMoveTask
+extern void Ros_PositionMonitor_PublishJointCommandStates();
+
+//Force the TF transforms depending on the tool data of a group to be recalculated
+//(fi: because a different tool was selected for it)
+extern void Ros_PositionMonitor_InvalidateToolCache(int groupIndex);
 
 #endif  // MOTOROS2_POSITION_MONITOR_H
@@ -0,0 +1,220 @@
+//PublishScheduler.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+typedef struct
+{
+    const char* name;
+    int period_ms;                          // 0: disabled
+    int ratio;                              // period, in number of base cycles
+    int phase;                              // cycle (within the period) in which the activity is executed
+    UINT32 executions;                      // number of executions in the current report period
+} PublishScheduler_TaskInfo;
+
+static PublishScheduler_TaskInfo publishScheduler_tasks[NUMBER_OF_PUBLISH_TASKS];
+
+static int publishScheduler_basePeriod_ms;
+static ULONG publishScheduler_baseTicks;
+static ULONG publishScheduler_tickStart;
+static UINT32 publishScheduler_cycle;
+
+//statistics for the current report period
+static ULONG publishScheduler_tickLastReport;
+static UINT32 publishScheduler_lateCycles;      // cycles which started after their scheduled time
+static UINT32 publishScheduler_skippedCycles;   // cycles dropped to catch up after an overrun
+
+static int Ros_PublishScheduler_Gcd(int a, int b)
+{
+    while (b != 0)
+    {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+//A configured period of 0 means: same rate as the status monitor
+static int Ros_PublishScheduler_EffectivePeriod(int configuredPeriod)
+{
+    return (configuredPeriod == 0) ? g_nodeConfigSettings.controller_status_monitor_period : configuredPeriod;
+}
+
+void Ros_PublishScheduler_Initialize()
+{
+    PublishScheduler_TaskInfo* tasks = publishScheduler_tasks;
+    int order[NUMBER_OF_PUBLISH_TASKS];
+    int numOrdered = 0;
+
+    bzero(publishScheduler_tasks, sizeof(publishScheduler_tasks));
+
+    tasks[PUBLISH_TASK_STATUS_MONITOR].name = "status monitor";
+    tasks[PUBLISH_TASK_STATUS_MONITOR].period_ms = g_nodeConfigSettings.controller_status_monitor_period;
+
+    tasks[PUBLISH_TASK_ROBOT_STATUS].name = TOPIC_NAME_ROBOT_STATUS;
+    tasks[PUBLISH_TASK_ROBOT_STATUS].period_ms = Ros_PublishScheduler_EffectivePeriod(g_nodeConfigSettings.robot_status_publish_period);
+
+    tasks[PUBLISH_TASK_JOINT_STATES].name = TOPIC_NAME_JOINT_STATES;
+    tasks[PUBLISH_TASK_JOINT_STATES].period_ms = Ros_PublishScheduler_EffectivePeriod(g_nodeConfigSettings.joint_states_publish_period);
+
+    tasks[PUBLISH_TASK_GROUP_JOINT_STATES].name = "ctrl_groups/.../" TOPIC_NAME_JOINT_STATES;
+    tasks[PUBLISH_TASK_GROUP_JOINT_STATES].period_ms = g_nodeConfigSettings.publish_group_joint_states ?
+        Ros_PublishScheduler_EffectivePeriod(g_nodeConfigSettings.group_joint_states_publish_period) : 0;
+
+    tasks[PUBLISH_TASK_TF].name = TOPIC_NAME_TF;
+    tasks[PUBLISH_TASK_TF].period_ms = g_nodeConfigSettings.publish_tf ?
+        Ros_PublishScheduler_EffectivePeriod(g_nodeConfigSettings.tf_publish_period) : 0;
+
+    tasks[PUBLISH_TASK_JOINT_COMMAND_STATES].name = TOPIC_NAME_JOINT_COMMAND_STATES;
+    tasks[PUBLISH_TASK_JOINT_COMMAND_STATES].period_ms = g_nodeConfigSettings.publish_joint_command_states ?
+        Ros_PublishScheduler_EffectivePeriod(g_nodeConfigSettings.joint_command_states_publish_period) : 0;
+
+    //the base period is the largest period of which all periods are a multiple
+    publishScheduler_basePeriod_ms = 0;
+    for (int i = 0; i < NUMBER_OF_PUBLISH_TASKS; i += 1)
+    {
+        if (tasks[i].period_ms > 0)
+            publishScheduler_basePeriod_ms = Ros_PublishScheduler_Gcd(publishScheduler_basePeriod_ms, tasks[i].period_ms);
+    }
+
+    publishScheduler_baseTicks = (ULONG)((publishScheduler_basePeriod_ms / mpGetRtc()) + 0.5f); //Tick length varies between controller models
+    if (publishScheduler_baseTicks < 1)
+        publishScheduler_baseTicks = 1;
+
+    //rate monotonic order: shortest period first (ties keep the execution order)
+    for (int i = 0; i < NUMBER_OF_PUBLISH_TASKS; i += 1)
+    {
+        if (tasks[i].period_ms == 0)
+            continue;
+
+        tasks[i].ratio = tasks[i].period_ms / publishScheduler_basePeriod_ms;
+
+        int pos = numOrdered;
+        while (pos > 0 && tasks[order[pos - 1]].period_ms > tasks[i].period_ms)
+        {
+            order[pos] = order[pos - 1];
+            pos -= 1;
+        }
+        order[pos] = i;
+        numOrdered += 1;
+    }
+
+    //Give each activity the phase in which it coincides with the fewest activities that were
+    //already scheduled, to spread the publications over the cycles instead of sending them in
+    //bursts. Two activities coincide in some cycle if their phases are equal modulo the GCD
+    //of their ratios.
+    for (int i = 0; i < numOrdered; i += 1)
+    {
+        PublishScheduler_TaskInfo* task = &tasks[order[i]];
+        int bestPhase = 0;
+        int bestLoad = INT_MAX;
+
+        for (int phase = 0; phase < task->ratio; phase += 1)
+        {
+            int load = 0;
+            for (int j = 0; j < i; j += 1)
+            {
+                PublishScheduler_TaskInfo* scheduled = &tasks[order[j]];
+                int gcd = Ros_PublishScheduler_Gcd(task->ratio, scheduled->ratio);
+                if ((phase % gcd) == (scheduled->phase % gcd))
+                    load += 1;
+            }
+
+            if (load < bestLoad)
+            {
+                bestLoad = load;
+                bestPhase = phase;
+            }
+        }
+        task->phase = bestPhase;
+    }
+
+    Ros_Debug_BroadcastMsg("PublishScheduler: base period %d ms (%lu ticks)", publishScheduler_basePeriod_ms, publishScheduler_baseTicks);
+    for (int i = 0; i < NUMBER_OF_PUBLISH_TASKS; i += 1)
+    {
+        if (tasks[i].period_ms == 0)
+            Ros_Debug_BroadcastMsg("PublishScheduler: - %s: disabled", tasks[i].name);
+        else
+            Ros_Debug_BroadcastMsg("PublishScheduler: - %s: every %d ms (offset %d ms)",
+                tasks[i].name, tasks[i].period_ms, tasks[i].phase * publishScheduler_basePeriod_ms);
+    }
+
+    publishScheduler_cycle = 0;
+    publishScheduler_lateCycles = 0;
+    publishScheduler_skippedCycles = 0;
+    publishScheduler_tickStart = tickGet();
+    publishScheduler_tickLastReport = publishScheduler_tickStart;
+}
+
+static void Ros_PublishScheduler_ReportRates(ULONG tickNow)
+{
+    float seconds = ((tickNow - publishScheduler_tickLastReport) * mpGetRtc()) / 1000.0f;
+
+    for (int i = 0; i < NUMBER_OF_PUBLISH_TASKS; i += 1)
+    {
+        PublishScheduler_TaskInfo* task = &publishScheduler_tasks[i];
+
+        if (task->period_ms == 0)
+            continue;
+
+        Ros_Debug_BroadcastMsg("PublishScheduler: %s: %.1f Hz (target: %.1f Hz)",
+            task->name, task->executions / seconds, 1000.0f / task->period_ms);
+        task->executions = 0;
+    }
+
+    if (publishScheduler_lateCycles > 0)
+    {
+        Ros_Debug_BroadcastMsg("PublishScheduler: %u cycles started late, %u skipped",
+            publishScheduler_lateCycles, publishScheduler_skippedCycles);
+    }
+
+    publishScheduler_lateCycles = 0;
+    publishScheduler_skippedCycles = 0;
+    publishScheduler_tickLastReport = tickNow;
+}
+
+void Ros_PublishScheduler_WaitForNextCycle(PublishScheduler_Cycle* const cycle)
+{
+    publishScheduler_cycle += 1;
+
+    //(unsigned arithmetic handles rollover of the tick counter)
+    ULONG tickNext = publishScheduler_tickStart + (publishScheduler_cycle * publishScheduler_baseTicks);
+    ULONG tickNow = tickGet();
+    long ticksLate = (long)(tickNow - tickNext);
+
+    if (ticksLate > 0)
+    {
+        publishScheduler_lateCycles += 1;
+
+        //Don't execute missed cycles back-to-back. Continue with the first cycle that hasn't started yet.
+        if (ticksLate >= (long)publishScheduler_baseTicks)
+        {
+            UINT32 missedCycles = (UINT32)(ticksLate / publishScheduler_baseTicks);
+            publishScheduler_cycle += missedCycles;
+            publishScheduler_skippedCycles += missedCycles;
+            tickNext += missedCycles * publishScheduler_baseTicks;
+        }
+    }
+
+    long ticksToWait = (long)(tickNext - tickNow);
+    if (ticksToWait > 0)
+        mpTaskDelay(ticksToWait);
+
+    for (int i = 0; i < NUMBER_OF_PUBLISH_TASKS; i += 1)
+    {
+        PublishScheduler_TaskInfo* task = &publishScheduler_tasks[i];
+
+        cycle->bDue[i] = (task->period_ms > 0) && ((publishScheduler_cycle % task->ratio) == (UINT32)task->phase);
+        if (cycle->bDue[i])
+            task->executions += 1;
+    }
+
+    tickNow = tickGet();
+    if (((tickNow - publishScheduler_tickLastReport) * mpGetRtc()) >= PUBLISH_SCHEDULER_REPORT_PERIOD)
+        Ros_PublishScheduler_ReportRates(tickNow);
+}
@@ -0,0 +1,40 @@
+//PublishScheduler.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_PUBLISH_SCHEDULER_H
+#define MOTOROS2_PUBLISH_SCHEDULER_H
+
+#define PUBLISH_SCHEDULER_REPORT_PERIOD     60000   // ms between reports of the achieved rates on the debug log
+
+//Periodic activities of the RosInitTask. Activities due in the same cycle are
+//executed in this order.
+typedef enum
+{
+    PUBLISH_TASK_STATUS_MONITOR = 0,        // poll controller status and I/O
+    PUBLISH_TASK_ROBOT_STATUS,
+    PUBLISH_TASK_JOINT_STATES,
+    PUBLISH_TASK_GROUP_JOINT_STATES,
+    PUBLISH_TASK_TF,
+    PUBLISH_TASK_JOINT_COMMAND_STATES,
+
+    NUMBER_OF_PUBLISH_TASKS
+} PublishScheduler_Task;
+
+typedef struct
+{
+    BOOL bDue[NUMBER_OF_PUBLISH_TASKS];
+} PublishScheduler_Cycle;
+
+//Determine the base period, and the period and phase of each activity, from the configuration
+extern void Ros_PublishScheduler_Initialize();
+
+//Sleep until the start of the next cycle, and report which activities are due in it.
+//Cycles start at fixed multiples of the base period, so time spent executing the
+//activities does not cause the rates to drift.
+extern void Ros_PublishScheduler_WaitForNextCycle(PublishScheduler_Cycle* const cycle);
+
+#endif  // MOTOROS2_PUBLISH_SCHEDULER_H
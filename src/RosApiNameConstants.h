@@ -13,8 +13,16 @@
 // Topic, service and action server names
 //============================================
 #define TOPIC_NAME_TF "tf"
+#define TOPIC_NAME_TF_STATIC "tf_static"
 #define TOPIC_NAME_ROBOT_STATUS "robot_status"
 #define TOPIC_NAME_JOINT_STATES "joint_states"
+#define TOPIC_NAME_JOINT_COMMAND_STATES "joint_command_states"
+#define TOPIC_NAME_JOINT_STATES_COMPACT "joint_states_compact"
+#define TOPIC_NAME_JOINT_STATES_COMPACT_JOINT_NAMES "joint_states_compact/joint_names"
+#define TOPIC_NAME_TWIST_SERVO "twist_servo"
+#define TOPIC_NAME_JOINT_STATES_BATCH "joint_states_batch"
+#define TOPIC_NAME_JOINT_COMMANDS_BATCH "joint_commands_batch"
+#define TOPIC_NAME_SET_LOG_LEVEL "set_log_level"
 
 #define SERVICE_NAME_READ_SINGLE_IO "read_single_io"
 #define SERVICE_NAME_READ_GROUP_IO "read_group_io"
@@ -184,17 +184,6 @@ void Ros_mpGetRobotCalibrationData_Initialize()
 #endif
 }
 
-void Ros_mpGetRobotCalibrationData_Cleanup()
-{
-#if defined (FS100) || defined (DX200)
-    for (int i = 0; i < MAX_ROBOT_CALIBRATION_FILES; i += 1)
-    {
-        if (Ros_CalibrationFiles[i])
-            mpFree(Ros_CalibrationFiles[i]);
-    }
-#endif
-}
-
 LONG Ros_mpGetRobotCalibrationData(ULONG file_no, MP_RB_CALIB_DATA *rData)
 {
 #if defined (YRC1000) || defined (YRC1000u)
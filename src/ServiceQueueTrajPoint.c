@@ -74,6 +74,8 @@ void Ros_ServiceQueueTrajPoint_Trigger(const void* request_msg, void* response_m
     QueueTrajPointRequest* request = (QueueTrajPointRequest*)request_msg;
     QueueTrajPointResponse* response = (QueueTrajPointResponse*)response_msg;
 
+    Ros_Communication_NotifyAgentActivity();
+
     Ros_Debug_BroadcastMsg("Streaming point received");
 
     if (!Ros_MotionControl_IsMotionMode_PointQueue())
@@ -95,6 +95,7 @@ void Ros_ServiceSelectMotionTool_Trigger(const void* request_msg, void* response
     //      haven't yet been added to the increment queue. See also the ROS 2
     //      'select_tool' service definition file in motoros2_interfaces.
     g_Ros_Controller.ctrlGroups[request->group_number]->tool = request->tool_number;
+    Ros_PositionMonitor_InvalidateToolCache(request->group_number);
 
     //report to caller
     rosidl_runtime_c__String__assign(&response->message, motoros2_interfaces__msg__SelectionResultCodes__OK_STR);
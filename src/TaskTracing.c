@@ -0,0 +1,132 @@
+// TaskTracing.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+#ifdef MOTOROS2_TASK_TRACE_ENABLE
+
+//Single producer (the traced task), single consumer (the debug log task). The ring is
+//overwritten when the log task doesn't keep up, the log task detects and skips those events.
+typedef struct
+{
+    TaskTrace_Event events[TASK_TRACE_RING_SIZE];
+    volatile UINT32 writePos;
+    UINT32 readPos;             //only used by the debug log task
+} TaskTrace_Ring;
+
+static TaskTrace_Ring taskTrace_rings[NUM_TASK_TRACE_TASKS];
+static volatile UINT32 taskTrace_order = 0;
+static UINT32 taskTrace_numLost = 0;
+static UINT32 taskTrace_datagramSequence = 0;
+
+void Ros_TaskTrace_Record(TaskTrace_Task task, TaskTrace_Point point, TaskTrace_Phase phase)
+{
+    TaskTrace_Ring* ring = &taskTrace_rings[task];
+    UINT32 pos = ring->writePos;
+    TaskTrace_Event* event = &ring->events[pos & (TASK_TRACE_RING_SIZE - 1)];
+
+    event->order = __sync_fetch_and_add(&taskTrace_order, 1);
+    event->tick = (UINT32)tickGet();
+    event->task = (UINT8)task;
+    event->phase = (UINT8)phase;
+    event->point = (UINT16)point;
+
+    __sync_synchronize();
+    ring->writePos = pos + 1;
+}
+
+static void Ros_TaskTrace_Send(TaskTrace_Event const* events, UINT16 numEvents)
+{
+    UINT8 datagram[TELEMETRY_HEADER_WIRE_SIZE + (TASK_TRACE_MAX_EVENTS_PER_DATAGRAM * TASK_TRACE_EVENT_WIRE_SIZE)];
+    UINT8* pos = datagram + TELEMETRY_HEADER_WIRE_SIZE;
+    Telemetry_DatagramHeader header;
+
+    for (UINT16 i = 0; i < numEvents; i += 1)
+    {
+        pos = Ros_Telemetry_PutU32(pos, events[i].tick);
+        pos = Ros_Telemetry_PutU32(pos, events[i].order);
+        *pos++ = events[i].task;
+        *pos++ = events[i].phase;
+        pos = Ros_Telemetry_PutU16(pos, events[i].point);
+    }
+
+    memcpy(header.magic, TASK_TRACE_MAGIC, sizeof(header.magic));
+    header.version = TASK_TRACE_FORMAT_VERSION;
+    header.headerSize = TELEMETRY_HEADER_WIRE_SIZE;
+    header.numRecords = numEvents;
+    header.sequence = taskTrace_datagramSequence++;
+    header.numDropped = taskTrace_numLost;
+    header.sendTime_ns = Ros_ClockSync_Now();
+    header.sendTick = (UINT32)tickGet();
+    header.tickPeriod_us = (UINT32)(mpGetRtc() * 1000);
+    Ros_Telemetry_PutHeader(datagram, &header);
+
+    Ros_Debug_SendDatagram(datagram, TELEMETRY_HEADER_WIRE_SIZE + (numEvents * TASK_TRACE_EVENT_WIRE_SIZE));
+}
+
+void Ros_TaskTrace_Flush()
+{
+    TaskTrace_Event events[TASK_TRACE_MAX_EVENTS_PER_DATAGRAM];
+    UINT16 numEvents = 0;
+
+    for (int task = 0; task < NUM_TASK_TRACE_TASKS; task += 1)
+    {
+        TaskTrace_Ring* ring = &taskTrace_rings[task];
+
+        FOREVER
+        {
+            UINT32 writePos = ring->writePos;
+            UINT32 numCopied = 0;
+
+            //skip what has been overwritten already
+            if (writePos - ring->readPos > TASK_TRACE_RING_SIZE)
+            {
+                taskTrace_numLost += writePos - TASK_TRACE_RING_SIZE - ring->readPos;
+                ring->readPos = writePos - TASK_TRACE_RING_SIZE;
+            }
+
+            if (ring->readPos == writePos)
+                break;
+
+            while (ring->readPos + numCopied != writePos && numEvents + numCopied < TASK_TRACE_MAX_EVENTS_PER_DATAGRAM)
+            {
+                events[numEvents + numCopied] = ring->events[(ring->readPos + numCopied) & (TASK_TRACE_RING_SIZE - 1)];
+                numCopied += 1;
+            }
+
+            //The task may have wrapped around while the events were copied. The event at
+            //'writePos' may be in the process of being written, so anything at or before
+            //'writePos - TASK_TRACE_RING_SIZE' can't be trusted.
+            __sync_synchronize();
+            UINT32 writePosAfter = ring->writePos;
+            UINT32 numOverwritten = 0;
+            if ((INT32)(writePosAfter - TASK_TRACE_RING_SIZE - ring->readPos) >= 0)
+                numOverwritten = writePosAfter - TASK_TRACE_RING_SIZE - ring->readPos + 1;
+            if (numOverwritten > numCopied)
+                numOverwritten = numCopied;
+
+            if (numOverwritten > 0)
+            {
+                memmove(&events[numEvents], &events[numEvents + numOverwritten], (numCopied - numOverwritten) * sizeof(TaskTrace_Event));
+                taskTrace_numLost += numOverwritten;
+            }
+            numEvents += numCopied - numOverwritten;
+            ring->readPos += numCopied;
+
+            if (numEvents == TASK_TRACE_MAX_EVENTS_PER_DATAGRAM)
+            {
+                Ros_TaskTrace_Send(events, numEvents);
+                numEvents = 0;
+            }
+        }
+    }
+
+    if (numEvents > 0)
+        Ros_TaskTrace_Send(events, numEvents);
+}
+
+#endif  // MOTOROS2_TASK_TRACE_ENABLE
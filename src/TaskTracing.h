@@ -0,0 +1,94 @@
+// TaskTracing.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_TASK_TRACING_H
+#define MOTOROS2_TASK_TRACING_H
+
+//Records when the time-critical tasks start and finish their work, to see how they
+//interleave (fi: whether the AddToIncQueue tasks keep up with the IncMoveTask). To
+//enable it, add -DMOTOROS2_TASK_TRACE_ENABLE to the *CompilerArguments.mps of the
+//controller. The events are streamed on the debug log port by the debug log task.
+//tools/task_trace_to_chrome.py converts them to a trace for chrome://tracing or Perfetto.
+
+//Every traced task writes to its own ring, so recording doesn't need a lock
+typedef enum
+{
+    TASK_TRACE_TASK_INCMOVE = 0,
+    TASK_TRACE_TASK_ADD_TO_INC_QUEUE,                                                       // + group index
+    TASK_TRACE_TASK_EXECUTOR = TASK_TRACE_TASK_ADD_TO_INC_QUEUE + MAX_CONTROLLABLE_GROUPS,  // + Communication_Executor
+    TASK_TRACE_TASK_MAIN = TASK_TRACE_TASK_EXECUTOR + NUM_COMMUNICATION_EXECUTORS,          // status and feedback publishing
+
+    NUM_TASK_TRACE_TASKS
+} TaskTrace_Task;
+
+//Do not renumber: the converter uses these values
+typedef enum
+{
+    TASK_TRACE_POINT_INCMOVE_CYCLE = 1,         // one interpolation cycle of the IncMoveTask
+    TASK_TRACE_POINT_INCMOVE_SEND = 2,          // mpExRcsIncrementMove
+    TASK_TRACE_POINT_INTERPOLATE_POINT = 3,     // interpolating one trajectory point into increments
+    TASK_TRACE_POINT_INTERPOLATE_YIELD = 4,     // sleeping in the middle of a point, to not starve other tasks
+    TASK_TRACE_POINT_EXECUTOR_CALLBACK = 5,     // a service, subscription, action or timer callback
+    TASK_TRACE_POINT_EXECUTOR_HOUSEKEEPING = 6,
+    TASK_TRACE_POINT_STATUS_CYCLE = 7,          // one cycle of the main publishing loop
+} TaskTrace_Point;
+
+typedef enum
+{
+    TASK_TRACE_PHASE_BEGIN = 0,
+    TASK_TRACE_PHASE_END,
+} TaskTrace_Phase;
+
+#define TASK_TRACE_RING_SIZE                512     // events per task, must be a power of 2
+#define TASK_TRACE_MAX_EVENTS_PER_DATAGRAM  96
+
+//Datagrams use the same header as the telemetry (see Telemetry.h), with TASK_TRACE_MAGIC.
+//'numDropped' counts events which were overwritten before they could be sent. Like the
+//telemetry, the events are written without padding, in little-endian byte order.
+#define TASK_TRACE_MAGIC                    "MR2X"
+#define TASK_TRACE_FORMAT_VERSION           1
+
+#define TASK_TRACE_EVENT_WIRE_SIZE          12      // bytes
+
+typedef struct
+{
+    UINT32 tick;
+    UINT32 order;               // across all tasks, to order events within the same tick
+    UINT8 task;                 // TaskTrace_Task
+    UINT8 phase;                // TaskTrace_Phase
+    UINT16 point;               // TaskTrace_Point
+} TaskTrace_Event;
+
+
+#ifdef MOTOROS2_TASK_TRACE_ENABLE
+
+
+#define MOTOROS2_TASK_TRACE_BEGIN(task, point) \
+    Ros_TaskTrace_Record((task), (point), TASK_TRACE_PHASE_BEGIN)
+
+#define MOTOROS2_TASK_TRACE_END(task, point) \
+    Ros_TaskTrace_Record((task), (point), TASK_TRACE_PHASE_END)
+
+//Only the task which owns the ring of 'task' may record events for it
+extern void Ros_TaskTrace_Record(TaskTrace_Task task, TaskTrace_Point point, TaskTrace_Phase phase);
+
+//Send the events recorded since the last call. Only called by the debug log task.
+extern void Ros_TaskTrace_Flush();
+
+
+#else  // MOTOROS2_TASK_TRACE_ENABLE
+
+
+// no-ops if disabled
+#define MOTOROS2_TASK_TRACE_BEGIN(task, point)
+#define MOTOROS2_TASK_TRACE_END(task, point)
+
+
+#endif  // MOTOROS2_TASK_TRACE_ENABLE
+
+
+#endif  // MOTOROS2_TASK_TRACING_H
@@ -0,0 +1,173 @@
+//Telemetry.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+//Same multi-producer, single-consumer queue as the one for the debug log messages (see
+//Ros_Debug_QueueMsg). A record is complete when it's queued, so the producer only copies it.
+typedef struct
+{
+    volatile UINT32 sequence;
+    Telemetry_Record record;
+} Telemetry_QueueEntry;
+
+static Telemetry_QueueEntry telemetry_queue[TELEMETRY_QUEUE_SIZE];
+static volatile UINT32 telemetry_enqueuePos = 0;
+static UINT32 telemetry_dequeuePos = 0;     //only used by the debug log task
+static volatile UINT32 telemetry_numDropped = 0;
+static volatile BOOL telemetry_bEnabled = FALSE;
+
+static UINT32 telemetry_datagramSequence = 0;
+
+void Ros_Telemetry_Initialize()
+{
+    for (UINT32 i = 0; i < TELEMETRY_QUEUE_SIZE; i += 1)
+        telemetry_queue[i].sequence = i;
+    telemetry_enqueuePos = 0;
+    telemetry_dequeuePos = 0;
+
+    telemetry_bEnabled = g_nodeConfigSettings.log_telemetry;
+}
+
+BOOL Ros_Telemetry_IsEnabled()
+{
+    return telemetry_bEnabled;
+}
+
+void Ros_Telemetry_Record(Telemetry_Event event, UINT16 group, INT32 field0, INT32 field1, INT32 field2, INT32 field3)
+{
+    Telemetry_QueueEntry* entry;
+    UINT32 pos;
+
+    if (!telemetry_bEnabled)
+        return;
+
+    pos = telemetry_enqueuePos;
+    FOREVER
+    {
+        entry = &telemetry_queue[pos & (TELEMETRY_QUEUE_SIZE - 1)];
+        INT32 diff = (INT32)(entry->sequence - pos);
+
+        if (diff == 0)
+        {
+            if (__sync_bool_compare_and_swap(&telemetry_enqueuePos, pos, pos + 1))
+                break;
+            pos = telemetry_enqueuePos;
+        }
+        else if (diff < 0)
+        {
+            //queue is full
+            __sync_fetch_and_add(&telemetry_numDropped, 1);
+            return;
+        }
+        else
+            pos = telemetry_enqueuePos;
+    }
+
+    entry->record.event = (UINT16)event;
+    entry->record.group = group;
+    entry->record.tick = (UINT32)tickGet();
+    entry->record.fields[0] = field0;
+    entry->record.fields[1] = field1;
+    entry->record.fields[2] = field2;
+    entry->record.fields[3] = field3;
+
+    __sync_synchronize();
+    entry->sequence = pos + 1;
+}
+
+UINT8* Ros_Telemetry_PutU16(UINT8* pos, UINT16 value)
+{
+    pos[0] = (UINT8)value;
+    pos[1] = (UINT8)(value >> 8);
+    return pos + 2;
+}
+
+UINT8* Ros_Telemetry_PutU32(UINT8* pos, UINT32 value)
+{
+    pos = Ros_Telemetry_PutU16(pos, (UINT16)value);
+    return Ros_Telemetry_PutU16(pos, (UINT16)(value >> 16));
+}
+
+UINT8* Ros_Telemetry_PutI64(UINT8* pos, INT64 value)
+{
+    pos = Ros_Telemetry_PutU32(pos, (UINT32)value);
+    return Ros_Telemetry_PutU32(pos, (UINT32)((UINT64)value >> 32));
+}
+
+UINT8* Ros_Telemetry_PutHeader(UINT8* pos, Telemetry_DatagramHeader const* header)
+{
+    memcpy(pos, header->magic, sizeof(header->magic));
+    pos += sizeof(header->magic);
+    *pos++ = header->version;
+    *pos++ = header->headerSize;
+    pos = Ros_Telemetry_PutU16(pos, header->numRecords);
+    pos = Ros_Telemetry_PutU32(pos, header->sequence);
+    pos = Ros_Telemetry_PutU32(pos, header->numDropped);
+    pos = Ros_Telemetry_PutI64(pos, header->sendTime_ns);
+    pos = Ros_Telemetry_PutU32(pos, header->sendTick);
+    return Ros_Telemetry_PutU32(pos, header->tickPeriod_us);
+}
+
+static UINT8* Ros_Telemetry_PutRecord(UINT8* pos, Telemetry_Record const* record)
+{
+    pos = Ros_Telemetry_PutU16(pos, record->event);
+    pos = Ros_Telemetry_PutU16(pos, record->group);
+    pos = Ros_Telemetry_PutU32(pos, record->tick);
+    for (int i = 0; i < TELEMETRY_NUM_FIELDS; i += 1)
+        pos = Ros_Telemetry_PutU32(pos, (UINT32)record->fields[i]);
+    return pos;
+}
+
+void Ros_Telemetry_Flush()
+{
+    UINT8 datagram[TELEMETRY_HEADER_WIRE_SIZE + (TELEMETRY_MAX_RECORDS_PER_DATAGRAM * TELEMETRY_RECORD_WIRE_SIZE)];
+    Telemetry_DatagramHeader header;
+
+    if (!telemetry_bEnabled)
+        return;
+
+    FOREVER
+    {
+        UINT16 numRecords = 0;
+        UINT8* pos = datagram + TELEMETRY_HEADER_WIRE_SIZE;
+        Telemetry_QueueEntry* entry = &telemetry_queue[telemetry_dequeuePos & (TELEMETRY_QUEUE_SIZE - 1)];
+
+        while (numRecords < TELEMETRY_MAX_RECORDS_PER_DATAGRAM && entry->sequence == telemetry_dequeuePos + 1)
+        {
+            pos = Ros_Telemetry_PutRecord(pos, &entry->record);
+            numRecords += 1;
+
+            __sync_synchronize();
+            entry->sequence = telemetry_dequeuePos + TELEMETRY_QUEUE_SIZE;
+            telemetry_dequeuePos += 1;
+            entry = &telemetry_queue[telemetry_dequeuePos & (TELEMETRY_QUEUE_SIZE - 1)];
+        }
+
+        if (numRecords == 0)
+            return;
+
+        memcpy(header.magic, TELEMETRY_MAGIC, sizeof(header.magic));
+        header.version = TELEMETRY_FORMAT_VERSION;
+        header.headerSize = TELEMETRY_HEADER_WIRE_SIZE;
+        header.numRecords = numRecords;
+        header.sequence = telemetry_datagramSequence++;
+        header.numDropped = telemetry_numDropped;
+        header.sendTime_ns = Ros_ClockSync_Now();
+        header.sendTick = (UINT32)tickGet();
+        header.tickPeriod_us = (UINT32)(mpGetRtc() * 1000);
+        Ros_Telemetry_PutHeader(datagram, &header);
+
+        Ros_Debug_SendDatagram(datagram, TELEMETRY_HEADER_WIRE_SIZE + (numRecords * TELEMETRY_RECORD_WIRE_SIZE));
+    }
+}
+
+INT32 Ros_Telemetry_GoalId(UINT8 const* uuid)
+{
+    //little-endian, like all the other values, so the bytes are sent in UUID order
+    return (INT32)((UINT32)uuid[0] | ((UINT32)uuid[1] << 8) | ((UINT32)uuid[2] << 16) | ((UINT32)uuid[3] << 24));
+}
@@ -0,0 +1,108 @@
+//Telemetry.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_TELEMETRY_H
+#define MOTOROS2_TELEMETRY_H
+
+#define TELEMETRY_QUEUE_SIZE                256     // records, must be a power of 2
+#define TELEMETRY_NUM_FIELDS                4
+#define TELEMETRY_MAX_RECORDS_PER_DATAGRAM  48
+
+//Telemetry is sent on the debug log port, in datagrams which start with TELEMETRY_MAGIC
+//(text messages start with a timestamp).
+//
+//  Telemetry_DatagramHeader, followed by 'numRecords' times Telemetry_Record
+//
+//The structs are only the in-memory representation. On the wire, the fields are written
+//one after the other, without padding, in little-endian byte order (whatever the byte
+//order of the controller), see Ros_Telemetry_PutHeader.
+//
+//tools/debug_listener.py decodes the records. Keep it in sync with any changes here, and
+//increment TELEMETRY_FORMAT_VERSION if the layout changes.
+#define TELEMETRY_MAGIC                     "MR2T"
+#define TELEMETRY_FORMAT_VERSION            1
+
+#define TELEMETRY_HEADER_WIRE_SIZE          32      // bytes
+#define TELEMETRY_RECORD_WIRE_SIZE          24
+
+typedef struct
+{
+    char magic[4];
+    UINT8 version;
+    UINT8 headerSize;           // bytes, so fields can be added at the end
+    UINT16 numRecords;
+    UINT32 sequence;            // of the datagram
+    UINT32 numDropped;          // records dropped because the queue was full (since boot)
+    INT64 sendTime_ns;          // MotoROS2 clock when the datagram was sent ...
+    UINT32 sendTick;            // ... and the tick at that time
+    UINT32 tickPeriod_us;
+} Telemetry_DatagramHeader;
+
+typedef struct
+{
+    UINT16 event;               // Telemetry_Event
+    UINT16 group;               // event specific (fi: a control group, or a mask of groups)
+    UINT32 tick;
+    INT32 fields[TELEMETRY_NUM_FIELDS];
+} Telemetry_Record;
+
+//Do not renumber: the listener uses these values
+typedef enum
+{
+    //Every cycle of the IncMoveTask in which increments are sent.
+    //group: mask of the groups which got increments from their queue
+    //fields: increments left in all queues, peak backlog (pulses), mpExRcsIncrementMove result,
+    //        flags (bit 0: a queue ran dry, bit 1: pulses were not processed (FSU speed limit))
+    TELEMETRY_EVENT_INCMOVE_CYCLE = 1,
+
+    //group: unused
+    //fields: goal id (first 4 bytes of the UUID), number of points, Cartesian (0/1), staged (0/1)
+    TELEMETRY_EVENT_FJT_GOAL_RECEIVED = 2,
+
+    //Execution of the trajectory started
+    //fields: goal id, -, -, -
+    TELEMETRY_EVENT_FJT_GOAL_ACTIVATED = 3,
+
+    //group: GOAL_END_TYPE
+    //fields: goal id, result error code, planned duration (ms), actual duration (ms)
+    TELEMETRY_EVENT_FJT_GOAL_COMPLETE = 4,
+
+    //The result was sent to the client (also for rejected goals)
+    //fields: goal id, goal state, result error code, -
+    TELEMETRY_EVENT_FJT_RESULT_SENT = 5,
+
+    //Every clock sync update which produced a sample
+    //fields: offset (us), round trip (us), drift (ppb), jitter (us)
+    TELEMETRY_EVENT_CLOCK_SYNC = 6,
+} Telemetry_Event;
+
+//Enable recording if 'log_telemetry' is set. Records are discarded until this is called.
+extern void Ros_Telemetry_Initialize();
+
+extern BOOL Ros_Telemetry_IsEnabled();
+
+//Copies the record to a queue, which is emptied by the debug log task. Never blocks, so it
+//can be called from any task. Records are dropped (and counted) if the queue is full.
+extern void Ros_Telemetry_Record(Telemetry_Event event, UINT16 group, INT32 field0, INT32 field1, INT32 field2, INT32 field3);
+
+//Send everything which has been queued. Only called by the debug log task.
+extern void Ros_Telemetry_Flush();
+
+//First 4 bytes of a goal UUID, to correlate the records of a goal. Sent in the same byte
+//order as in the UUID.
+extern INT32 Ros_Telemetry_GoalId(UINT8 const* uuid);
+
+//Write a value in little-endian byte order. Return the position after the value.
+extern UINT8* Ros_Telemetry_PutU16(UINT8* pos, UINT16 value);
+extern UINT8* Ros_Telemetry_PutU32(UINT8* pos, UINT32 value);
+extern UINT8* Ros_Telemetry_PutI64(UINT8* pos, INT64 value);
+
+//Write the header in the wire format (TELEMETRY_HEADER_WIRE_SIZE bytes). Also used for the
+//task trace datagrams.
+extern UINT8* Ros_Telemetry_PutHeader(UINT8* pos, Telemetry_DatagramHeader const* header);
+
+#endif  // MOTOROS2_TELEMETRY_H
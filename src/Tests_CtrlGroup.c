@@ -34,6 +34,8 @@ void Ros_Testing_CtrlGroup_MakeFake6dofRobot(CtrlGroup* group)
     group->pulseToRad.PtoR[5] = 4;
     group->pulseToRad.PtoR[6] = 3;
     group->pulseToRad.PtoR[7] = 2;
+
+    Ros_CtrlGroup_InitializeConversionTables(group);
 }
 
 void Ros_Testing_CtrlGroup_MakeFakeDeltaRobot(CtrlGroup* group)
@@ -61,6 +63,8 @@ void Ros_Testing_CtrlGroup_MakeFakeDeltaRobot(CtrlGroup* group)
     group->pulseToRad.PtoR[5] = 4;
     group->pulseToRad.PtoR[6] = 3;
     group->pulseToRad.PtoR[7] = 2;
+
+    Ros_CtrlGroup_InitializeConversionTables(group);
 }
 
 void Ros_Testing_CtrlGroup_MakeFakeSiaRobot(CtrlGroup* group)
@@ -88,6 +92,8 @@ void Ros_Testing_CtrlGroup_MakeFakeSiaRobot(CtrlGroup* group)
     group->pulseToRad.PtoR[5] = 4;
     group->pulseToRad.PtoR[6] = 3;
     group->pulseToRad.PtoR[7] = 2;
+
+    Ros_CtrlGroup_InitializeConversionTables(group);
 }
 
 BOOL Ros_Testing_CtrlGroup_PosConverters()
@@ -145,7 +151,7 @@ BOOL Ros_Testing_CtrlGroup_PosConverters()
     Ros_Debug_BroadcastMsg("Testing CtrlGroup ConvertToMotoPos - 6 DOF style: %s", bOk ? "PASS" : "FAIL");
     if (!bOk)
     {
-        Ros_Debug_BroadcastMsg("motoPos[0] = %d; motoPos[1] = %d; motoPos[2] = %d; motoPos[3] = %d; motoPos[4] = %d; motoPos[5] = %d; motoPos[6] = %d; motoPos[7] = %d",
+        Ros_Debug_BroadcastMsg("motoPos[0] = %ld; motoPos[1] = %ld; motoPos[2] = %ld; motoPos[3] = %ld; motoPos[4] = %ld; motoPos[5] = %ld; motoPos[6] = %ld; motoPos[7] = %ld",
             motoPos[0], motoPos[1], motoPos[2], motoPos[3], motoPos[4], motoPos[5], motoPos[6], motoPos[7]);
 
         bAllTestsPassed = FALSE;
@@ -185,7 +191,7 @@ BOOL Ros_Testing_CtrlGroup_PosConverters()
     Ros_Debug_BroadcastMsg("Testing CtrlGroup ConvertToMotoPos - Delta style: %s", bOk ? "PASS" : "FAIL");
     if (!bOk)
     {
-        Ros_Debug_BroadcastMsg("motoPos[0] = %d; motoPos[1] = %d; motoPos[2] = %d; motoPos[5] = %d",
+        Ros_Debug_BroadcastMsg("motoPos[0] = %ld; motoPos[1] = %ld; motoPos[2] = %ld; motoPos[5] = %ld",
             motoPos[0], motoPos[1], motoPos[2], motoPos[5]);
 
         bAllTestsPassed = FALSE;
@@ -231,7 +237,7 @@ BOOL Ros_Testing_CtrlGroup_PosConverters()
     Ros_Debug_BroadcastMsg("Testing CtrlGroup ConvertToMotoPos - SIA style: %s", bOk ? "PASS" : "FAIL");
     if (!bOk)
     {
-        Ros_Debug_BroadcastMsg("motoPos[0] = %d; motoPos[1] = %d; motoPos[2] = %d; motoPos[3] = %d; motoPos[4] = %d; motoPos[5] = %d; motoPos[6] = %d",
+        Ros_Debug_BroadcastMsg("motoPos[0] = %ld; motoPos[1] = %ld; motoPos[2] = %ld; motoPos[3] = %ld; motoPos[4] = %ld; motoPos[5] = %ld; motoPos[6] = %ld",
             motoPos[0], motoPos[1], motoPos[2], motoPos[3], motoPos[4], motoPos[5], motoPos[6]);
 
         bAllTestsPassed = FALSE;
@@ -264,12 +270,407 @@ BOOL Ros_Testing_CtrlGroup_HasBaseTrack()
     return bAllTestsPassed;
 }
 
+//-------------------------------------------------------------------------
+// Conversion tables
+//-------------------------------------------------------------------------
+
+#define TESTS_CTRL_GROUP_NUM_SAMPLES        2000    // random positions per group configuration
+#define TESTS_CTRL_GROUP_BENCHMARK_LOOPS    20000
+
+typedef struct
+{
+    const char* name;
+    MP_GRP_ID_TYPE groupId;
+    int numAxes;
+    const char* axes;       // type of each axis in motoman order: 'R'otary, 'L'inear or '-' (invalid)
+} Tests_CtrlGroup_Config;
+
+static const Tests_CtrlGroup_Config testsCtrlGroup_configs[] =
+{
+    { "6 DOF",              MP_R1_GID,  6,  "RRRRRR--" },
+    { "SIA (7 DOF)",        MP_R1_GID,  7,  "RRRRRRR-" },
+    { "Delta / Palletizing", MP_R1_GID, 4,  "RRR--R--" },   // same axis layout (SLU--T-)
+    { "Scara",              MP_R2_GID,  4,  "RRLR----" },
+    { "High speed picking", MP_R1_GID,  5,  "RRR-RR--" },
+    { "5 DOF",              MP_R1_GID,  5,  "RRRRR---" },
+    { "Base track",         MP_B1_GID,  1,  "L-------" },
+    { "Station (2 axes)",   MP_S1_GID,  2,  "RR------" },
+    { "Station (mixed)",    MP_S2_GID,  3,  "RLR-----" },
+};
+
+// Copies of the conversion functions as they were before the introduction of the
+// conversion tables. The table based implementations must give identical results.
+//Convert the Motoman position units (pulses) to ROS position units (radians/meters).
+//This function must be called BEFORE calling Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder.
+//The joints must be in Motoman (non-sequential) ordering.
+static void Ros_Testing_CtrlGroup_ReferenceConvertMotoUnitsToRosUnits(CtrlGroup* ctrlGroup, long const motopulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
+{
+    int i;
+    double conversion = 1;
+
+    bzero(rosPos, sizeof(double) * MAX_PULSE_AXES);
+
+    //Delta: (SLU--T-) All rotary axes
+    //Scara: (SLUR---) U-axis is linear
+    //Large Palletizing: (SLU--T-) All rotary axes
+    //High Speed Picking: (SLU-BT-) All rotary axes
+    for (i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
+        {
+            continue;
+        }
+
+        if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
+            conversion = ctrlGroup->pulseToRad.PtoR[i];
+        else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
+            conversion = ctrlGroup->pulseToMeter.PtoM[i];
+        else
+            conversion = 1.0;
+
+        rosPos[i] = motopulsePos[i] / conversion;
+    }
+
+}
+
+static void Ros_Testing_CtrlGroup_ReferenceConvertMotoJointOrderToSequentialJointOrder(CtrlGroup* ctrlGroup, double const motoPos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
+{
+    int i;
+
+    if ((ctrlGroup->numAxes == 7) && Ros_CtrlGroup_IsRobot(ctrlGroup)) //is robot, and is 7 axis
+    {
+        // Adjust joint order for 7 axis robot (SLURBTE > SLEURBT); All rotary axes
+
+        for (i = 0; i < ctrlGroup->numAxes; i++)
+        {
+            if (i < 2)
+                rosPos[i] = motoPos[i];
+            else if (i == 2)
+                rosPos[2] = motoPos[6];
+            else
+                rosPos[i] = motoPos[i - 1];
+        }
+    }
+    else if (Ros_CtrlGroup_IsRobot(ctrlGroup) && ctrlGroup->numAxes < 6)
+    {
+        //Delta: (SLU--T- > SLUT---) All rotary axes
+        //Scara: (SLUR--- > SLUR---) U-axis is linear
+        //Large Palletizing: (SLU--T- > SLUT---) All rotary axes
+        //High Speed Picking: (SLU-BT- > SLUBT--) All rotary axes
+
+        int rpi = 0; //rosPos index
+        int mpi = 0; //motopos index
+
+        for (i = 0; i < ctrlGroup->numAxes; i += 1, rpi += 1, mpi += 1)
+        {
+            while (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, mpi))
+            {
+                mpi += 1;
+                if (mpi >= MAX_PULSE_AXES)
+                    return;
+            }
+
+            rosPos[rpi] = motoPos[mpi];
+        }
+    }
+    else
+    {
+        for (i = 0; i < MAX_PULSE_AXES; i++)
+        {
+            rosPos[i] = motoPos[i];
+        }
+    }
+}
+
+// Convert Motoman position in pulse to Ros position in radian/meters
+// In the case of a 7, 4, or 5 axis robot, adjust the order to match
+// the physical axis sequence
+//-------------------------------------------------------------------
+static void Ros_Testing_CtrlGroup_ReferenceConvertToRosPos(CtrlGroup* ctrlGroup, long const motopulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
+{
+    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
+
+    //call this first, due to expected joint ordering 
+    Ros_Testing_CtrlGroup_ReferenceConvertMotoUnitsToRosUnits(ctrlGroup, motopulsePos, rosUnitsWithMotoOrder);
+
+    Ros_Testing_CtrlGroup_ReferenceConvertMotoJointOrderToSequentialJointOrder(ctrlGroup, rosUnitsWithMotoOrder, rosPos);
+}
+
+// Convert Motoman torque to ROS torque by re-ordering the joints
+//-------------------------------------------------------------------
+static void Ros_Testing_CtrlGroup_ReferenceConvertToRosTorque(CtrlGroup* ctrlGroup, double const motoTorque[MAX_PULSE_AXES], double rosTorque[MAX_PULSE_AXES])
+{
+    Ros_Testing_CtrlGroup_ReferenceConvertMotoJointOrderToSequentialJointOrder(ctrlGroup, motoTorque, rosTorque);
+}
+
+//Convert the ROS position units (radians/meters) to Motoman position units (pulses).
+//This function must be called AFTER calling Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder.
+//The joints must be in Motoman (non-sequential) ordering.
+static void Ros_Testing_CtrlGroup_ReferenceConvertRosUnitsToMotoUnits(CtrlGroup* ctrlGroup, double const rosPos[MAX_PULSE_AXES], long motopulsePos[MAX_PULSE_AXES])
+{
+    double conversion = 1;
+
+    bzero(motopulsePos, sizeof(long) * MAX_PULSE_AXES);
+
+    //Delta: (SLU--T-) All rotary axes
+    //Scara: (SLUR---) U-axis is linear
+    //Large Palletizing: (SLU--T-) All rotary axes
+    //High Speed Picking: (SLU-BT-) All rotary axes
+    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
+        {
+            continue;
+        }
+
+        if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
+            conversion = ctrlGroup->pulseToRad.PtoR[i];
+        else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
+            conversion = ctrlGroup->pulseToMeter.PtoM[i];
+        else
+            conversion = 1.0;
+
+        motopulsePos[i] = (int)(rosPos[i] * conversion);
+    }
+}
+
+static void Ros_Testing_CtrlGroup_ReferenceConvertSequentialJointOrderToMotoJointOrder(CtrlGroup* ctrlGroup, double const rosPos[MAX_PULSE_AXES], double motoPos[MAX_PULSE_AXES])
+{
+    int i;
+
+    // Initialize memory space
+    bzero(motoPos, sizeof(double) * MAX_PULSE_AXES);
+
+    if ((ctrlGroup->numAxes == 7) && Ros_CtrlGroup_IsRobot(ctrlGroup))
+    {
+        // Adjust joint order for 7 axis robot (SLEURBT > SLURBTE); All rotary axes
+
+        for (i = 0; i < ctrlGroup->numAxes; i++)
+        {
+            if (i < 2)
+                motoPos[i] = rosPos[i];
+            else if (i == 2)
+                motoPos[6] = rosPos[2];
+            else
+                motoPos[i - 1] = rosPos[i];
+        }
+    }
+    else if (Ros_CtrlGroup_IsRobot(ctrlGroup) && ctrlGroup->numAxes < 6)
+    {
+        //Delta: (SLUT--- > SLU--T-) All rotary axes
+        //Scara: (SLUR--- > SLUR---) U-axis is linear
+        //Large Palletizing: (SLUT--- > SLU--T-) All rotary axes
+        //High Speed Picking: (SLUBT-- > SLU-BT-) All rotary axes
+
+        int rpi = 0; //radpos index
+        int mpi = 0; //motopos index
+
+        for (i = 0; i < ctrlGroup->numAxes; i += 1, rpi += 1, mpi += 1)
+        {
+            while (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, mpi))
+            {
+                mpi += 1;
+                if (mpi >= MAX_PULSE_AXES)
+                    return;
+            }
+
+            motoPos[mpi] = rosPos[rpi];
+        }
+    }
+    else
+    {
+        for (i = 0; i < MAX_PULSE_AXES; i++)
+        {
+            motoPos[i] = rosPos[i];
+        }
+    }
+}
+
+//-------------------------------------------------------------------
+// Convert Ros position in radian to Motoman position in pulse
+// In the case of a 7 or 4 axis robot, adjust the order to match
+// the motoman axis sequence
+//-------------------------------------------------------------------
+static void Ros_Testing_CtrlGroup_ReferenceConvertToMotoPos_FromSequentialOrdering(CtrlGroup* ctrlGroup, double const radPos[MAX_PULSE_AXES], long motopulsePos[MAX_PULSE_AXES])
+{
+    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
+
+    Ros_Testing_CtrlGroup_ReferenceConvertSequentialJointOrderToMotoJointOrder(ctrlGroup, radPos, rosUnitsWithMotoOrder);
+
+    //must call this after Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder due to expected joint ordering
+    Ros_Testing_CtrlGroup_ReferenceConvertRosUnitsToMotoUnits(ctrlGroup, rosUnitsWithMotoOrder, motopulsePos);
+}
+
+
+static void Ros_Testing_CtrlGroup_MakeFakeGroup(CtrlGroup* group, Tests_CtrlGroup_Config const* config)
+{
+    bzero(group, sizeof(CtrlGroup));
+
+    group->groupNo = 0;
+    group->numAxes = config->numAxes;
+    group->groupId = config->groupId;
+
+    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        if (config->axes[i] == 'R')
+            group->axisType.type[i] = AXIS_ROTATION;
+        else if (config->axes[i] == 'L')
+            group->axisType.type[i] = AXIS_LINEAR;
+        else
+            group->axisType.type[i] = AXIS_INVALID;
+
+        //realistic, non-round ratios (also for the invalid axes, which must be ignored)
+        group->pulseToRad.PtoR[i] = 130000.0 + (i * 12345.678);
+        group->pulseToMeter.PtoM[i] = 2500000.0 + (i * 98765.4321);
+    }
+
+    Ros_CtrlGroup_InitializeConversionTables(group);
+}
+
+//deterministic pseudo-random sequence (LCG), so a failure can be reproduced
+static UINT32 Ros_Testing_CtrlGroup_NextRandom(UINT32* state)
+{
+    *state = (*state * 1664525) + 1013904223;
+    return *state;
+}
+
+static void Ros_Testing_CtrlGroup_MakeRandomPulsePos(UINT32* state, int sample, long pulsePos[MAX_PULSE_AXES])
+{
+    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        //the first samples cover 0 and +-1 pulse
+        if (sample < 3)
+            pulsePos[i] = sample - 1;
+        else
+            pulsePos[i] = (long)(Ros_Testing_CtrlGroup_NextRandom(state) % 2000000001) - 1000000000;
+    }
+}
+
+static BOOL Ros_Testing_CtrlGroup_CompareDoubleArrays(double const a[MAX_PULSE_AXES], double const b[MAX_PULSE_AXES])
+{
+    //exact comparison: the conversions must be bit-identical
+    return memcmp(a, b, sizeof(double) * MAX_PULSE_AXES) == 0;
+}
+
+static BOOL Ros_Testing_CtrlGroup_CompareLongArrays(long const a[MAX_PULSE_AXES], long const b[MAX_PULSE_AXES])
+{
+    return memcmp(a, b, sizeof(long) * MAX_PULSE_AXES) == 0;
+}
+
+BOOL Ros_Testing_CtrlGroup_ConversionTables()
+{
+    CtrlGroup group;
+    long motoPos[MAX_PULSE_AXES];
+    long motoPosRef[MAX_PULSE_AXES], motoPosNew[MAX_PULSE_AXES];
+    double rosPos[MAX_PULSE_AXES];
+    double rosPosRef[MAX_PULSE_AXES], rosPosNew[MAX_PULSE_AXES];
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    for (int c = 0; c < (int)(sizeof(testsCtrlGroup_configs) / sizeof(testsCtrlGroup_configs[0])); c += 1)
+    {
+        Tests_CtrlGroup_Config const* config = &testsCtrlGroup_configs[c];
+        UINT32 randomState = 42;
+        int sample;
+
+        Ros_Testing_CtrlGroup_MakeFakeGroup(&group, config);
+
+        bOk = TRUE;
+        for (sample = 0; bOk && sample < TESTS_CTRL_GROUP_NUM_SAMPLES; sample += 1)
+        {
+            Ros_Testing_CtrlGroup_MakeRandomPulsePos(&randomState, sample, motoPos);
+
+            //the reference implementation doesn't write all elements for some robot types
+            bzero(rosPosRef, sizeof(rosPosRef));
+            Ros_Testing_CtrlGroup_ReferenceConvertToRosPos(&group, motoPos, rosPosRef);
+            Ros_CtrlGroup_ConvertToRosPos(&group, motoPos, rosPosNew);
+            bOk &= Ros_Testing_CtrlGroup_CompareDoubleArrays(rosPosRef, rosPosNew);
+
+            //torque: reordering only, data of invalid axes included
+            for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+                rosPos[i] = motoPos[i] / 1000.0;
+            bzero(rosPosRef, sizeof(rosPosRef));
+            Ros_Testing_CtrlGroup_ReferenceConvertToRosTorque(&group, rosPos, rosPosRef);
+            Ros_CtrlGroup_ConvertToRosTorque(&group, rosPos, rosPosNew);
+            bOk &= Ros_Testing_CtrlGroup_CompareDoubleArrays(rosPosRef, rosPosNew);
+
+            //inverse, with positions in between pulses (to exercise the truncation)
+            for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+                rosPos[i] = ((double)motoPos[i] + ((Ros_Testing_CtrlGroup_NextRandom(&randomState) % 1000) / 1000.0)) / group.pulsePerUnit[i];
+            Ros_Testing_CtrlGroup_ReferenceConvertToMotoPos_FromSequentialOrdering(&group, rosPos, motoPosRef);
+            Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(&group, rosPos, motoPosNew);
+            bOk &= Ros_Testing_CtrlGroup_CompareLongArrays(motoPosRef, motoPosNew);
+
+            Ros_Testing_CtrlGroup_ReferenceConvertRosUnitsToMotoUnits(&group, rosPos, motoPosRef);
+            Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(&group, rosPos, motoPosNew);
+            bOk &= Ros_Testing_CtrlGroup_CompareLongArrays(motoPosRef, motoPosNew);
+
+            //round trip
+            Ros_CtrlGroup_ConvertToRosPos(&group, motoPos, rosPosNew);
+            bzero(rosPosRef, sizeof(rosPosRef));
+            Ros_Testing_CtrlGroup_ReferenceConvertToRosPos(&group, motoPos, rosPosRef);
+            Ros_Testing_CtrlGroup_ReferenceConvertToMotoPos_FromSequentialOrdering(&group, rosPosRef, motoPosRef);
+            Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(&group, rosPosNew, motoPosNew);
+            bOk &= Ros_Testing_CtrlGroup_CompareLongArrays(motoPosRef, motoPosNew);
+        }
+
+        Ros_Debug_BroadcastMsg("Testing CtrlGroup conversion tables - %s: %s", config->name, bOk ? "PASS" : "FAIL");
+        if (!bOk)
+        {
+            Ros_Debug_BroadcastMsg("First difference in sample %d: motoPos = %ld, %ld, %ld, %ld, %ld, %ld, %ld, %ld",
+                sample - 1, motoPos[0], motoPos[1], motoPos[2], motoPos[3], motoPos[4], motoPos[5], motoPos[6], motoPos[7]);
+            bAllTestsPassed = FALSE;
+        }
+    }
+
+    return bAllTestsPassed;
+}
+
+//Not a pass/fail test: reports the time per conversion of the reference and the table based implementation
+void Ros_Testing_CtrlGroup_BenchmarkConversions()
+{
+    CtrlGroup group;
+    long motoPos[MAX_PULSE_AXES];
+    double rosPos[MAX_PULSE_AXES];
+    UINT32 randomState = 42;
+    ULONG tickStart;
+    float usPerLoop = (mpGetRtc() * 1000.0f) / TESTS_CTRL_GROUP_BENCHMARK_LOOPS;
+
+    //the 7 axis robot is the most expensive case for the reference implementation
+    Ros_Testing_CtrlGroup_MakeFakeGroup(&group, &testsCtrlGroup_configs[1]);
+    Ros_Testing_CtrlGroup_MakeRandomPulsePos(&randomState, 3, motoPos);
+
+    tickStart = tickGet();
+    for (int i = 0; i < TESTS_CTRL_GROUP_BENCHMARK_LOOPS; i += 1)
+        Ros_Testing_CtrlGroup_ReferenceConvertToRosPos(&group, motoPos, rosPos);
+    float usRefToRos = (tickGet() - tickStart) * usPerLoop;
+
+    tickStart = tickGet();
+    for (int i = 0; i < TESTS_CTRL_GROUP_BENCHMARK_LOOPS; i += 1)
+        Ros_CtrlGroup_ConvertToRosPos(&group, motoPos, rosPos);
+    float usNewToRos = (tickGet() - tickStart) * usPerLoop;
+
+    tickStart = tickGet();
+    for (int i = 0; i < TESTS_CTRL_GROUP_BENCHMARK_LOOPS; i += 1)
+        Ros_Testing_CtrlGroup_ReferenceConvertToMotoPos_FromSequentialOrdering(&group, rosPos, motoPos);
+    float usRefToMoto = (tickGet() - tickStart) * usPerLoop;
+
+    tickStart = tickGet();
+    for (int i = 0; i < TESTS_CTRL_GROUP_BENCHMARK_LOOPS; i += 1)
+        Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(&group, rosPos, motoPos);
+    float usNewToMoto = (tickGet() - tickStart) * usPerLoop;
+
+    Ros_Debug_BroadcastMsg("Benchmark CtrlGroup ConvertToRosPos: %.3f us (reference: %.3f us)", usNewToRos, usRefToRos);
+    Ros_Debug_BroadcastMsg("Benchmark CtrlGroup ConvertToMotoPos: %.3f us (reference: %.3f us)", usNewToMoto, usRefToMoto);
+}
+
 BOOL Ros_Testing_CtrlGroup()
 {
     BOOL bSuccess = TRUE;
 
     bSuccess &= Ros_Testing_CtrlGroup_PosConverters();
     bSuccess &= Ros_Testing_CtrlGroup_HasBaseTrack();
+    bSuccess &= Ros_Testing_CtrlGroup_ConversionTables();
+    Ros_Testing_CtrlGroup_BenchmarkConversions();
 
     return bSuccess;
 }
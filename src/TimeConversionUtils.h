@@ -34,6 +34,11 @@ static inline void Ros_Nanos_To_Duration_Msg(INT64 x, builtin_interfaces__msg__D
     y->nanosec = (x % 1000000000LL);
 }
 
+static inline INT64 Ros_Time_Msg_To_Nanos(builtin_interfaces__msg__Time const* const x)
+{
+    return ((INT64)x->sec * 1000000000LL) + (INT64)x->nanosec;
+}
+
 static inline void Ros_Nanos_To_Time_Msg(INT64 x, builtin_interfaces__msg__Time* const y)
 {
     y->sec = x / 1000000000LL;
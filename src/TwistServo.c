@@ -0,0 +1,493 @@
+//TwistServo.c
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_subscription_t g_subscriberTwistServo;
+
+SubscriberTwistServo_Messages g_messages_TwistServo;
+
+//Most recent command, written by the executor and read by the servo task
+typedef struct
+{
+    SEM_ID lock;
+    BOOL bValid;                    // a command was received since the last time the servo stopped
+    int groupIndex;                 // robot the command applies to
+    double linear[3];               // m/s (RF)
+    double angular[3];              // rad/s (RF)
+    ULONG tickReceived;
+} TwistServo_Command;
+
+//State of the TCP which is being servoed. Only accessed by the servo task.
+typedef struct
+{
+    BOOL bActive;
+    int groupIndex;
+    UINT64 time_ms;                 // time since the start of the session
+    double position[3];             // commanded TCP position in meters (RF)
+    Quaternion orientation;         // commanded TCP orientation (RF)
+    double linear[3];               // velocity applied during the last cycle (m/s)
+    double angular[3];              // velocity applied during the last cycle (rad/s)
+    MP_COORD coord;                 // commanded TCP pose in controller units
+    BITSTRING figure;
+    long angle[MAX_PULSE_AXES];     // joint angles corresponding to 'coord'
+    long pulse[MAX_PULSE_AXES];     // pulse position corresponding to 'coord'
+} TwistServo_Session;
+
+static TwistServo_Command twistServo_command;
+static TwistServo_Session twistServo_session;
+static int twistServo_tid = INVALID_TASK;
+static BOOL twistServo_bRejectReported = FALSE;
+
+//Given by the IncMoveTask every interpolation cycle, to wake up the servo task. Created only
+//once, as the IncMoveTask keeps running while MotoROS2 reconnects to the Agent.
+static SEM_ID twistServo_semInterpolationCycle = NULL;
+static volatile BOOL twistServo_bEnabled = FALSE;
+
+static void Ros_TwistServo_ServoTask();
+
+void Ros_TwistServo_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(sub_twist_servo_init);
+
+    //--------------
+    const rosidl_message_type_support_t* type_support = ROSIDL_GET_MSG_TYPE_SUPPORT(geometry_msgs, msg, TwistStamped);
+
+    rcl_ret_t ret;
+    ret = rclc_subscription_init_best_effort(&g_subscriberTwistServo, &g_microRosNodeInfo.node, type_support, TOPIC_NAME_TWIST_SERVO);
+    motoRosAssert_withMsg(ret == RCL_RET_OK, SUBCODE_FAIL_CREATE_SUBSCRIBER_TWIST_SERVO, "Failed to init subscriber (%d)", (int)ret);
+
+    //--------------
+    micro_ros_utilities_memory_conf_t twist_msg_alloc_cfg = { 0 };
+    twist_msg_alloc_cfg.max_string_capacity = MAX_TF_FRAME_NAME_LENGTH;
+
+    bool bOk = micro_ros_utilities_create_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(geometry_msgs, msg, TwistStamped),
+        &g_messages_TwistServo.twistCommand,
+        twist_msg_alloc_cfg);
+    motoRosAssert_withMsg(bOk, SUBCODE_FAIL_ALLOCATE_TWIST_SERVO, "Failed to allocate twist message");
+
+    //--------------
+    bzero(&twistServo_command, sizeof(twistServo_command));
+    bzero(&twistServo_session, sizeof(twistServo_session));
+    twistServo_command.lock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+    twistServo_bRejectReported = FALSE;
+
+    if (twistServo_semInterpolationCycle == NULL)
+        twistServo_semInterpolationCycle = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
+
+    //Time critical, so it runs right after the IncMoveTask (MP_PRI_IP_CLK_TAKE) and before
+    //the executors and publishers (which would otherwise delay refilling the queue)
+    twistServo_tid = mpCreateTask(MP_PRI_TIME_CRITICAL, MP_STACK_SIZE,
+                                (FUNCPTR)Ros_TwistServo_ServoTask,
+                                0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    if (twistServo_tid == ERROR)
+    {
+        twistServo_tid = INVALID_TASK;
+        mpSetAlarm(ALARM_TASK_CREATE_FAIL, APPLICATION_NAME " FAILED TO CREATE TASK", SUBCODE_TWIST_SERVO);
+    }
+    else
+        twistServo_bEnabled = TRUE;
+
+    //--------------
+    MOTOROS2_MEM_TRACE_REPORT(sub_twist_servo_init);
+}
+
+void Ros_TwistServo_Cleanup()
+{
+    rcl_ret_t ret;
+    MOTOROS2_MEM_TRACE_START(sub_twist_servo_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup twist servo");
+
+    twistServo_bEnabled = FALSE;
+
+    if (twistServo_tid != INVALID_TASK)
+    {
+        mpDeleteTask(twistServo_tid);
+        twistServo_tid = INVALID_TASK;
+    }
+    mpSemDelete(twistServo_command.lock);
+
+    ret = rcl_subscription_fini(&g_subscriberTwistServo, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up " TOPIC_NAME_TWIST_SERVO " subscriber: %d", ret);
+
+    micro_ros_utilities_memory_conf_t twist_msg_alloc_cfg = { 0 };
+    twist_msg_alloc_cfg.max_string_capacity = MAX_TF_FRAME_NAME_LENGTH;
+
+    micro_ros_utilities_destroy_message_memory(
+        ROSIDL_GET_MSG_TYPE_SUPPORT(geometry_msgs, msg, TwistStamped),
+        &g_messages_TwistServo.twistCommand,
+        twist_msg_alloc_cfg);
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_twist_servo_fini);
+}
+
+//Only report the first rejected command, until a command is accepted again. Twists
+//are typically streamed at a high rate, and would otherwise flood the debug log.
+static void Ros_TwistServo_ReportRejectedCommand(char const* const reason)
+{
+    if (twistServo_bRejectReported)
+        return;
+
+    Ros_Debug_BroadcastMsg("Twist command rejected: %s", reason);
+    twistServo_bRejectReported = TRUE;
+}
+
+void Ros_TwistServo_CommandReceived(const void* msg)
+{
+    geometry_msgs__msg__TwistStamped const* twistMsg = (geometry_msgs__msg__TwistStamped const*)msg;
+    char formatBuffer[MAX_TF_FRAME_NAME_LENGTH];
+    int groupIndex = -1;
+
+    Ros_Communication_NotifyAgentActivity();
+
+    if (!Ros_MotionControl_IsMotionMode_PointQueue())
+    {
+        Ros_TwistServo_ReportRejectedCommand("point-queue mode must be active (use the '" SERVICE_NAME_START_POINT_QUEUE_MODE "' service)");
+        return;
+    }
+
+    //The twist must be relative to the base frame of a robot. An empty frame selects the first robot.
+    for (int i = 0; i < g_Ros_Controller.numGroup; i += 1)
+    {
+        if (!Ros_CtrlGroup_IsRobot(g_Ros_Controller.ctrlGroups[i]))
+            continue;
+
+        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/base", g_nodeConfigSettings.tf_frame_prefix, i + 1);
+        if (twistMsg->header.frame_id.size == 0 || strncmp(formatBuffer, twistMsg->header.frame_id.data, MAX_TF_FRAME_NAME_LENGTH) == 0)
+        {
+            groupIndex = i;
+            break;
+        }
+    }
+
+    if (groupIndex < 0)
+    {
+        Ros_TwistServo_ReportRejectedCommand("frame_id must be the base frame of a robot (fi: 'r1/base')");
+        return;
+    }
+
+    if (g_Ros_Controller.ctrlGroups[groupIndex]->bIsBaxisSlave)
+    {
+        Ros_TwistServo_ReportRejectedCommand("not supported for robots with a B-axis that maintains its orientation");
+        return;
+    }
+
+    if (mpSemTake(twistServo_command.lock, Q_LOCK_TIMEOUT) == OK)
+    {
+        twistServo_command.bValid = TRUE;
+        twistServo_command.groupIndex = groupIndex;
+        twistServo_command.linear[0] = twistMsg->twist.linear.x;
+        twistServo_command.linear[1] = twistMsg->twist.linear.y;
+        twistServo_command.linear[2] = twistMsg->twist.linear.z;
+        twistServo_command.angular[0] = twistMsg->twist.angular.x;
+        twistServo_command.angular[1] = twistMsg->twist.angular.y;
+        twistServo_command.angular[2] = twistMsg->twist.angular.z;
+        twistServo_command.tickReceived = tickGet();
+        mpSemGive(twistServo_command.lock);
+
+        twistServo_bRejectReported = FALSE;
+    }
+    else
+        Ros_Debug_BroadcastErrorMsg("Unable to store twist command. Lock is held by servo task.");
+}
+
+BOOL Ros_TwistServo_IsActive()
+{
+    return twistServo_session.bActive;
+}
+
+void Ros_TwistServo_NotifyInterpolationCycle()
+{
+    if (twistServo_bEnabled)
+        mpSemGive(twistServo_semInterpolationCycle);
+}
+
+static void Ros_TwistServo_InvalidateCommand()
+{
+    if (mpSemTake(twistServo_command.lock, Q_LOCK_TIMEOUT) == OK)
+    {
+        twistServo_command.bValid = FALSE;
+        mpSemGive(twistServo_command.lock);
+    }
+}
+
+static void Ros_TwistServo_EndSession(char const* const reason)
+{
+    if (twistServo_session.bActive)
+        Ros_Debug_BroadcastMsg("Twist servo stopped (Group #%d): %s", twistServo_session.groupIndex, reason);
+
+    twistServo_session.bActive = FALSE;
+}
+
+//Start servoing from the current command position of the robot
+static BOOL Ros_TwistServo_StartSession(int groupIndex)
+{
+    CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupIndex];
+    MP_CTRL_GRP_SEND_DATA sData;
+    MP_PULSE_POS_RSP_DATA pulseData;
+
+    //a queued point may still be moving the robot
+    for (int i = 0; i < g_Ros_Controller.numGroup; i += 1)
+    {
+        CtrlGroup* group = g_Ros_Controller.ctrlGroups[i];
+        if ((group->trajectoryIterator != NULL && group->trajectoryIterator->valid) || Ros_MotionControl_GetQueueCnt(i) > 0)
+            return FALSE;
+    }
+
+    sData.sCtrlGrp = ctrlGroup->groupId;
+    if (mpGetPulsePos(&sData, &pulseData) != OK)
+        return FALSE;
+
+    bzero(&twistServo_session, sizeof(twistServo_session));
+    memcpy(twistServo_session.pulse, pulseData.lPos, sizeof(twistServo_session.pulse));
+    mpConvPulseToAngle(ctrlGroup->groupNo, twistServo_session.pulse, twistServo_session.angle);
+    if (mpConvAxesToCartPos(ctrlGroup->groupNo, twistServo_session.angle, ctrlGroup->tool, &twistServo_session.figure, &twistServo_session.coord) != OK)
+        return FALSE;
+
+    twistServo_session.position[0] = MICROMETERS_TO_METERS((double)twistServo_session.coord.x);
+    twistServo_session.position[1] = MICROMETERS_TO_METERS((double)twistServo_session.coord.y);
+    twistServo_session.position[2] = MICROMETERS_TO_METERS((double)twistServo_session.coord.z);
+    QuatConversion_MpCoordOrient_To_GeomMsgsQuaternion(twistServo_session.coord.rx, twistServo_session.coord.ry, twistServo_session.coord.rz,
+        &twistServo_session.orientation);
+
+    twistServo_session.groupIndex = groupIndex;
+    twistServo_session.bActive = TRUE;
+
+    //the robot will no longer be where the last queued point left it
+    Ros_MotionControl_ResetPointQueue();
+
+    Ros_Debug_BroadcastMsg("Twist servo started (Group #%d)", groupIndex);
+    return TRUE;
+}
+
+//Move 'current' towards 'target', without exceeding 'maxStep' (applied to the vector length)
+static void Ros_TwistServo_LimitVelocityStep(double current[3], double const target[3], double maxStep)
+{
+    double delta[3];
+    double length = 0.0;
+    int i;
+
+    for (i = 0; i < 3; i += 1)
+    {
+        delta[i] = target[i] - current[i];
+        length += delta[i] * delta[i];
+    }
+    length = sqrt(length);
+
+    for (i = 0; i < 3; i += 1)
+    {
+        if (length > maxStep)
+            current[i] += delta[i] * (maxStep / length);
+        else
+            current[i] = target[i];
+    }
+}
+
+static LONG Ros_TwistServo_MetersToMicrometers(double meters)
+{
+    double micrometers = METERS_TO_MICROMETERS(meters);
+    return (LONG)((micrometers >= 0.0) ? (micrometers + 0.5) : (micrometers - 0.5));
+}
+
+//Integrate the applied velocity over one interpolation cycle and add the resulting
+//pulse increment to the queue. Returns FALSE if the session had to be stopped.
+static BOOL Ros_TwistServo_AddIncrementToQ()
+{
+    CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[twistServo_session.groupIndex];
+    double dt = g_Ros_Controller.interpolPeriod / 1000.0;
+    double position[3];
+    Quaternion orientation;
+    MP_COORD coord;
+    long angle[MAX_PULSE_AXES];
+    long pulse[MAX_PULSE_AXES];
+    Incremental_data incData;
+    int i;
+
+    //-------------------------------------
+    //position
+    for (i = 0; i < 3; i += 1)
+        position[i] = twistServo_session.position[i] + twistServo_session.linear[i] * dt;
+
+    //orientation: the angular velocity is expressed in RF, so the rotation is applied on the left
+    double* w = twistServo_session.angular;
+    double rotationAngle = sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]) * dt;
+    orientation = twistServo_session.orientation;
+    if (rotationAngle > 1.0e-12)
+    {
+        Quaternion* q = &twistServo_session.orientation;
+        double s = sin(rotationAngle / 2.0) / (rotationAngle / dt);
+        double dx = w[0] * s, dy = w[1] * s, dz = w[2] * s, dw = cos(rotationAngle / 2.0);
+
+        orientation.x = dw * q->x + dx * q->w + dy * q->z - dz * q->y;
+        orientation.y = dw * q->y - dx * q->z + dy * q->w + dz * q->x;
+        orientation.z = dw * q->z + dx * q->y - dy * q->x + dz * q->w;
+        orientation.w = dw * q->w - dx * q->x - dy * q->y - dz * q->z;
+
+        double norm = sqrt(orientation.x * orientation.x + orientation.y * orientation.y + orientation.z * orientation.z + orientation.w * orientation.w);
+        orientation.x /= norm;
+        orientation.y /= norm;
+        orientation.z /= norm;
+        orientation.w /= norm;
+    }
+
+    //-------------------------------------
+    //inverse kinematics, using the solution closest to the previous cycle
+    memcpy(&coord, &twistServo_session.coord, sizeof(MP_COORD));
+    coord.x = Ros_TwistServo_MetersToMicrometers(position[0]);
+    coord.y = Ros_TwistServo_MetersToMicrometers(position[1]);
+    coord.z = Ros_TwistServo_MetersToMicrometers(position[2]);
+    QuatConversion_GeomMsgsQuaternion_To_MpCoordOrient(&orientation, &coord.rx, &coord.ry, &coord.rz);
+
+    bzero(angle, sizeof(angle));
+    bzero(pulse, sizeof(pulse));
+    int ret = mpConvCartPosToAxes(ctrlGroup->groupNo, &coord, ctrlGroup->tool, twistServo_session.figure,
+        twistServo_session.angle, MP_KINEMA_PREVIOUS, angle);
+    if (ret != OK)
+    {
+        Ros_Debug_BroadcastMsg("mpConvCartPosToAxes returned: %d", ret);
+        Ros_TwistServo_EndSession("pose is unreachable");
+        return FALSE;
+    }
+    ret = mpConvAngleToPulse(ctrlGroup->groupNo, angle, pulse);
+    if (ret != OK)
+    {
+        Ros_Debug_BroadcastMsg("mpConvAngleToPulse returned: %d", ret);
+        Ros_TwistServo_EndSession("pose is unreachable");
+        return FALSE;
+    }
+
+    //-------------------------------------
+    bzero(&incData, sizeof(incData));
+    incData.frame = MP_INC_PULSE_DTYPE;
+    incData.tool = ctrlGroup->tool;
+    incData.time = twistServo_session.time_ms + g_Ros_Controller.interpolPeriod;
+
+    for (i = 0; i < MP_GRP_AXES_NUM; i += 1)
+    {
+        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
+            continue;
+
+        incData.inc[i] = pulse[i] - twistServo_session.pulse[i];
+
+        //near a singularity, a small TCP motion can require large joint motion
+        if (abs(incData.inc[i]) > ctrlGroup->maxInc.maxIncrement[i])
+        {
+            Ros_Debug_BroadcastMsg("Twist servo: increment for axis %d exceeds the maximum (%d > %d)",
+                i, incData.inc[i], ctrlGroup->maxInc.maxIncrement[i]);
+            Ros_TwistServo_EndSession("joint speed limit exceeded");
+            return FALSE;
+        }
+    }
+
+    if (!Ros_MotionControl_AddPulseIncPointToQ(ctrlGroup, &incData))
+    {
+        Ros_TwistServo_EndSession("unable to add increment to queue");
+        return FALSE;
+    }
+
+    //-------------------------------------
+    memcpy(twistServo_session.position, position, sizeof(position));
+    twistServo_session.orientation = orientation;
+    memcpy(&twistServo_session.coord, &coord, sizeof(MP_COORD));
+    memcpy(twistServo_session.angle, angle, sizeof(angle));
+    memcpy(twistServo_session.pulse, pulse, sizeof(pulse));
+    twistServo_session.time_ms = incData.time;
+
+    return TRUE;
+}
+
+//-----------------------------------------------------------------------
+// Task that converts the twist commands to joint increments. It keeps the
+// incremental queue of the servoed robot filled with a few interpolation
+// cycles worth of motion, so the latency of a new command stays low.
+// Runs once per interpolation cycle, right after the IncMoveTask has
+// taken the increment for that cycle from the queue.
+//-----------------------------------------------------------------------
+static void Ros_TwistServo_ServoTask()
+{
+    FOREVER
+    {
+        mpSemTake(twistServo_semInterpolationCycle, WAIT_FOREVER);
+
+        if (!Ros_MotionControl_IsMotionMode_PointQueue() || !Ros_Controller_IsMotionReady() || g_Ros_Controller.bStopMotion)
+        {
+            if (twistServo_session.bActive)
+            {
+                Ros_TwistServo_EndSession("motion is no longer possible");
+                Ros_TwistServo_InvalidateCommand();
+            }
+            continue;
+        }
+
+        //-------------------------------------
+        //get the latest command (zero velocity if the watchdog expired)
+        TwistServo_Command command;
+        if (mpSemTake(twistServo_command.lock, Q_LOCK_TIMEOUT) != OK)
+            continue;
+        command = twistServo_command;
+        mpSemGive(twistServo_command.lock);
+
+        BOOL bTimedOut = (command.bValid &&
+            ((tickGet() - command.tickReceived) * mpGetRtc()) > TWIST_SERVO_COMMAND_TIMEOUT_MS);
+
+        if (!command.bValid || bTimedOut)
+        {
+            bzero(command.linear, sizeof(command.linear));
+            bzero(command.angular, sizeof(command.angular));
+        }
+
+        if (!twistServo_session.bActive)
+        {
+            if (!command.bValid || bTimedOut)
+                continue;
+
+            if (!Ros_TwistServo_StartSession(command.groupIndex))
+            {
+                Ros_TwistServo_ReportRejectedCommand("robot is busy executing queued points");
+                Ros_TwistServo_InvalidateCommand();
+                continue;
+            }
+        }
+        else if (command.bValid && command.groupIndex != twistServo_session.groupIndex)
+        {
+            //bring the current robot to a stop first
+            bzero(command.linear, sizeof(command.linear));
+            bzero(command.angular, sizeof(command.angular));
+        }
+
+        //-------------------------------------
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[twistServo_session.groupIndex];
+        double dt = g_Ros_Controller.interpolPeriod / 1000.0;
+
+        while (twistServo_session.bActive && ctrlGroup->inc_q.cnt < TWIST_SERVO_MAX_QUEUED_INCREMENTS)
+        {
+            Ros_TwistServo_LimitVelocityStep(twistServo_session.linear, command.linear, TWIST_SERVO_MAX_LINEAR_ACCELERATION * dt);
+            Ros_TwistServo_LimitVelocityStep(twistServo_session.angular, command.angular, TWIST_SERVO_MAX_ANGULAR_ACCELERATION * dt);
+
+            BOOL bStandingStill = TRUE;
+            for (int i = 0; i < 3; i += 1)
+            {
+                if (twistServo_session.linear[i] != 0.0 || twistServo_session.angular[i] != 0.0)
+                    bStandingStill = FALSE;
+            }
+
+            if (bStandingStill && (!command.bValid || bTimedOut || command.groupIndex != twistServo_session.groupIndex))
+            {
+                Ros_TwistServo_EndSession(bTimedOut ? "command timed out" : "stopped");
+                if (bTimedOut)
+                    Ros_TwistServo_InvalidateCommand();
+                break;
+            }
+
+            if (!Ros_TwistServo_AddIncrementToQ())
+                Ros_TwistServo_InvalidateCommand();
+        }
+    }
+}
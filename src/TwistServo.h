@@ -0,0 +1,37 @@
+//TwistServo.h
+
+// SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2023, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_TWIST_SERVO_H
+#define MOTOROS2_TWIST_SERVO_H
+
+#define TWIST_SERVO_COMMAND_TIMEOUT_MS          100     // ms without a new command before the TCP is brought to a stop
+#define TWIST_SERVO_MAX_QUEUED_INCREMENTS       3       // keep the queue shallow to limit the command latency (in interpolation cycles)
+#define TWIST_SERVO_MAX_LINEAR_ACCELERATION     2.0     // m/s^2
+#define TWIST_SERVO_MAX_ANGULAR_ACCELERATION    6.0     // rad/s^2
+
+extern rcl_subscription_t g_subscriberTwistServo;
+
+typedef struct
+{
+    geometry_msgs__msg__TwistStamped twistCommand;
+} SubscriberTwistServo_Messages;
+extern SubscriberTwistServo_Messages g_messages_TwistServo;
+
+extern void Ros_TwistServo_Initialize();
+extern void Ros_TwistServo_Cleanup();
+
+extern void Ros_TwistServo_CommandReceived(const void* msg);
+
+//TRUE while the TCP of a robot is being moved by twist commands. Queued points
+//are rejected while this is the case.
+extern BOOL Ros_TwistServo_IsActive();
+
+//Wake up the servo task, to refill the queue. Called by the IncMoveTask once per
+//interpolation cycle. Never blocks.
+extern void Ros_TwistServo_NotifyInterpolationCycle();
+
+#endif  // MOTOROS2_TWIST_SERVO_H
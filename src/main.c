@@ -74,12 +74,22 @@ void RosInitTask()
     bTestResult &= Ros_Testing_RosMotoPlusConversionUtils();
     bTestResult &= Ros_Testing_ControllerStatusIO();
     bTestResult &= Ros_Testing_ActionServer_FJT();
-    bTestResult ? Ros_Debug_BroadcastMsg("Testing SUCCESSFUL") : Ros_Debug_BroadcastMsg("!!! Testing FAILED !!!");
+    if (bTestResult)
+        Ros_Debug_BroadcastMsg("Testing SUCCESSFUL");
+    else
+        Ros_Debug_BroadcastErrorMsg("!!! Testing FAILED !!!");
     Ros_Debug_BroadcastMsg("===");
 #endif
 
     Ros_ConfigFile_Parse();
 
+    //From here on, messages are filtered according to the configuration, and sent by the
+    //debug log task (the configuration has been printed by now, which would otherwise
+    //overflow the queue)
+    Ros_Debug_ApplyConfiguration();
+    Ros_Debug_StartLogTask();
+    Ros_Telemetry_Initialize();
+
     Ros_ReportVersionInfoToController();
 
     //==================================
@@ -101,26 +111,44 @@ void RosInitTask()
     Ros_Controller_SetIOState(IO_FEEDBACK_RESERVED_8, FALSE);
 
     //==================================
-    FOREVER
-    {
-        Ros_Controller_StatusInit();
+    //The controller model (control groups, calibration data, IncMoveTask) does not
+    //depend on the connection with the Agent, so it's kept across reconnects.
+    Ros_Controller_StatusInit();
+
+    Ros_Allocation_Initialize(&g_motoros2_Allocator);
 
-        Ros_Allocation_Initialize(&g_motoros2_Allocator);
+    Ros_mpGetRobotCalibrationData_Initialize(); //must occur before Ros_Controller_Initialize
 
-        Ros_mpGetRobotCalibrationData_Initialize(); //must occur before Ros_Controller_Initialize
+    // non-recoverable if this fails
+    motoRosAssert(Ros_Controller_Initialize(), SUBCODE_FAIL_ROS_CONTROLLER_INIT);
+
+    Ros_ControllerSnapshot_Initialize();
+
+    Ros_ClockSync_Initialize();
+
+    //==================================
+    BOOL bReconnecting = FALSE;
+    ULONG tickDisconnected = 0;
+    ULONG tickCleanupDone = 0;
 
+    FOREVER
+    {
         Ros_Communication_ConnectToAgent();
+        ULONG tickConnected = tickGet();
 
         Ros_Controller_SetIOState(IO_FEEDBACK_AGENTCONNECTED, TRUE);
 
         Ros_Communication_Initialize();
 
-        // non-recoverable if this fails
-        motoRosAssert(Ros_Controller_Initialize(), SUBCODE_FAIL_ROS_CONTROLLER_INIT);
+        Ros_IdlePublishing_Initialize();
+
+        Ros_Controller_InitializeRobotStatusPublisher();
 
         Ros_InformChecker_ValidateJob();
 
         Ros_PositionMonitor_Initialize();
+        Ros_JointStateCapture_Initialize();
+        Ros_CompactJointState_Initialize();
         Ros_ActionServer_FJT_Initialize(); //initialize action server - FollowJointTrajectory
 
         Ros_ServiceQueueTrajPoint_Initialize();
@@ -130,6 +158,8 @@ void RosInitTask()
         Ros_ServiceStartPointQueueMode_Initialize();
         Ros_ServiceStopTrajMode_Initialize();
         Ros_ServiceSelectMotionTool_Initialize();
+        Ros_TwistServo_Initialize();
+        Ros_LogLevel_Initialize();
 
         // Start executor that performs all communication
         // (This task deletes itself when the agent disconnects.)
@@ -144,33 +174,41 @@ void RosInitTask()
         Ros_Debug_BroadcastMsg("Initialization complete. Memory available: (%d) bytes. Memory in use: (%d) bytes",
                        mpNumBytesFree(), MP_MEM_PART_SIZE - mpNumBytesFree());
 
-        //==================================
-        ULONG tickBefore = 0;
-
-        while(g_Ros_Communication_AgentIsConnected)
+        if (bReconnecting)
         {
-            //figure out how long to sleep to achieve the user-configured rate
             ULONG tickNow = tickGet();
+            Ros_Debug_BroadcastMsg("Reconnected in %d ms (cleanup: %d ms, waiting for Agent: %d ms, initialization: %d ms)",
+                (int)((tickNow - tickDisconnected) * mpGetRtc()),
+                (int)((tickCleanupDone - tickDisconnected) * mpGetRtc()),
+                (int)((tickConnected - tickCleanupDone) * mpGetRtc()),
+                (int)((tickNow - tickConnected) * mpGetRtc()));
+        }
+
+        //==================================
+        PublishScheduler_Cycle cycle;
 
-            ULONG tickDiff = 0;
-            if (tickNow > tickBefore)
-                tickDiff = tickNow - tickBefore;
-            else //unsigned rollover
-                tickDiff = (UINT_MAX - tickBefore) + tickNow;
+        Ros_PublishScheduler_Initialize();
 
-            float elapsedMs = tickDiff * mpGetRtc(); //time it took to read and publish data
+        while(g_Ros_Communication_AgentIsConnected)
+        {
+            //sleep until the next cycle of the user-configured rates
+            Ros_PublishScheduler_WaitForNextCycle(&cycle);
 
-            if (elapsedMs < g_nodeConfigSettings.controller_status_monitor_period)
-                Ros_Sleep(g_nodeConfigSettings.controller_status_monitor_period - elapsedMs);
-            else
-                Ros_Sleep(1); //don't hog the CPU from other tasks
+            MOTOROS2_TASK_TRACE_BEGIN(TASK_TRACE_TASK_MAIN, TASK_TRACE_POINT_STATUS_CYCLE);
 
-            tickBefore = tickGet();
+            //Read the feedback of all groups once, for all activities in this cycle
+            ControllerSnapshot const* snapshot = NULL;
+            if (cycle.bDue[PUBLISH_TASK_STATUS_MONITOR] || cycle.bDue[PUBLISH_TASK_ROBOT_STATUS] ||
+                cycle.bDue[PUBLISH_TASK_JOINT_STATES] || cycle.bDue[PUBLISH_TASK_GROUP_JOINT_STATES] ||
+                cycle.bDue[PUBLISH_TASK_TF])
+            {
+                snapshot = Ros_ControllerSnapshot_Update();
+            }
 
             //Check controller status.
             //This is being done on an independent thread (as opposed to being refreshed on-demand)
             //so that the motion thread can react as needed.
-            if (!Ros_Controller_IoStatusUpdate())
+            if (cycle.bDue[PUBLISH_TASK_STATUS_MONITOR] && !Ros_Controller_IoStatusUpdate())
             {
                 Ros_Debug_BroadcastMsg("main: IoStatusUpdate failed, forcing disconnect/shutdown");
                 // force a 'disconnection', so tasks can start shutting down
@@ -179,11 +217,33 @@ void RosInitTask()
                 motoRosAssert(FALSE, SUBCODE_FAIL_IO_STATUS_UPDATE);
             }
 
+            //robot_status keeps track of its own last published position, as it may be
+            //published in other cycles than joint_states and tf
+            if (cycle.bDue[PUBLISH_TASK_ROBOT_STATUS])
+            {
+                BOOL bPositionChanged = Ros_PositionMonitor_HasPositionChangedSincePublished(IDLE_PUBLISHING_TOPIC_ROBOT_STATUS, snapshot);
+                if (Ros_Controller_PublishRobotStatus(bPositionChanged))
+                    Ros_PositionMonitor_SetPublishedPosition(IDLE_PUBLISHING_TOPIC_ROBOT_STATUS, snapshot);
+            }
+
             //Update robot's feedback position and publish the topics
-            Ros_PositionMonitor_UpdateLocation();
+            if (cycle.bDue[PUBLISH_TASK_JOINT_STATES] || cycle.bDue[PUBLISH_TASK_GROUP_JOINT_STATES] || cycle.bDue[PUBLISH_TASK_TF])
+            {
+                Ros_PositionMonitor_UpdateLocation(snapshot, cycle.bDue[PUBLISH_TASK_JOINT_STATES],
+                    cycle.bDue[PUBLISH_TASK_GROUP_JOINT_STATES], cycle.bDue[PUBLISH_TASK_TF]);
+            }
+
+            //The command position is tracked by the IncMoveTask, so this doesn't need the snapshot
+            if (cycle.bDue[PUBLISH_TASK_JOINT_COMMAND_STATES])
+                Ros_PositionMonitor_PublishJointCommandStates();
+
+            MOTOROS2_TASK_TRACE_END(TASK_TRACE_TASK_MAIN, TASK_TRACE_POINT_STATUS_CYCLE);
         }
 
         //==================================
+        tickDisconnected = tickGet();
+        bReconnecting = TRUE;
+
         Ros_Controller_SetIOState(IO_FEEDBACK_AGENTCONNECTED, FALSE);
         Ros_Debug_BroadcastMsg("Micro-ROS PC Agent disconnected");
         //Also print to console, for easier debugging (but only if not logging to stdout already)
@@ -193,15 +253,17 @@ void RosInitTask()
         }
 
         Ros_Debug_BroadcastMsg("Waiting for motion to stop before releasing memory");
-        do
+        while (Ros_Controller_IsInMotion()) //wait for motion to complete before terminating tasks
         {
             Ros_Sleep(1000);
-        } while (Ros_Controller_IsInMotion()); //wait for motion to complete before terminating tasks
+        }
 
         //wait for Ros_Communication_StartExecutors to finish
         mpSemTake(semCommunicationExecutorStatus, WAIT_FOREVER);
         mpSemDelete(semCommunicationExecutorStatus);
 
+        Ros_LogLevel_Cleanup();
+        Ros_TwistServo_Cleanup();
         Ros_ServiceSelectMotionTool_Cleanup();
         Ros_ServiceStopTrajMode_Cleanup();
         Ros_ServiceStartTrajMode_Cleanup();
@@ -211,16 +273,14 @@ void RosInitTask()
         Ros_ServiceQueueTrajPoint_Cleanup();
 
         Ros_ActionServer_FJT_Cleanup();
+        Ros_CompactJointState_Cleanup();
+        Ros_JointStateCapture_Cleanup();
         Ros_PositionMonitor_Cleanup();
-        Ros_Controller_Cleanup();
+        Ros_Controller_CleanupRobotStatusPublisher();
         Ros_Communication_Cleanup(); 
-        Ros_mpGetRobotCalibrationData_Cleanup();
 
         //--------------------------------
-        Ros_Controller_SetIOState(IO_FEEDBACK_INITIALIZATION_DONE, FALSE);
-
-        Ros_Sleep(2500);
-
+        tickCleanupDone = tickGet();
         Ros_Debug_BroadcastMsg("Shutdown complete. Available memory: (%d) bytes", mpNumBytesFree());
     }
 }
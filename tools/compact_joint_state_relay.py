@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+# SPDX-FileCopyrightText: 2023, Delft University of Technology
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Converts the compact joint states published by MotoROS2 (if
+# 'publish_compact_joint_states' is enabled) back into sensor_msgs/JointState.
+#
+# Usage (fi: with 'node_namespace: robot1' in the MotoROS2 configuration):
+#
+#   python3 compact_joint_state_relay.py --ros-args -r __ns:=/robot1
+#
+# See doc/ros_api.md for a description of the format.
+
+import rclpy
+from rclpy.node import Node
+from rclpy.qos import QoSProfile, QoSDurabilityPolicy, QoSReliabilityPolicy
+from rclpy.qos import qos_profile_sensor_data
+from sensor_msgs.msg import JointState
+from std_msgs.msg import Int32MultiArray
+
+# must correspond to CompactJointState.h
+HEADER_LENGTH = 3
+IDX_SEQUENCE = 0
+IDX_STAMP_SEC = 1
+IDX_STAMP_NANOSEC = 2
+POSITION_SCALE = 1000000.0
+VELOCITY_SCALE = 1000000.0
+EFFORT_SCALE = 1000.0
+
+
+class CompactJointStateRelay(Node):
+    def __init__(self):
+        super().__init__('compact_joint_state_relay')
+        self._joint_names = None
+        self._last_sequence = None
+        self._num_lost = 0
+
+        # MotoROS2 publishes the joint names only once
+        qos_names = QoSProfile(depth=1,
+            reliability=QoSReliabilityPolicy.RELIABLE,
+            durability=QoSDurabilityPolicy.TRANSIENT_LOCAL)
+        self.create_subscription(JointState, 'joint_states_compact/joint_names',
+            self._names_cb, qos_names)
+
+        # best-effort is compatible with both best-effort and reliable publishers
+        self.create_subscription(Int32MultiArray, 'joint_states_compact',
+            self._compact_cb, qos_profile_sensor_data)
+
+        self._pub = self.create_publisher(JointState, 'joint_states', qos_profile_sensor_data)
+
+    def _names_cb(self, msg):
+        self._joint_names = list(msg.name)
+        self.get_logger().info(f'Received order of {len(self._joint_names)} joints')
+
+    def _compact_cb(self, msg):
+        if self._joint_names is None:
+            self.get_logger().warn('No joint names received yet, dropping message',
+                throttle_duration_sec=5.0)
+            return
+
+        data = msg.data
+        n = len(self._joint_names)
+        if len(data) != HEADER_LENGTH + (3 * n):
+            self.get_logger().error(f'Expected data for {n} joints, got {len(data)} values',
+                throttle_duration_sec=5.0)
+            return
+
+        sequence = data[IDX_SEQUENCE]
+        if self._last_sequence is not None and sequence > self._last_sequence + 1:
+            self._num_lost += sequence - self._last_sequence - 1
+            self.get_logger().warn(f'{self._num_lost} message(s) lost in total',
+                throttle_duration_sec=5.0)
+        self._last_sequence = sequence
+
+        js = JointState()
+        js.header.stamp.sec = data[IDX_STAMP_SEC]
+        js.header.stamp.nanosec = data[IDX_STAMP_NANOSEC]
+        js.name = self._joint_names
+        js.position = [v / POSITION_SCALE for v in data[HEADER_LENGTH:HEADER_LENGTH + n]]
+        js.velocity = [v / VELOCITY_SCALE for v in data[HEADER_LENGTH + n:HEADER_LENGTH + (2 * n)]]
+        js.effort = [v / EFFORT_SCALE for v in data[HEADER_LENGTH + (2 * n):]]
+        self._pub.publish(js)
+
+
+def main():
+    rclpy.init()
+    node = CompactJointStateRelay()
+    try:
+        rclpy.spin(node)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        node.destroy_node()
+        rclpy.try_shutdown()
+
+
+if __name__ == '__main__':
+    main()
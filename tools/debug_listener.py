@@ -7,11 +7,15 @@
 
 import argparse
 import asyncio
+import csv
 import datetime
 import os
 import platform
 import socket
+import statistics
+import struct
 import time
+from collections import OrderedDict
 from functools import partial
 from typing import Tuple, Union, Text
 
@@ -21,6 +25,37 @@ Address = Tuple[str, int]
 # (where 'nnnnnn' is the microsecond part)
 STAMP_STR_LEN=26
 
+# binary telemetry datagrams (see Telemetry.h). Must be kept in sync with the
+# controller side.
+TELEMETRY_MAGIC=b'MR2T'
+# task trace events, see task_trace_to_chrome.py
+TASK_TRACE_MAGIC=b'MR2X'
+TELEMETRY_FORMAT_VERSION=1
+# magic, version, header size, nr of records, sequence, nr dropped,
+# send time (ns), send tick, tick period (us)
+TELEMETRY_HEADER=struct.Struct('<4sBBHIIqII')
+# event, group, tick, 4 fields
+TELEMETRY_RECORD=struct.Struct('<HHIiiii')
+
+EVENT_INCMOVE_CYCLE=1
+EVENT_FJT_GOAL_RECEIVED=2
+EVENT_FJT_GOAL_ACTIVATED=3
+EVENT_FJT_GOAL_COMPLETE=4
+EVENT_FJT_RESULT_SENT=5
+EVENT_CLOCK_SYNC=6
+
+EVENT_NAMES={
+    EVENT_INCMOVE_CYCLE: 'incmove_cycle',
+    EVENT_FJT_GOAL_RECEIVED: 'fjt_goal_received',
+    EVENT_FJT_GOAL_ACTIVATED: 'fjt_goal_activated',
+    EVENT_FJT_GOAL_COMPLETE: 'fjt_goal_complete',
+    EVENT_FJT_RESULT_SENT: 'fjt_result_sent',
+    EVENT_CLOCK_SYNC: 'clock_sync',
+}
+
+TELEMETRY_COLUMNS=['source', 'datagram_seq', 'event', 'event_name', 'group',
+    'tick', 'time_ns', 'field0', 'field1', 'field2', 'field3']
+
 def main():
     default_bcast_port=21789
     default_local_bind_addr='0.0.0.0'
@@ -37,12 +72,34 @@ def main():
         help='IP address to listen on')
     parser.add_argument('-n', '--no-file-sync', action='store_true',
         help='Do not log to files, only to console')
+    parser.add_argument('--telemetry-csv', metavar='FILE',
+        help='Save decoded telemetry records (see "log_telemetry" in the '
+            'MotoROS2 configuration) to a CSV file')
+    parser.add_argument('--telemetry-parquet', metavar='FILE',
+        help='Save decoded telemetry records to a Parquet file on exit '
+            '(requires pandas and pyarrow)')
+    parser.add_argument('--summarize', metavar='CSV',
+        help='Print the summary of a CSV file saved earlier with '
+            '--telemetry-csv, and exit')
     args = parser.parse_args()
 
+    if args.summarize:
+        with open(args.summarize, newline='') as f:
+            records = [TelemetryRecord.from_csv_row(row) for row in csv.DictReader(f)]
+        print_telemetry_summary(summarize_telemetry(records))
+        return
+
     # loop and prot
     loop = asyncio.get_event_loop()
     prot = DebugBroadcastProtocol(loop=loop)
 
+    # telemetry is always decoded (and summarized on exit), but only saved if
+    # requested
+    telemetry = TelemetryCollector(keep_records=args.telemetry_parquet is not None)
+    prot.register_telemetry_cb(cb=telemetry.add)
+    if args.telemetry_csv:
+        telemetry.open_csv(args.telemetry_csv)
+
     # always register console sink
     prot.register_sink_cb(cb=console_sink_cb)
     print('Listening for MotoROS2 debug msgs (format: "[time_msg_rcvd] [ip:port] msg") ..')
@@ -69,6 +126,8 @@ def main():
     except KeyboardInterrupt:
         pass
 
+    telemetry.close(parquet_fname=args.telemetry_parquet)
+
     # convenience: if zero bytes logged, delete output file
     if not args.no_file_sync and f.tell() == 0:
         print("\nNo messages received, deleting empty log file")
@@ -87,23 +146,248 @@ def console_sink_cb(msg, stamp, source_addr):
     print(f'[{stamp}] [{ip}:{port}]: {msg}')
 
 
+class TelemetryRecord:
+    __slots__ = ('source', 'datagram_seq', 'event', 'group', 'tick',
+        'time_ns', 'fields')
+
+    def __init__(self, source, datagram_seq, event, group, tick, time_ns, fields):
+        self.source = source
+        self.datagram_seq = datagram_seq
+        self.event = event
+        self.group = group
+        self.tick = tick
+        self.time_ns = time_ns
+        self.fields = fields
+
+    def to_csv_row(self):
+        return [self.source, self.datagram_seq, self.event,
+            EVENT_NAMES.get(self.event, 'unknown'), self.group, self.tick,
+            self.time_ns] + list(self.fields)
+
+    @classmethod
+    def from_csv_row(cls, row):
+        return cls(row['source'], int(row['datagram_seq']), int(row['event']),
+            int(row['group']), int(row['tick']), int(row['time_ns']),
+            [int(row[f'field{i}']) for i in range(4)])
+
+
+def decode_telemetry(data: bytes, source: str):
+    """Decodes a telemetry datagram. Returns (header dict, list of records).
+
+    The time of each record is derived from its tick, relative to the tick and
+    time at which the datagram was sent.
+    """
+    if len(data) < TELEMETRY_HEADER.size:
+        raise ValueError(f'datagram too short ({len(data)} bytes)')
+    (magic, version, header_size, num_records, seq, num_dropped, send_time_ns,
+        send_tick, tick_period_us) = TELEMETRY_HEADER.unpack_from(data)
+    if magic != TELEMETRY_MAGIC:
+        raise ValueError('not a telemetry datagram')
+    if version != TELEMETRY_FORMAT_VERSION:
+        raise ValueError(f'unsupported telemetry format version {version}')
+    if len(data) < header_size + num_records * TELEMETRY_RECORD.size:
+        raise ValueError('datagram truncated')
+
+    header = dict(sequence=seq, num_dropped=num_dropped,
+        send_time_ns=send_time_ns, send_tick=send_tick,
+        tick_period_us=tick_period_us)
+    records = []
+    for i in range(num_records):
+        event, group, tick, f0, f1, f2, f3 = TELEMETRY_RECORD.unpack_from(
+            data, header_size + i * TELEMETRY_RECORD.size)
+        # ticks are 32-bit, and wrap around
+        ticks_before_send = (send_tick - tick) & 0xFFFFFFFF
+        time_ns = send_time_ns - ticks_before_send * tick_period_us * 1000
+        records.append(TelemetryRecord(source, seq, event, group, tick,
+            time_ns, (f0, f1, f2, f3)))
+    return header, records
+
+
+class TelemetryCollector:
+    def __init__(self, keep_records=False):
+        self._keep_records = keep_records
+        self._records = []
+        self._summary = TelemetrySummary()
+        self._csv_file = None
+        self._csv_writer = None
+
+    def open_csv(self, fname):
+        # leaks f, but will be closed at program exit (or in close())
+        self._csv_file = open(fname, 'w', newline='')
+        self._csv_writer = csv.writer(self._csv_file)
+        self._csv_writer.writerow(TELEMETRY_COLUMNS)
+
+    def add(self, header, records, source_addr):
+        self._summary.add_datagram(header, source_addr)
+        for rec in records:
+            self._summary.add_record(rec)
+            if self._csv_writer:
+                self._csv_writer.writerow(rec.to_csv_row())
+            if self._keep_records:
+                self._records.append(rec)
+        if self._csv_file:
+            self._csv_file.flush()
+
+    def close(self, parquet_fname=None):
+        if self._csv_file:
+            self._csv_file.close()
+        if parquet_fname and self._records:
+            try:
+                import pandas
+            except ImportError:
+                print('\nCannot save telemetry as Parquet: pandas is not installed')
+            else:
+                pandas.DataFrame([r.to_csv_row() for r in self._records],
+                    columns=TELEMETRY_COLUMNS).to_parquet(parquet_fname)
+                print(f'\nSaved {len(self._records)} telemetry records to {parquet_fname}')
+        if self._summary.num_records > 0:
+            print()
+            print_telemetry_summary(self._summary)
+
+
+class TelemetrySummary:
+    """Accumulates statistics on the telemetry records, per source."""
+    def __init__(self):
+        self.num_records = 0
+        self.num_datagrams = 0
+        self.num_datagrams_lost = 0
+        self.num_dropped = 0
+        self.cycle_intervals = []
+        self.queue_depths = []
+        self.num_underruns = 0
+        self.num_fsu_limited = 0
+        self.num_incmove_errors = 0
+        self.goals = OrderedDict()
+        self.clock_sync = []
+        self._last_seq = {}
+        self._last_cycle_time = {}
+
+    def add_datagram(self, header, source_addr):
+        source = source_addr[0]
+        self.num_datagrams += 1
+        # drops on the controller side are cumulative
+        self.num_dropped = max(self.num_dropped, header['num_dropped'])
+        last = self._last_seq.get(source)
+        if last is not None and header['sequence'] > last + 1:
+            self.num_datagrams_lost += header['sequence'] - last - 1
+        self._last_seq[source] = header['sequence']
+
+    def add_record(self, rec):
+        self.num_records += 1
+        f = rec.fields
+        if rec.event == EVENT_INCMOVE_CYCLE:
+            last = self._last_cycle_time.get(rec.source)
+            if last is not None:
+                self.cycle_intervals.append(round((rec.time_ns - last) / 1e6, 3))
+            self._last_cycle_time[rec.source] = rec.time_ns
+            self.queue_depths.append(f[0])
+            self.num_underruns += 1 if f[3] & 0x01 else 0
+            self.num_fsu_limited += 1 if f[3] & 0x02 else 0
+            self.num_incmove_errors += 1 if f[2] != 0 else 0
+        elif rec.event in (EVENT_FJT_GOAL_RECEIVED, EVENT_FJT_GOAL_ACTIVATED,
+                EVENT_FJT_GOAL_COMPLETE, EVENT_FJT_RESULT_SENT):
+            goal = self.goals.setdefault((rec.source, f[0] & 0xFFFFFFFF), {})
+            goal[rec.event] = rec
+        elif rec.event == EVENT_CLOCK_SYNC:
+            self.clock_sync.append(f)
+
+
+def summarize_telemetry(records):
+    summary = TelemetrySummary()
+    for rec in records:
+        summary.add_record(rec)
+    return summary
+
+
+def _describe(values, unit):
+    if not values:
+        return 'n/a'
+    unit = f' {unit}' if unit else ''
+    return (f'min {min(values):.1f}{unit}, mean {statistics.mean(values):.1f}{unit}, '
+        f'max {max(values):.1f}{unit}'
+        + (f', stdev {statistics.stdev(values):.1f}{unit}' if len(values) > 1 else ''))
+
+
+def print_telemetry_summary(s):
+    print('Telemetry summary')
+    print('---')
+    print(f'Records: {s.num_records} (dropped on the controller: {s.num_dropped}, '
+        f'datagrams lost: {s.num_datagrams_lost})')
+
+    if s.cycle_intervals:
+        # pauses between trajectories show up as very long intervals: only
+        # consider intervals close to the nominal (most common) one. Note that
+        # the resolution is one tick of the controller.
+        nominal = statistics.mode(s.cycle_intervals)
+        intervals = [i for i in s.cycle_intervals if i <= 10 * nominal]
+        late = [i for i in intervals if i > nominal]
+        print(f'IncMove cycles: {len(s.queue_depths)}, interval {_describe(intervals, "ms")} '
+            f'(nominal {nominal:.1f} ms, {len(late)} late)')
+        print(f'  increments queued: {_describe(s.queue_depths, "")}')
+        print(f'  cycles with a queue underrun: {s.num_underruns}, FSU limited: {s.num_fsu_limited}, '
+            f'rejected increments: {s.num_incmove_errors}')
+
+    if s.goals:
+        print('Goals (latencies in ms):')
+        print(f'  {"goal id":>10} {"received->active":>17} {"active->complete":>17} '
+            f'{"complete->result":>17} {"planned":>8} {"actual":>8} {"error code":>11}')
+        for (source, goal_id), events in s.goals.items():
+            def delta(a, b):
+                if a in events and b in events:
+                    return f'{(events[b].time_ns - events[a].time_ns) / 1e6:.1f}'
+                return '-'
+            complete = events.get(EVENT_FJT_GOAL_COMPLETE)
+            result = events.get(EVENT_FJT_RESULT_SENT)
+            planned = f'{complete.fields[2]}' if complete else '-'
+            actual = f'{complete.fields[3]}' if complete else '-'
+            error_code = (complete.fields[1] if complete else
+                result.fields[2] if result else '-')
+            print(f'  {goal_id:>10x} {delta(EVENT_FJT_GOAL_RECEIVED, EVENT_FJT_GOAL_ACTIVATED):>17} '
+                f'{delta(EVENT_FJT_GOAL_ACTIVATED, EVENT_FJT_GOAL_COMPLETE):>17} '
+                f'{delta(EVENT_FJT_GOAL_COMPLETE, EVENT_FJT_RESULT_SENT):>17} '
+                f'{planned:>8} {actual:>8} {error_code:>11}')
+
+    if s.clock_sync:
+        print(f'Clock sync: {len(s.clock_sync)} updates, '
+            f'offset {_describe([c[0] for c in s.clock_sync], "us")}, '
+            f'round trip {_describe([c[1] for c in s.clock_sync], "us")}, '
+            f'last drift {s.clock_sync[-1][2] / 1000.0:.3f} ppm')
+
+
 class DebugBroadcastProtocol(asyncio.DatagramProtocol):
     def __init__(self, *, loop: asyncio.AbstractEventLoop = None):
         self.loop = asyncio.get_event_loop() if loop is None else loop
         self._sink_cbs = []
+        self._telemetry_cbs = []
 
     def register_sink_cb(self, cb):
         self._sink_cbs.append(cb)
 
+    def register_telemetry_cb(self, cb):
+        self._telemetry_cbs.append(cb)
+
     def connection_made(self, transport: asyncio.transports.DatagramTransport):
         self.transport = transport
 
     def datagram_received(self, data: Union[bytes, Text], addr: Address):
+        source_addr = (addr[0], addr[1])
+        if data[:len(TELEMETRY_MAGIC)] == TELEMETRY_MAGIC:
+            try:
+                header, records = decode_telemetry(data, source=addr[0])
+            except ValueError as e:
+                self._write_to_sinks(msg=f'Could not decode telemetry: {e}',
+                    stamp=datetime.datetime.now().isoformat(sep=' '), source_addr=source_addr)
+                return
+            for cb in self._telemetry_cbs:
+                cb(header=header, records=records, source_addr=source_addr)
+            return
+        if data[:len(TASK_TRACE_MAGIC)] == TASK_TRACE_MAGIC:
+            return
+
         # note: we assume all sinks appreciate strings instead of raw data
-        msg = data.decode('ascii')
+        msg = data.decode('ascii', errors='replace')
         sent_stamp = msg[:STAMP_STR_LEN]
         msg = msg[STAMP_STR_LEN+1:]
-        source_addr = (addr[0], addr[1])
         self._write_to_sinks(msg=msg, stamp=sent_stamp, source_addr=source_addr)
 
     def _write_to_sinks(self, msg, stamp, source_addr):
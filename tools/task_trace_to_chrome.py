@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: 2023, Yaskawa America, Inc.
+# SPDX-FileCopyrightText: 2023, Delft University of Technology
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Receives the task trace events of MotoROS2 (only sent by builds with
+# MOTOROS2_TASK_TRACE_ENABLE defined, see TaskTracing.h) and converts them to
+# a Chrome trace JSON file, which can be opened with chrome://tracing or
+# https://ui.perfetto.dev.
+#
+# The events are sent on the debug log port. On Linux, debug_listener.py can
+# run at the same time.
+#
+# Usage:
+#
+#   python3 task_trace_to_chrome.py -o trace.json
+#
+# and stop it with Ctrl+C once the activity of interest has been recorded.
+# '-r' saves the received datagrams, so they can be converted again later
+# (with '-i').
+
+import argparse
+import json
+import platform
+import socket
+import struct
+import sys
+import time
+
+# must be kept in sync with Telemetry.h and TaskTracing.h
+TASK_TRACE_MAGIC = b'MR2X'
+TASK_TRACE_FORMAT_VERSION = 1
+# magic, version, header size, nr of events, sequence, nr lost,
+# send time (ns), send tick, tick period (us)
+DATAGRAM_HEADER = struct.Struct('<4sBBHIIqII')
+# tick, order, task, phase, point
+TASK_TRACE_EVENT = struct.Struct('<IIBBH')
+
+MAX_CONTROLLABLE_GROUPS = 8
+EXECUTOR_NAMES = ['streaming', 'goals', 'mode changes', 'I/O', 'diagnostics']
+
+TASK_ADD_TO_INC_QUEUE = 1
+TASK_EXECUTOR = TASK_ADD_TO_INC_QUEUE + MAX_CONTROLLABLE_GROUPS
+TASK_MAIN = TASK_EXECUTOR + len(EXECUTOR_NAMES)
+
+POINT_NAMES = {
+    1: 'IncMove cycle',
+    2: 'mpExRcsIncrementMove',
+    3: 'interpolate point',
+    4: 'yield',
+    5: 'callback',
+    6: 'housekeeping',
+    7: 'status/feedback cycle',
+}
+
+PHASE_BEGIN = 0
+PHASE_END = 1
+
+
+def task_name(task):
+    if task == 0:
+        return 'IncMoveTask'
+    if TASK_ADD_TO_INC_QUEUE <= task < TASK_EXECUTOR:
+        return f'AddToIncQueue (group {task - TASK_ADD_TO_INC_QUEUE})'
+    if TASK_EXECUTOR <= task < TASK_MAIN:
+        return f"Executor '{EXECUTOR_NAMES[task - TASK_EXECUTOR]}'"
+    if task == TASK_MAIN:
+        return 'main (status and feedback)'
+    return f'task {task}'
+
+
+def decode_datagram(data):
+    """Returns (tick period in us, nr of events lost, list of (order, tick, task, phase, point)),
+    or None if 'data' is not a task trace datagram."""
+    if len(data) < DATAGRAM_HEADER.size or data[:4] != TASK_TRACE_MAGIC:
+        return None
+    (_, version, header_size, num_events, _, num_lost, _, _,
+        tick_period_us) = DATAGRAM_HEADER.unpack_from(data)
+    if version != TASK_TRACE_FORMAT_VERSION:
+        raise ValueError(f'unsupported task trace format version {version}')
+    events = []
+    for i in range(num_events):
+        tick, order, task, phase, point = TASK_TRACE_EVENT.unpack_from(
+            data, header_size + i * TASK_TRACE_EVENT.size)
+        events.append((order, tick, task, phase, point))
+    return tick_period_us, num_lost, events
+
+
+def to_chrome_trace(events, tick_period_us):
+    """Converts the events to a list of Chrome trace events.
+
+    The resolution of the tick is too coarse to show the interleaving of the
+    tasks, so events in the same tick are spread evenly over it, in the order
+    in which they were recorded.
+    """
+    events = sorted(events)
+    if not events:
+        return []
+
+    # ticks wrap around at 2^32. Use the difference to the first event.
+    first_tick = events[0][1]
+    def rel_tick(tick):
+        diff = (tick - first_tick) & 0xFFFFFFFF
+        return diff - (1 << 32) if diff >= (1 << 31) else diff
+
+    # an event can get its order before being preempted, and its tick after:
+    # ensure the ticks don't go backwards in order
+    ticks = []
+    for ev in events:
+        t = rel_tick(ev[1])
+        ticks.append(max(t, ticks[-1]) if ticks else t)
+
+    per_tick = {}
+    for t in ticks:
+        per_tick[t] = per_tick.get(t, 0) + 1
+
+    trace = []
+    open_spans = {}
+    rank = {}
+    ts = 0.0
+    for (order, _, task, phase, point), t in zip(events, ticks):
+        k = rank.get(t, 0)
+        rank[t] = k + 1
+        ts = (t + k / per_tick[t]) * tick_period_us
+
+        key = (task, point)
+        if phase == PHASE_BEGIN:
+            open_spans[key] = open_spans.get(key, 0) + 1
+        else:
+            # the begin may have been before the start of the capture (or lost)
+            if open_spans.get(key, 0) == 0:
+                continue
+            open_spans[key] -= 1
+        trace.append(dict(name=POINT_NAMES.get(point, f'point {point}'),
+            cat='motoros2', ph='B' if phase == PHASE_BEGIN else 'E',
+            ts=ts, pid=1, tid=task))
+
+    # close whatever was still running at the end of the capture
+    for (task, point), num_open in open_spans.items():
+        for _ in range(num_open):
+            trace.append(dict(name=POINT_NAMES.get(point, f'point {point}'),
+                cat='motoros2', ph='E', ts=ts, pid=1, tid=task))
+
+    tasks = sorted(set(ev[2] for ev in events))
+    trace.append(dict(name='process_name', ph='M', pid=1,
+        args=dict(name='MotoROS2')))
+    for task in tasks:
+        trace.append(dict(name='thread_name', ph='M', pid=1, tid=task,
+            args=dict(name=task_name(task))))
+        trace.append(dict(name='thread_sort_index', ph='M', pid=1, tid=task,
+            args=dict(sort_index=task)))
+    return trace
+
+
+def receive(args, raw_file):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    if platform.system().lower() == 'linux':
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEPORT, 1)
+    sock.bind((args.listen_ip, args.listen_port))
+    sock.settimeout(0.5)
+
+    datagrams = []
+    deadline = time.monotonic() + args.duration if args.duration else None
+    print('Receiving task trace events (Ctrl+C to stop) ..')
+    try:
+        while deadline is None or time.monotonic() < deadline:
+            try:
+                data, _ = sock.recvfrom(65536)
+            except socket.timeout:
+                continue
+            if data[:4] != TASK_TRACE_MAGIC:
+                continue
+            datagrams.append(data)
+            if raw_file:
+                raw_file.write(struct.pack('<I', len(data)) + data)
+    except KeyboardInterrupt:
+        pass
+    return datagrams
+
+
+def read_raw(fname):
+    datagrams = []
+    with open(fname, 'rb') as f:
+        while True:
+            length = f.read(4)
+            if len(length) < 4:
+                break
+            datagrams.append(f.read(struct.unpack('<I', length)[0]))
+    return datagrams
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Converts MotoROS2 task trace events to a Chrome trace '
+            'JSON file.',
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument('-o', '--output', default='motoros2_trace.json',
+        help='Chrome trace JSON file to write')
+    parser.add_argument('-p', '--port', dest='listen_port', type=int,
+        default=21789, help='UDP port to listen on')
+    parser.add_argument('-b', '--bind', dest='listen_ip', default='0.0.0.0',
+        help='IP address to listen on')
+    parser.add_argument('-d', '--duration', type=float,
+        help='Stop receiving after this many seconds')
+    parser.add_argument('-r', '--save-raw', metavar='FILE',
+        help='Also save the received datagrams to FILE')
+    parser.add_argument('-i', '--input', metavar='FILE',
+        help='Convert datagrams saved earlier with --save-raw instead of '
+            'receiving them')
+    args = parser.parse_args()
+
+    if args.input:
+        datagrams = read_raw(args.input)
+    else:
+        raw_file = open(args.save_raw, 'wb') if args.save_raw else None
+        datagrams = receive(args, raw_file)
+        if raw_file:
+            raw_file.close()
+
+    events = []
+    tick_period_us = None
+    # the controller counts the lost events since it booted
+    lost_first, lost_last = None, 0
+    for data in datagrams:
+        decoded = decode_datagram(data)
+        if decoded is None:
+            continue
+        tick_period_us, lost, evs = decoded
+        lost_first = lost if lost_first is None else lost_first
+        lost_last = max(lost_last, lost)
+        events.extend(evs)
+
+    if not events:
+        print('No task trace events received (is MOTOROS2_TASK_TRACE_ENABLE defined?)')
+        return 1
+
+    with open(args.output, 'w') as f:
+        json.dump(dict(traceEvents=to_chrome_trace(events, tick_period_us),
+            displayTimeUnit='ms'), f)
+    print(f'Wrote {len(events)} events to {args.output} '
+        f'(tick: {tick_period_us} us, {lost_last - lost_first} events lost on the controller)')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())